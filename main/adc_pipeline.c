@@ -0,0 +1,491 @@
+/*
+ * ADC Pipeline Implementation
+ * 
+ * The acquisition task owns the frame buffers and decimator state; only
+ * the published results (latest value and statistics) are shared with
+ * other tasks, under a mutex. DMA overruns are counted from the driver
+ * ISR, which cannot take the mutex, in a separate atomic counter.
+ */
+
+#include "adc_pipeline.h"
+#include "config.h"
+#include "sim_signal.h"
+#include "dsp_kernels.h"
+
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#if !ADC_SYNTHETIC_SOURCE
+#include "esp_attr.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#endif
+
+// Module logging tag
+static const char *TAG = "ADC_PIPE";
+
+#define ADC_CODE_MAX          4095
+#define ADC_LUT_SHIFT         6                                  // 64 codes per table segment
+#define ADC_LUT_SIZE          ((ADC_CODE_MAX >> ADC_LUT_SHIFT) + 2)
+#define ADC_READ_TIMEOUT_MS   100
+
+/*
+ * Block Source
+ * 
+ * read() blocks until a frame is available and returns the number of
+ * codes written (0 on timeout or error).
+ */
+typedef struct {
+    const char *name;
+    esp_err_t (*start)(void);
+    size_t (*read)(uint16_t *codes, size_t max);
+    void (*stop)(void);
+} adc_block_source_t;
+
+// Module state management
+typedef struct {
+    volatile bool running;
+    volatile bool stop;
+    TaskHandle_t task;
+    SemaphoreHandle_t lock;              // Guards latest_mv, has_value and stats
+    const adc_block_source_t *source;
+    float lut_mv[ADC_LUT_SIZE];          // Millivolts at every 2^ADC_LUT_SHIFT codes
+    dsp_biquad_t lowpass;                // Anti-alias filter ahead of downsampling
+    size_t decim_phase;                  // Index of the next kept sample in the next frame
+    bool has_value;
+    float latest_mv;
+    adc_pipeline_stats_t stats;          // stats.overruns unused, see overruns
+    _Atomic uint32_t overruns;           // DMA overruns, counted from ISR
+} adc_pipeline_context_t;
+
+// Global module context
+static adc_pipeline_context_t s_context = {
+    .running = false,
+    .task = NULL,
+    .lock = NULL,
+    .source = NULL
+};
+
+// Frame buffers (acquisition task only)
+static uint16_t s_codes[ADC_FRAME_SAMPLES];
+static float s_block_mv[ADC_FRAME_SAMPLES];
+static float s_filtered_mv[ADC_FRAME_SAMPLES];
+
+/*
+ * Internal function to fill the conversion table with the nominal line
+ */
+static void build_linear_lut(void)
+{
+    for (int i = 0; i < ADC_LUT_SIZE; i++) {
+        int raw = i << ADC_LUT_SHIFT;
+        if (raw > ADC_CODE_MAX) {
+            raw = ADC_CODE_MAX;
+        }
+        s_context.lut_mv[i] = raw * (float)ADC_FULL_SCALE_MV / ADC_CODE_MAX;
+    }
+}
+
+#if ADC_SYNTHETIC_SOURCE
+
+// Synthetic vibration: 125 Hz around mid scale with Gaussian noise
+static sim_signal_t s_synth_signal;
+static int64_t s_synth_index;
+static int64_t s_synth_next_us;
+
+static esp_err_t synthetic_start(void)
+{
+    const sim_signal_config_t config = {
+        .waveform = SIM_WAVE_SINE,
+        .offset = ADC_FULL_SCALE_MV / 2.0f,
+        .amplitude = ADC_FULL_SCALE_MV / 8.0f,
+        .period_ms = 8,
+        .noise = SIM_NOISE_GAUSSIAN,
+        .noise_amplitude = ADC_FULL_SCALE_MV / 200.0f,
+        .min = 0.0f,
+        .max = (float)ADC_FULL_SCALE_MV
+    };
+    
+    s_synth_index = 0;
+    s_synth_next_us = esp_timer_get_time();
+    build_linear_lut();
+    return sim_signal_init(&s_synth_signal, &config);
+}
+
+static size_t synthetic_read(uint16_t *codes, size_t max)
+{
+    // Deliver frames at the rate a real ADC would
+    int64_t wait_us = s_synth_next_us - esp_timer_get_time();
+    if (wait_us > 0) {
+        TickType_t ticks = pdMS_TO_TICKS(wait_us / 1000);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+    }
+    s_synth_next_us += (int64_t)max * 1000000 / ADC_SAMPLE_RATE_HZ;
+    
+    const float codes_per_mv = (float)ADC_CODE_MAX / ADC_FULL_SCALE_MV;
+    for (size_t i = 0; i < max; i++) {
+        int64_t t_us = s_synth_index++ * 1000000 / ADC_SAMPLE_RATE_HZ;
+        codes[i] = (uint16_t)(sim_signal_sample(&s_synth_signal, t_us) * codes_per_mv + 0.5f);
+    }
+    
+    return max;
+}
+
+static void synthetic_stop(void)
+{
+}
+
+static const adc_block_source_t s_source = {
+    .name = "synthetic",
+    .start = synthetic_start,
+    .read = synthetic_read,
+    .stop = synthetic_stop,
+};
+
+#else // !ADC_SYNTHETIC_SOURCE
+
+// DMA result layout differs between ADC generations
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_FORMAT        ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_RESULT_CHANNEL(p)    ((p)->type1.channel)
+#define ADC_RESULT_DATA(p)       ((p)->type1.data)
+#else
+#define ADC_OUTPUT_FORMAT        ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_RESULT_CHANNEL(p)    ((p)->type2.channel)
+#define ADC_RESULT_DATA(p)       ((p)->type2.data)
+#endif
+
+#define ADC_FRAME_BYTES          (ADC_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+
+static adc_continuous_handle_t s_adc_handle = NULL;
+static uint8_t s_dma_frame[ADC_FRAME_BYTES];
+
+/*
+ * Internal function to sample the calibration curve into the table
+ */
+static void build_calibrated_lut(void)
+{
+    adc_cali_handle_t cali = NULL;
+    esp_err_t ret = ESP_ERR_NOT_SUPPORTED;
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    const adc_cali_curve_fitting_config_t cali_config = {
+        .unit_id = ADC_UNIT_1,
+        .atten = ADC_ATTEN,
+        .bitwidth = ADC_WIDTH,
+    };
+    ret = adc_cali_create_scheme_curve_fitting(&cali_config, &cali);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    const adc_cali_line_fitting_config_t cali_config = {
+        .unit_id = ADC_UNIT_1,
+        .atten = ADC_ATTEN,
+        .bitwidth = ADC_WIDTH,
+    };
+    ret = adc_cali_create_scheme_line_fitting(&cali_config, &cali);
+#endif
+    
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "ADC calibration unavailable (%s), using nominal scale", esp_err_to_name(ret));
+        build_linear_lut();
+        return;
+    }
+    
+    for (int i = 0; i < ADC_LUT_SIZE; i++) {
+        int raw = i << ADC_LUT_SHIFT;
+        int mv = 0;
+        if (raw > ADC_CODE_MAX) {
+            raw = ADC_CODE_MAX;
+        }
+        adc_cali_raw_to_voltage(cali, raw, &mv);
+        s_context.lut_mv[i] = (float)mv;
+    }
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_delete_scheme_curve_fitting(cali);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_delete_scheme_line_fitting(cali);
+#endif
+}
+
+/*
+ * Internal function called from ISR when the DMA pool overflows
+ */
+static bool IRAM_ATTR dma_pool_overflow(adc_continuous_handle_t handle,
+                                        const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    atomic_fetch_add_explicit(&s_context.overruns, 1, memory_order_relaxed);
+    return false;
+}
+
+static esp_err_t dma_start(void)
+{
+    build_calibrated_lut();
+    
+    const adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = ADC_FRAME_BYTES * 4,
+        .conv_frame_size = ADC_FRAME_BYTES,
+    };
+    esp_err_t ret = adc_continuous_new_handle(&handle_config, &s_adc_handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    adc_digi_pattern_config_t pattern = {
+        .atten = ADC_ATTEN,
+        .channel = ADC_CHANNEL,
+        .unit = ADC_UNIT_1,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    const adc_continuous_config_t config = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern,
+        .sample_freq_hz = ADC_SAMPLE_RATE_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_OUTPUT_FORMAT,
+    };
+    const adc_continuous_evt_cbs_t callbacks = {
+        .on_pool_ovf = dma_pool_overflow,
+    };
+    
+    ret = adc_continuous_config(s_adc_handle, &config);
+    if (ret == ESP_OK) {
+        ret = adc_continuous_register_event_callbacks(s_adc_handle, &callbacks, NULL);
+    }
+    if (ret == ESP_OK) {
+        ret = adc_continuous_start(s_adc_handle);
+    }
+    if (ret != ESP_OK) {
+        adc_continuous_deinit(s_adc_handle);
+        s_adc_handle = NULL;
+    }
+    
+    return ret;
+}
+
+static size_t dma_read(uint16_t *codes, size_t max)
+{
+    uint32_t bytes = 0;
+    if (adc_continuous_read(s_adc_handle, s_dma_frame, sizeof(s_dma_frame), &bytes,
+                            ADC_READ_TIMEOUT_MS) != ESP_OK) {
+        return 0;
+    }
+    
+    size_t count = 0;
+    for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= bytes && count < max;
+         offset += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t *result = (const adc_digi_output_data_t *)&s_dma_frame[offset];
+        if (ADC_RESULT_CHANNEL(result) == ADC_CHANNEL) {
+            codes[count++] = (uint16_t)ADC_RESULT_DATA(result);
+        }
+    }
+    
+    return count;
+}
+
+static void dma_stop(void)
+{
+    if (s_adc_handle) {
+        adc_continuous_stop(s_adc_handle);
+        adc_continuous_deinit(s_adc_handle);
+        s_adc_handle = NULL;
+    }
+}
+
+static const adc_block_source_t s_source = {
+    .name = "continuous ADC",
+    .start = dma_start,
+    .read = dma_read,
+    .stop = dma_stop,
+};
+
+#endif // ADC_SYNTHETIC_SOURCE
+
+/*
+ * Internal function to process one frame
+ * 
+ * Converts the frame to millivolts, then runs the block kernels over it:
+ * anti-alias low-pass and downsampling for the decimated stream, and
+ * mean, AC RMS and peak for the block statistics.
+ */
+static void process_block(const uint16_t *codes, size_t count)
+{
+    const float frac_scale = 1.0f / (1 << ADC_LUT_SHIFT);
+    const uint32_t frac_mask = (1u << ADC_LUT_SHIFT) - 1;
+    
+    for (size_t i = 0; i < count; i++) {
+        uint32_t code = codes[i] > ADC_CODE_MAX ? ADC_CODE_MAX : codes[i];
+        const float *segment = &s_context.lut_mv[code >> ADC_LUT_SHIFT];
+        s_block_mv[i] = segment[0] + (segment[1] - segment[0]) * (float)(code & frac_mask) * frac_scale;
+    }
+    
+    // Keep every ADC_DECIMATION-th filtered sample, phase carried across frames
+    dsp_biquad_process(&s_context.lowpass, s_block_mv, s_filtered_mv, count);
+    uint32_t produced = 0;
+    float latest = 0.0f;
+    size_t i = s_context.decim_phase;
+    for (; i < count; i += ADC_DECIMATION) {
+        latest = s_filtered_mv[i];
+        produced++;
+    }
+    s_context.decim_phase = i - count;
+    
+    float mean = dsp_mean(s_block_mv, count);
+    dsp_offset(s_block_mv, count, -mean);
+    float rms = dsp_rms(s_block_mv, count);
+    float peak = dsp_peak(s_block_mv, count);
+    
+    xSemaphoreTake(s_context.lock, portMAX_DELAY);
+    s_context.stats.blocks++;
+    s_context.stats.samples += count;
+    s_context.stats.block_mean_mv = mean;
+    s_context.stats.block_rms_mv = rms;
+    s_context.stats.block_peak_mv = peak;
+    if (produced > 0) {
+        s_context.stats.decimated += produced;
+        s_context.latest_mv = latest;
+        s_context.has_value = true;
+    }
+    xSemaphoreGive(s_context.lock);
+}
+
+/*
+ * Internal acquisition task
+ */
+static void adc_pipeline_task(void *arg)
+{
+    while (!s_context.stop) {
+        size_t count = s_context.source->read(s_codes, ADC_FRAME_SAMPLES);
+        if (count > 0) {
+            process_block(s_codes, count);
+        }
+    }
+    
+    s_context.source->stop();
+    s_context.running = false;
+    s_context.task = NULL;
+    vTaskDelete(NULL);
+}
+
+/*
+ * Driver read: latest decimated value
+ */
+static esp_err_t analog_driver_read(sensor_value_t *value)
+{
+    if (!s_context.lock) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    xSemaphoreTake(s_context.lock, portMAX_DELAY);
+    bool has_value = s_context.has_value;
+    value->f = s_context.latest_mv;
+    xSemaphoreGive(s_context.lock);
+    
+    return has_value ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+static const sensor_driver_t s_analog_driver = {
+    .type = SENSOR_TYPE_ANALOG_1,
+    .name = "ANALOG_1",
+    .json_field = JSON_FIELD_ANALOG,
+    .value_type = SENSOR_VALUE_FLOAT,
+    .encoding = SENSOR_ENCODING_NUMBER,
+    .decimals = 1,
+    .read = analog_driver_read,
+};
+
+/*
+ * Start ADC Pipeline
+ */
+esp_err_t adc_pipeline_start(void)
+{
+    if (s_context.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!s_context.lock) {
+        s_context.lock = xSemaphoreCreateMutex();
+        if (!s_context.lock) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+    
+    s_context.source = &s_source;
+    s_context.decim_phase = ADC_DECIMATION - 1;
+    dsp_biquad_lowpass(&s_context.lowpass, ADC_LOWPASS_RATIO / ADC_DECIMATION, ADC_LOWPASS_Q);
+    memset(&s_context.stats, 0, sizeof(s_context.stats));
+    s_context.stats.synthetic = ADC_SYNTHETIC_SOURCE;
+    s_context.stats.sample_rate_hz = ADC_SAMPLE_RATE_HZ;
+    atomic_store_explicit(&s_context.overruns, 0, memory_order_relaxed);
+    
+    esp_err_t ret = s_context.source->start();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start %s source: %s", s_context.source->name, esp_err_to_name(ret));
+        return ret;
+    }
+    
+    s_context.stop = false;
+    s_context.running = true;
+    if (xTaskCreate(adc_pipeline_task, "adc_pipeline", TASK_STACK_SIZE, NULL,
+                    ADC_TASK_PRIORITY, &s_context.task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create ADC pipeline task");
+        s_context.running = false;
+        s_context.source->stop();
+        return ESP_ERR_NO_MEM;
+    }
+    
+    ESP_LOGI(TAG, "ADC pipeline started: %s source, %d Hz, %d samples/frame, decimation %d",
+             s_context.source->name, ADC_SAMPLE_RATE_HZ, ADC_FRAME_SAMPLES, ADC_DECIMATION);
+    return ESP_OK;
+}
+
+/*
+ * Stop ADC Pipeline
+ */
+esp_err_t adc_pipeline_stop(void)
+{
+    if (!s_context.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // The task finishes its current frame (at most one read timeout)
+    s_context.stop = true;
+    while (s_context.running) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
+    ESP_LOGI(TAG, "ADC pipeline stopped");
+    return ESP_OK;
+}
+
+/*
+ * Get Analog Sensor Driver
+ */
+const sensor_driver_t *adc_pipeline_get_driver(void)
+{
+    return &s_analog_driver;
+}
+
+/*
+ * Get Pipeline Statistics
+ */
+void adc_pipeline_get_stats(adc_pipeline_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    if (s_context.lock) {
+        xSemaphoreTake(s_context.lock, portMAX_DELAY);
+        *stats = s_context.stats;
+        xSemaphoreGive(s_context.lock);
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+    stats->overruns = atomic_load_explicit(&s_context.overruns, memory_order_relaxed);
+    stats->running = s_context.running;
+}
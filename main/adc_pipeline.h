@@ -0,0 +1,110 @@
+/*
+ * ADC Pipeline Module
+ * 
+ * Block-oriented analog acquisition. A dedicated task pulls frames of
+ * ADC_FRAME_SAMPLES conversions from a block source, converts the whole
+ * frame from raw codes to millivolts through a calibrated lookup table,
+ * computes per-block statistics and decimates the stream by
+ * ADC_DECIMATION (biquad low-pass, then downsampling), all with the block
+ * kernels of dsp_kernels. The latest decimated value is exposed
+ * to the sensor service as the SENSOR_TYPE_ANALOG_1 driver, so sampling
+ * rates far above the sensor sampler rate cost one driver read per sample.
+ * 
+ * Block sources:
+ * - Continuous ADC driver (DMA): ADC1 channel ADC_CHANNEL at
+ *   ADC_SAMPLE_RATE_HZ, frames delivered by the driver's DMA pool
+ * - Synthetic: a vibration-like signal (sine plus noise) generated in
+ *   blocks at the same rate, used on the linux host target and for
+ *   testing without analog hardware (ADC_SYNTHETIC_SOURCE)
+ * 
+ * Features:
+ * - Whole-frame code to millivolt conversion (no per-sample driver calls)
+ * - Anti-aliased decimation across frame boundaries
+ * - Per-block mean, AC RMS and peak deviation
+ * - DMA pool overflow accounting
+ * 
+ * Usage:
+ *   adc_pipeline_start();
+ *   sensor_service_register_driver(adc_pipeline_get_driver());
+ * 
+ *   adc_pipeline_stats_t stats;
+ *   adc_pipeline_get_stats(&stats);
+ */
+
+#ifndef ADC_PIPELINE_H
+#define ADC_PIPELINE_H
+
+#include "esp_err.h"
+#include "sensor_service.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pipeline Statistics
+ */
+typedef struct {
+    bool running;                        // Acquisition task active
+    bool synthetic;                      // Synthetic source in use
+    uint32_t sample_rate_hz;             // Conversions per second
+    uint32_t blocks;                     // Frames processed
+    uint32_t samples;                    // Conversions processed
+    uint32_t decimated;                  // Decimated values produced
+    uint32_t overruns;                   // Frames lost because processing fell behind
+    float block_mean_mv;                 // Mean of the last frame
+    float block_rms_mv;                  // AC RMS of the last frame (mean removed)
+    float block_peak_mv;                 // Largest deviation from the mean in the last frame
+} adc_pipeline_stats_t;
+
+/*
+ * Start ADC Pipeline
+ * 
+ * Sets up the block source (continuous ADC or synthetic) and the
+ * calibration table, then starts the acquisition task.
+ * 
+ * Returns:
+ *   ESP_OK: Pipeline running
+ *   ESP_ERR_INVALID_STATE: Pipeline already running
+ *   ESP_ERR_NO_MEM: Task or lock creation failed
+ *   ESP_ERR_*: ADC driver error
+ */
+esp_err_t adc_pipeline_start(void);
+
+/*
+ * Stop ADC Pipeline
+ * 
+ * Stops the acquisition task and releases the ADC. The last decimated
+ * value stays readable.
+ * 
+ * Returns:
+ *   ESP_OK: Pipeline stopped
+ *   ESP_ERR_INVALID_STATE: Pipeline not running
+ */
+esp_err_t adc_pipeline_stop(void);
+
+/*
+ * Get Analog Sensor Driver
+ * 
+ * Returns:
+ *   Driver descriptor for SENSOR_TYPE_ANALOG_1, reading the latest
+ *   decimated value in millivolts (ESP_ERR_INVALID_STATE until the first
+ *   decimated value exists)
+ */
+const sensor_driver_t *adc_pipeline_get_driver(void);
+
+/*
+ * Get Pipeline Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to adc_pipeline_stats_t structure to populate
+ */
+void adc_pipeline_get_stats(adc_pipeline_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADC_PIPELINE_H
@@ -0,0 +1,491 @@
+/*
+ * Aggregator Implementation
+ * 
+ * Keeps one accumulator per sensor per pane. Each accumulator holds the
+ * Welford running mean/M2, min/max and a centroid sketch. Summaries merge
+ * the accumulators of all panes in the window (Chan's parallel variance
+ * formula, centroid re-insertion for the sketch).
+ */
+
+#include "aggregator.h"
+#include "config.h"
+#include "stats_block.h"
+
+#include <math.h>
+#include <string.h>
+#include "esp_log.h"
+
+// Module logging tag
+static const char *TAG = "AGGREGATOR";
+
+// Panes per window (1 = tumbling)
+#define AGG_PANE_COUNT             (AGG_WINDOW_SEC / AGG_HOP_SEC)
+#define AGG_HOP_US                 ((int64_t)AGG_HOP_SEC * 1000000)
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    AGG_STAT_SAMPLES = 0,
+    AGG_STAT_LATE_SAMPLES,
+    AGG_STAT_WINDOWS,
+    AGG_STAT_DROPPED_WINDOWS,
+    AGG_STAT_COUNT
+} agg_stat_t;
+
+// Updated by the aggregating task, read by status and metrics
+STATS_BLOCK_DEFINE(s_stats, AGG_STAT_COUNT);
+
+// Percentile sketch centroid
+typedef struct {
+    float mean;
+    uint32_t weight;
+} agg_centroid_t;
+
+// Percentile sketch: centroids sorted by mean (one spare slot for inserts)
+typedef struct {
+    agg_centroid_t centroids[AGG_SKETCH_CENTROIDS + 1];
+    uint8_t count;
+} agg_sketch_t;
+
+// Streaming statistics of one sensor
+typedef struct {
+    uint32_t count;
+    float min;
+    float max;
+    float mean;
+    float m2;                            // Sum of squared deviations from the mean
+    agg_sketch_t sketch;
+} agg_accumulator_t;
+
+// One pane of the window
+typedef struct {
+    agg_accumulator_t acc[SENSOR_TYPE_MAX];
+    sensor_value_t last[SENSOR_TYPE_MAX]; // Latest value of non-numeric sensors
+    uint32_t last_mask;
+} agg_pane_t;
+
+// Module state management
+typedef struct {
+    bool started;
+    agg_pane_t panes[AGG_PANE_COUNT];
+    uint32_t current;                    // Pane receiving readings
+    uint32_t pane_closes;                // Panes closed since start (saturating)
+    int64_t pane_start_us;               // Start of the current pane
+    sensor_data_t queue[AGG_OUTPUT_QUEUE_LEN];
+    uint32_t queue_head;
+    uint32_t queue_count;
+} aggregator_context_t;
+
+// Global module context
+static aggregator_context_t s_context;
+
+/*
+ * Internal function to insert a centroid into a sketch
+ * 
+ * Keeps centroids sorted; when the sketch is over capacity the two
+ * neighbouring centroids with the smallest gap are merged.
+ */
+static void sketch_add(agg_sketch_t *sketch, float value, uint32_t weight)
+{
+    agg_centroid_t *c = sketch->centroids;
+    int i = sketch->count;
+    
+    while (i > 0 && c[i - 1].mean > value) {
+        c[i] = c[i - 1];
+        i--;
+    }
+    c[i].mean = value;
+    c[i].weight = weight;
+    sketch->count++;
+    
+    if (sketch->count <= AGG_SKETCH_CENTROIDS) {
+        return;
+    }
+    
+    int best = 0;
+    float best_gap = c[1].mean - c[0].mean;
+    for (int j = 1; j < sketch->count - 1; j++) {
+        float gap = c[j + 1].mean - c[j].mean;
+        if (gap < best_gap) {
+            best_gap = gap;
+            best = j;
+        }
+    }
+    
+    uint32_t merged_weight = c[best].weight + c[best + 1].weight;
+    c[best].mean = (c[best].mean * c[best].weight + c[best + 1].mean * c[best + 1].weight) / merged_weight;
+    c[best].weight = merged_weight;
+    memmove(&c[best + 1], &c[best + 2], (sketch->count - best - 2) * sizeof(agg_centroid_t));
+    sketch->count--;
+}
+
+/*
+ * Internal function to estimate a quantile from a sketch
+ * 
+ * Interpolates linearly between centroid centres, using the exact min
+ * and max as the end points.
+ */
+static float sketch_quantile(const agg_sketch_t *sketch, float q, float min, float max)
+{
+    float total = 0.0f;
+    for (int i = 0; i < sketch->count; i++) {
+        total += sketch->centroids[i].weight;
+    }
+    
+    float target = q * total;
+    float prev_pos = 0.0f;
+    float prev_value = min;
+    float cumulative = 0.0f;
+    
+    for (int i = 0; i < sketch->count; i++) {
+        const agg_centroid_t *c = &sketch->centroids[i];
+        float centre = cumulative + c->weight * 0.5f;
+        if (target < centre) {
+            float span = centre - prev_pos;
+            return (span > 0.0f) ? prev_value + (c->mean - prev_value) * (target - prev_pos) / span : c->mean;
+        }
+        prev_pos = centre;
+        prev_value = c->mean;
+        cumulative += c->weight;
+    }
+    
+    float span = total - prev_pos;
+    return (span > 0.0f) ? prev_value + (max - prev_value) * (target - prev_pos) / span : max;
+}
+
+/*
+ * Internal function to add one value to an accumulator (Welford)
+ */
+static void accumulator_add(agg_accumulator_t *acc, float value)
+{
+    if (acc->count == 0) {
+        acc->min = value;
+        acc->max = value;
+    } else {
+        if (value < acc->min) acc->min = value;
+        if (value > acc->max) acc->max = value;
+    }
+    
+    acc->count++;
+    float delta = value - acc->mean;
+    acc->mean += delta / acc->count;
+    acc->m2 += delta * (value - acc->mean);
+    
+    sketch_add(&acc->sketch, value, 1);
+}
+
+/*
+ * Internal function to merge accumulator b into a (Chan et al.)
+ */
+static void accumulator_merge(agg_accumulator_t *a, const agg_accumulator_t *b)
+{
+    if (b->count == 0) {
+        return;
+    }
+    if (a->count == 0) {
+        *a = *b;
+        return;
+    }
+    
+    uint32_t count = a->count + b->count;
+    float delta = b->mean - a->mean;
+    a->mean += delta * b->count / count;
+    a->m2 += b->m2 + delta * delta * ((float)a->count * b->count / count);
+    a->count = count;
+    if (b->min < a->min) a->min = b->min;
+    if (b->max > a->max) a->max = b->max;
+    
+    for (int i = 0; i < b->sketch.count; i++) {
+        sketch_add(&a->sketch, b->sketch.centroids[i].mean, b->sketch.centroids[i].weight);
+    }
+}
+
+/*
+ * Internal function to check whether a sensor is aggregated numerically
+ */
+static bool is_numeric(const sensor_driver_t *driver)
+{
+    return driver && driver->encoding == SENSOR_ENCODING_NUMBER && driver->value_type != SENSOR_VALUE_BOOL;
+}
+
+/*
+ * Internal function to read a sensor value as float
+ */
+static float value_as_float(const sensor_driver_t *driver, const sensor_value_t *value)
+{
+    switch (driver->value_type) {
+        case SENSOR_VALUE_INT:
+            return (float)value->i;
+        case SENSOR_VALUE_UINT:
+            return (float)value->u;
+        default:
+            return value->f;
+    }
+}
+
+/*
+ * Internal function to queue a summary of the panes in the window
+ */
+static void emit_summary(int64_t end_us)
+{
+    agg_accumulator_t merged[SENSOR_TYPE_MAX];
+    sensor_record_t record;
+    memset(merged, 0, sizeof(merged));
+    memset(&record, 0, sizeof(record));
+    
+    // Walk panes oldest first so the newest non-numeric value wins
+    uint32_t total = 0;
+    for (uint32_t p = 1; p <= AGG_PANE_COUNT; p++) {
+        const agg_pane_t *pane = &s_context.panes[(s_context.current + p) % AGG_PANE_COUNT];
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            accumulator_merge(&merged[type], &pane->acc[type]);
+            total += pane->acc[type].count;
+            if (pane->last_mask & (1u << type)) {
+                record.values[type] = pane->last[type];
+                record.valid_mask |= 1u << type;
+            }
+        }
+    }
+    
+    if (total == 0) {
+        return;
+    }
+    
+    // Window means become the values of the summary
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const sensor_driver_t *driver = sensor_service_get_driver(type);
+        if (merged[type].count == 0 || !is_numeric(driver)) {
+            continue;
+        }
+        
+        float mean = merged[type].mean;
+        if (driver->value_type == SENSOR_VALUE_INT) {
+            record.values[type].i = (int32_t)lroundf(mean);
+        } else if (driver->value_type == SENSOR_VALUE_UINT) {
+            record.values[type].u = (uint32_t)lroundf(mean);
+        } else {
+            record.values[type].f = mean;
+        }
+        record.valid_mask |= 1u << type;
+    }
+    record.timestamp_us = end_us;
+    
+    // Queue the summary, dropping the oldest one if the consumer fell behind
+    stats_update_begin(&s_stats);
+    if (s_context.queue_count == AGG_OUTPUT_QUEUE_LEN) {
+        s_context.queue_head = (s_context.queue_head + 1) % AGG_OUTPUT_QUEUE_LEN;
+        s_context.queue_count--;
+        stats_inc(&s_stats, AGG_STAT_DROPPED_WINDOWS);
+    }
+    
+    sensor_data_t *summary = &s_context.queue[(s_context.queue_head + s_context.queue_count) % AGG_OUTPUT_QUEUE_LEN];
+    s_context.queue_count++;
+    stats_inc(&s_stats, AGG_STAT_WINDOWS);
+    stats_update_end(&s_stats);
+    
+    sensor_service_record_to_data(&record, summary);
+    
+    uint32_t panes = (s_context.pane_closes + 1 < AGG_PANE_COUNT) ? s_context.pane_closes + 1 : AGG_PANE_COUNT;
+    summary->window_ms = panes * AGG_HOP_SEC * 1000;
+    
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const agg_accumulator_t *acc = &merged[type];
+        if (acc->count == 0) {
+            continue;
+        }
+        
+        sensor_stats_t *stats = &summary->stats[type];
+        stats->count = acc->count;
+        stats->min = acc->min;
+        stats->max = acc->max;
+        stats->mean = acc->mean;
+        stats->stddev = (acc->count > 1) ? sqrtf(acc->m2 / (acc->count - 1)) : 0.0f;
+        stats->p50 = sketch_quantile(&acc->sketch, 0.50f, acc->min, acc->max);
+        stats->p90 = sketch_quantile(&acc->sketch, 0.90f, acc->min, acc->max);
+        stats->p99 = sketch_quantile(&acc->sketch, 0.99f, acc->min, acc->max);
+        summary->stats_mask |= 1u << type;
+    }
+    
+    ESP_LOGD(TAG, "Window closed with %lu readings", (unsigned long)total);
+}
+
+/*
+ * Internal function to close the current pane and start the next one
+ */
+static void close_pane(void)
+{
+    emit_summary(s_context.pane_start_us + AGG_HOP_US);
+    
+    s_context.pane_start_us += AGG_HOP_US;
+    s_context.current = (s_context.current + 1) % AGG_PANE_COUNT;
+    memset(&s_context.panes[s_context.current], 0, sizeof(agg_pane_t));
+    if (s_context.pane_closes < AGG_PANE_COUNT) {
+        s_context.pane_closes++;
+    }
+}
+
+/*
+ * Initialize Aggregator
+ */
+esp_err_t aggregator_init(void)
+{
+    memset(&s_context, 0, sizeof(s_context));
+    stats_reset(&s_stats);
+    
+    ESP_LOGI(TAG, "Aggregating %d s windows every %d s (%s)", AGG_WINDOW_SEC, AGG_HOP_SEC,
+             (AGG_PANE_COUNT == 1) ? "tumbling" : "sliding");
+    return ESP_OK;
+}
+
+/*
+ * Internal function to move the current pane up to a reading's time
+ * 
+ * Returns false for readings older than the current pane.
+ */
+static bool advance_panes(int64_t timestamp_us)
+{
+    if (!s_context.started) {
+        s_context.started = true;
+        s_context.pane_start_us = timestamp_us;
+    }
+    
+    if (timestamp_us < s_context.pane_start_us) {
+        stats_inc(&s_stats, AGG_STAT_LATE_SAMPLES);
+        return false;
+    }
+    
+    // Close the panes that ended before this reading
+    int64_t panes_elapsed = (timestamp_us - s_context.pane_start_us) / AGG_HOP_US;
+    if (panes_elapsed > AGG_PANE_COUNT) {
+        // Gap longer than the window: report what we have and start over
+        close_pane();
+        memset(s_context.panes, 0, sizeof(s_context.panes));
+        s_context.current = 0;
+        s_context.pane_closes = 0;
+        s_context.pane_start_us += (panes_elapsed - 1) * AGG_HOP_US;
+    } else {
+        for (int64_t i = 0; i < panes_elapsed; i++) {
+            close_pane();
+        }
+    }
+    
+    return true;
+}
+
+/*
+ * Add Reading
+ */
+void aggregator_add(int64_t timestamp_us, const sensor_value_t *values, uint32_t valid_mask)
+{
+    if (!values || !advance_panes(timestamp_us)) {
+        return;
+    }
+    
+    agg_pane_t *pane = &s_context.panes[s_context.current];
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (!(valid_mask & (1u << type))) {
+            continue;
+        }
+        
+        const sensor_driver_t *driver = sensor_service_get_driver(type);
+        if (is_numeric(driver)) {
+            accumulator_add(&pane->acc[type], value_as_float(driver, &values[type]));
+        } else {
+            pane->last[type] = values[type];
+            pane->last_mask |= 1u << type;
+        }
+    }
+    
+    stats_inc(&s_stats, AGG_STAT_SAMPLES);
+}
+
+/*
+ * Add Batch of Readings
+ * 
+ * Rows are taken in runs that fall into the current pane; each run is
+ * added column by column.
+ */
+void aggregator_add_batch(const sensor_batch_t *batch)
+{
+    if (!batch) {
+        return;
+    }
+    
+    const sensor_driver_t *drivers[SENSOR_TYPE_MAX];
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        drivers[type] = sensor_service_get_driver(type);
+    }
+    
+    size_t first = 0;
+    while (first < batch->count) {
+        if (!advance_panes(batch->timestamp_us[first])) {
+            first++;
+            continue;
+        }
+        
+        int64_t pane_end_us = s_context.pane_start_us + AGG_HOP_US;
+        size_t end = first + 1;
+        while (end < batch->count && batch->timestamp_us[end] >= s_context.pane_start_us &&
+               batch->timestamp_us[end] < pane_end_us) {
+            end++;
+        }
+        
+        agg_pane_t *pane = &s_context.panes[s_context.current];
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            const sensor_value_t *column = batch->values[type];
+            uint32_t bit = 1u << type;
+            
+            if (is_numeric(drivers[type])) {
+                for (size_t i = first; i < end; i++) {
+                    if (batch->valid_mask[i] & bit) {
+                        accumulator_add(&pane->acc[type], value_as_float(drivers[type], &column[i]));
+                    }
+                }
+            } else {
+                // Only the newest value of the run is kept
+                for (size_t i = end; i-- > first;) {
+                    if (batch->valid_mask[i] & bit) {
+                        pane->last[type] = column[i];
+                        pane->last_mask |= bit;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        stats_add(&s_stats, AGG_STAT_SAMPLES, (uint32_t)(end - first));
+        first = end;
+    }
+}
+
+/*
+ * Take Next Summary
+ */
+bool aggregator_pop(sensor_data_t *summary)
+{
+    if (!summary || s_context.queue_count == 0) {
+        return false;
+    }
+    
+    *summary = s_context.queue[s_context.queue_head];
+    s_context.queue_head = (s_context.queue_head + 1) % AGG_OUTPUT_QUEUE_LEN;
+    s_context.queue_count--;
+    return true;
+}
+
+/*
+ * Get Aggregator Statistics
+ */
+void aggregator_get_stats(aggregator_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    uint32_t values[AGG_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    stats->samples = values[AGG_STAT_SAMPLES];
+    stats->late_samples = values[AGG_STAT_LATE_SAMPLES];
+    stats->windows = values[AGG_STAT_WINDOWS];
+    stats->dropped_windows = values[AGG_STAT_DROPPED_WINDOWS];
+}
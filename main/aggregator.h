@@ -0,0 +1,115 @@
+/*
+ * Aggregator Module
+ * 
+ * Turns a stream of sensor readings into one summary per window so the
+ * uplink carries per-window statistics instead of every raw reading.
+ * For every numeric sensor the summary holds count, min, max, mean,
+ * standard deviation (Welford) and approximate p50/p90/p99 from a small
+ * mergeable centroid sketch.
+ * 
+ * Windows are built from panes of AGG_HOP_SEC seconds. A window covers
+ * the last AGG_WINDOW_SEC / AGG_HOP_SEC panes and a summary is emitted
+ * every time a pane closes, so hop == window gives tumbling windows and
+ * hop < window gives sliding windows. Panes close on sample timestamps.
+ * 
+ * Features:
+ * - Streaming min/max/mean/variance with no stored samples
+ * - Mergeable percentile sketch (fixed number of centroids)
+ * - Tumbling and sliding windows from the same pane ring
+ * - Column-wise bulk input from a sensor_batch
+ * - Summaries delivered as sensor_data_t (values hold window means)
+ * 
+ * Usage:
+ *   aggregator_init();
+ * 
+ *   aggregator_add(data.timestamp_us, data.values, data.valid_mask);
+ * 
+ *   sensor_data_t summary;
+ *   while (aggregator_pop(&summary)) {
+ *       sample_buffer_push(&summary);
+ *   }
+ */
+
+#ifndef AGGREGATOR_H
+#define AGGREGATOR_H
+
+#include "esp_err.h"
+#include "sensor_batch.h"
+#include "sensor_service.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Aggregator Statistics
+ */
+typedef struct {
+    uint32_t samples;                    // Readings added
+    uint32_t late_samples;               // Readings older than the current pane (dropped)
+    uint32_t windows;                    // Summaries emitted
+    uint32_t dropped_windows;            // Summaries lost because the output queue was full
+} aggregator_stats_t;
+
+/*
+ * Initialize Aggregator
+ * 
+ * Clears all windows. Sensor drivers must be registered before the first
+ * reading is added, since their encoding decides what is aggregated.
+ * 
+ * Returns:
+ *   ESP_OK: Aggregator ready
+ */
+esp_err_t aggregator_init(void);
+
+/*
+ * Add Reading
+ * 
+ * Adds one set of readings. Closes every pane that ended before
+ * timestamp_us first, queueing a summary for each.
+ * 
+ * Parameters:
+ *   timestamp_us: Time of the readings (microseconds since boot)
+ *   values: Readings indexed by sensor_type_t
+ *   valid_mask: Bit (1 << type) set for each valid reading
+ */
+void aggregator_add(int64_t timestamp_us, const sensor_value_t *values, uint32_t valid_mask);
+
+/*
+ * Add Batch of Readings
+ * 
+ * Same as calling aggregator_add() for every row of the batch in order,
+ * but rows falling into the same pane are accumulated column by column.
+ * 
+ * Parameters:
+ *   batch: Readings, oldest first (statistics columns are ignored)
+ */
+void aggregator_add_batch(const sensor_batch_t *batch);
+
+/*
+ * Take Next Summary
+ * 
+ * Parameters:
+ *   summary: Pointer to sensor_data_t structure to populate
+ * 
+ * Returns:
+ *   true: A summary was returned (oldest first)
+ *   false: No summary pending
+ */
+bool aggregator_pop(sensor_data_t *summary);
+
+/*
+ * Get Aggregator Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to aggregator_stats_t structure to populate
+ */
+void aggregator_get_stats(aggregator_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AGGREGATOR_H
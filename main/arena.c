@@ -0,0 +1,92 @@
+/*
+ * Arena Allocator Implementation
+ */
+
+#include "arena.h"
+
+#include <string.h>
+
+// Allocation granularity (keeps every allocation 8-byte aligned)
+#define ARENA_GRANULE              8
+
+/*
+ * Initialize Arena
+ */
+esp_err_t arena_init(arena_t *arena, void *storage, size_t size)
+{
+    if (!arena || !storage || size == 0 || ((uintptr_t)storage % ARENA_GRANULE) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memset(arena, 0, sizeof(*arena));
+    arena->base = storage;
+    arena->size = size;
+    return ESP_OK;
+}
+
+/*
+ * Allocate from Arena
+ */
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    if (!arena || !arena->base) {
+        return NULL;
+    }
+    
+    size_t rounded = (size + ARENA_GRANULE - 1) & ~(size_t)(ARENA_GRANULE - 1);
+    if (rounded < size || rounded > arena->size - arena->used) {
+        arena->overflows++;
+        return NULL;
+    }
+    
+    void *ptr = arena->base + arena->used;
+    arena->used += rounded;
+    arena->live++;
+    arena->allocs++;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+    
+    return ptr;
+}
+
+/*
+ * Check Arena Ownership
+ */
+bool arena_owns(const arena_t *arena, const void *ptr)
+{
+    const uint8_t *p = ptr;
+    return arena && arena->base && p >= arena->base && p < arena->base + arena->size;
+}
+
+/*
+ * Release Arena Allocation
+ */
+void arena_release(arena_t *arena, const void *ptr)
+{
+    if (!arena_owns(arena, ptr) || arena->live == 0) {
+        return;
+    }
+    
+    if (--arena->live == 0) {
+        arena->used = 0;
+        arena->rewinds++;
+    }
+}
+
+/*
+ * Get Arena Statistics
+ */
+void arena_get_stats(const arena_t *arena, arena_stats_t *stats)
+{
+    if (!arena || !stats) {
+        return;
+    }
+    
+    stats->size = arena->size;
+    stats->used = arena->used;
+    stats->high_water = arena->high_water;
+    stats->allocs = arena->allocs;
+    stats->overflows = arena->overflows;
+    stats->rewinds = arena->rewinds;
+}
@@ -0,0 +1,144 @@
+/*
+ * Arena Allocator Module
+ * 
+ * Bump allocator over a fixed, caller-provided block. Allocation advances
+ * a single offset; individual frees only decrement a count of live
+ * allocations, and once the last live allocation is released the arena
+ * rewinds to empty. Memory whose lifetime ends together (a JSON tree and
+ * the payload printed from it) is therefore served without touching the
+ * general heap, so it cannot fragment it.
+ * 
+ * Requests that do not fit return NULL and are counted as overflows;
+ * callers fall back to the heap for them. The high-water mark shows how
+ * large the arena needs to be.
+ * 
+ * An arena is not thread-safe; it belongs to one task.
+ * 
+ * Features:
+ * - Fixed storage, no heap use
+ * - 8-byte aligned allocations
+ * - Automatic rewind when nothing is live
+ * - High-water, overflow and rewind statistics
+ * 
+ * Usage:
+ *   static uint8_t storage[8192] ARENA_ALIGN;
+ *   static arena_t arena;
+ *   arena_init(&arena, storage, sizeof(storage));
+ * 
+ *   void *p = arena_alloc(&arena, 100);
+ *   if (!p) {
+ *       p = malloc(100);            // overflow fallback
+ *   }
+ *   ...
+ *   if (arena_owns(&arena, p)) {
+ *       arena_release(&arena, p);
+ *   } else {
+ *       free(p);
+ *   }
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment of arena storage blocks and allocations
+#define ARENA_ALIGN                __attribute__((aligned(8)))
+
+/*
+ * Arena
+ */
+typedef struct {
+    uint8_t *base;                       // Storage block
+    size_t size;                         // Storage size in bytes
+    size_t used;                         // Bytes handed out since the last rewind
+    uint32_t live;                       // Allocations not yet released
+    size_t high_water;                   // Largest 'used' seen
+    uint32_t allocs;                     // Allocations served
+    uint32_t overflows;                  // Allocations refused for lack of space
+    uint32_t rewinds;                    // Times the arena was emptied
+} arena_t;
+
+/*
+ * Arena Statistics
+ */
+typedef struct {
+    uint32_t size;                       // Storage size in bytes
+    uint32_t used;                       // Bytes currently handed out
+    uint32_t high_water;                 // Largest number of bytes handed out at once
+    uint32_t allocs;                     // Allocations served
+    uint32_t overflows;                  // Allocations refused for lack of space
+    uint32_t rewinds;                    // Times the arena was emptied
+} arena_stats_t;
+
+/*
+ * Initialize Arena
+ * 
+ * Parameters:
+ *   arena: Arena to initialize
+ *   storage: Storage block, 8-byte aligned, valid while the arena is used
+ *   size: Storage size in bytes
+ * 
+ * Returns:
+ *   ESP_OK: Arena ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, zero size or misaligned storage
+ */
+esp_err_t arena_init(arena_t *arena, void *storage, size_t size);
+
+/*
+ * Allocate from Arena
+ * 
+ * Parameters:
+ *   arena: Initialized arena
+ *   size: Bytes to allocate
+ * 
+ * Returns:
+ *   8-byte aligned memory, or NULL if the arena is full (counted as overflow)
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/*
+ * Check Arena Ownership
+ * 
+ * Parameters:
+ *   arena: Initialized arena
+ *   ptr: Pointer to check
+ * 
+ * Returns:
+ *   true if ptr lies in the arena storage
+ */
+bool arena_owns(const arena_t *arena, const void *ptr);
+
+/*
+ * Release Arena Allocation
+ * 
+ * The memory is only reused after every live allocation has been
+ * released, at which point the arena rewinds.
+ * 
+ * Parameters:
+ *   arena: Initialized arena
+ *   ptr: Memory from arena_alloc()
+ */
+void arena_release(arena_t *arena, const void *ptr);
+
+/*
+ * Get Arena Statistics
+ * 
+ * Parameters:
+ *   arena: Initialized arena
+ *   stats: Pointer to arena_stats_t structure to populate
+ */
+void arena_get_stats(const arena_t *arena, arena_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARENA_H
@@ -0,0 +1,229 @@
+/*
+ * Boot Guard Implementation
+ * 
+ * Persists boot counters in NVS and implements reboot loop detection
+ * and the start-up backoff used while a loop is detected.
+ */
+
+#include "boot_guard.h"
+#include "config.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_random.h"
+#include "nvs.h"
+
+// Module logging tag
+static const char *TAG = "BOOT_GUARD";
+
+// NVS storage location
+#define BOOT_GUARD_NVS_NAMESPACE   "boot_guard"
+#define BOOT_GUARD_NVS_KEY         "counters"
+
+// Module state management
+typedef struct {
+    bool initialized;
+    bool stable;
+    bool degraded;
+    bool loop_detected;
+    boot_guard_counters_t counters;
+} boot_guard_context_t;
+
+// Global module context
+static boot_guard_context_t s_context = {
+    .initialized = false,
+    .stable = false,
+    .degraded = false,
+    .loop_detected = false
+};
+
+/*
+ * Internal function to store the counters in NVS
+ */
+static esp_err_t save_counters(void)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(BOOT_GUARD_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    ret = nvs_set_blob(handle, BOOT_GUARD_NVS_KEY, &s_context.counters, sizeof(s_context.counters));
+    if (ret == ESP_OK) {
+        ret = nvs_commit(handle);
+    }
+    
+    nvs_close(handle);
+    return ret;
+}
+
+/*
+ * Internal function to load the counters from NVS
+ */
+static esp_err_t load_counters(void)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(BOOT_GUARD_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    size_t length = sizeof(s_context.counters);
+    ret = nvs_get_blob(handle, BOOT_GUARD_NVS_KEY, &s_context.counters, &length);
+    if (ret == ESP_ERR_NVS_NOT_FOUND || (ret == ESP_OK && length != sizeof(s_context.counters))) {
+        // First boot or layout change: start from zero
+        memset(&s_context.counters, 0, sizeof(s_context.counters));
+        ret = ESP_OK;
+    }
+    
+    nvs_close(handle);
+    return ret;
+}
+
+/*
+ * Initialize Boot Guard
+ */
+esp_err_t boot_guard_init(void)
+{
+    if (s_context.initialized) {
+        return ESP_OK;
+    }
+    
+    esp_err_t ret = load_counters();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to load boot counters: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    boot_guard_counters_t *counters = &s_context.counters;
+#if CONFIG_IDF_TARGET_LINUX
+    esp_reset_reason_t reason = ESP_RST_POWERON;  // Every host run is a cold start
+#else
+    esp_reset_reason_t reason = esp_reset_reason();
+#endif
+    counters->boot_count++;
+    
+    // Deep-sleep wakes are scheduled, short-lived boots and never count as unstable
+    if (reason == ESP_RST_DEEPSLEEP) {
+        counters->unstable_boots = 0;
+    } else {
+        counters->unstable_boots++;  // Cleared again once this boot becomes stable
+    }
+    
+    switch (reason) {
+        case ESP_RST_PANIC:
+            counters->panic_resets++;
+            break;
+        case ESP_RST_INT_WDT:
+        case ESP_RST_TASK_WDT:
+        case ESP_RST_WDT:
+            counters->watchdog_resets++;
+            break;
+        case ESP_RST_BROWNOUT:
+            counters->brownout_resets++;
+            break;
+        default:
+            break;
+    }
+    
+    // The current boot is included, so a loop needs THRESHOLD unstable boots in a row
+    s_context.loop_detected = (counters->unstable_boots >= BOOT_LOOP_THRESHOLD);
+    if (s_context.loop_detected) {
+        counters->loop_detections++;
+    }
+    
+    ret = save_counters();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to store boot counters: %s", esp_err_to_name(ret));
+    }
+    
+    s_context.initialized = true;
+    
+    ESP_LOGI(TAG, "Boot #%lu, consecutive unstable boots: %lu%s",
+             (unsigned long)counters->boot_count, (unsigned long)counters->unstable_boots,
+             s_context.loop_detected ? " (reboot loop detected)" : "");
+    return ESP_OK;
+}
+
+/*
+ * Check for Reboot Loop
+ */
+bool boot_guard_loop_detected(void)
+{
+    return s_context.loop_detected;
+}
+
+/*
+ * Get Start-up Delay
+ */
+uint32_t boot_guard_startup_delay_ms(void)
+{
+    if (!s_context.loop_detected) {
+        return 0;
+    }
+    
+    // Double the delay for every unstable boot beyond the threshold
+    uint32_t excess = s_context.counters.unstable_boots - BOOT_LOOP_THRESHOLD;
+    uint32_t delay_ms = BOOT_LOOP_BACKOFF_MAX_MS;
+    if (excess < 16 && ((uint64_t)BOOT_LOOP_BACKOFF_BASE_MS << excess) < BOOT_LOOP_BACKOFF_MAX_MS) {
+        delay_ms = BOOT_LOOP_BACKOFF_BASE_MS << excess;
+    }
+    
+    // Up to 50% jitter spreads the fleet out
+    return delay_ms / 2 + esp_random() % (delay_ms / 2 + 1);
+}
+
+/*
+ * Record Degraded Start
+ */
+void boot_guard_mark_degraded(void)
+{
+    if (!s_context.initialized || s_context.degraded) {
+        return;
+    }
+    
+    s_context.degraded = true;
+    s_context.counters.degraded_boots++;
+    save_counters();
+}
+
+/*
+ * Mark Boot as Stable
+ */
+void boot_guard_mark_stable(void)
+{
+    if (!s_context.initialized || s_context.stable) {
+        return;
+    }
+    
+    if (esp_timer_get_time() < (int64_t)BOOT_STABLE_TIME_SEC * 1000000) {
+        return;
+    }
+    
+    s_context.stable = true;
+    s_context.loop_detected = false;
+    s_context.counters.unstable_boots = 0;
+    
+    esp_err_t ret = save_counters();
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to store boot counters: %s", esp_err_to_name(ret));
+        return;
+    }
+    
+    ESP_LOGI(TAG, "Boot marked stable after %d seconds", BOOT_STABLE_TIME_SEC);
+}
+
+/*
+ * Get Boot Counters
+ */
+esp_err_t boot_guard_get_counters(boot_guard_counters_t *counters)
+{
+    if (!counters) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *counters = s_context.counters;
+    return ESP_OK;
+}
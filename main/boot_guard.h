@@ -0,0 +1,117 @@
+/*
+ * Boot Guard Module
+ * 
+ * Detects reboot loops and keeps reset counters that survive reboots.
+ * Counters are stored in NVS and updated once per boot. A boot that does
+ * not reach BOOT_STABLE_TIME_SEC of uptime counts as unstable; after
+ * BOOT_LOOP_THRESHOLD consecutive unstable boots a reboot loop is
+ * reported so start-up can back off instead of repeating the same
+ * expensive sequence.
+ * 
+ * Features:
+ * - Persistent boot, reset-reason and degraded-start counters
+ * - Consecutive unstable boot tracking and loop detection
+ * - Jittered, growing start-up delay while a loop is detected
+ * 
+ * Usage:
+ *   boot_guard_init();                   // after NVS is initialized
+ *   if (boot_guard_loop_detected()) {
+ *       wifi_manager_connect_after(boot_guard_startup_delay_ms());
+ *   }
+ * 
+ *   // Later, from the main loop
+ *   boot_guard_mark_stable();
+ */
+
+#ifndef BOOT_GUARD_H
+#define BOOT_GUARD_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Persistent Boot Counters
+ */
+typedef struct {
+    uint32_t boot_count;                 // Total boots
+    uint32_t unstable_boots;             // Consecutive boots that did not reach stable uptime
+    uint32_t loop_detections;            // Boots on which a reboot loop was detected
+    uint32_t degraded_boots;             // Boots that started without connectivity
+    uint32_t panic_resets;               // Resets caused by panics
+    uint32_t watchdog_resets;            // Resets caused by interrupt/task watchdogs
+    uint32_t brownout_resets;            // Resets caused by brownout
+} boot_guard_counters_t;
+
+/*
+ * Initialize Boot Guard
+ * 
+ * Loads the counters from NVS, accounts for this boot and its reset
+ * reason, and stores them again. NVS must be initialized first.
+ * 
+ * Returns:
+ *   ESP_OK: Counters updated
+ *   ESP_ERR_*: NVS errors (loop detection is then unavailable)
+ */
+esp_err_t boot_guard_init(void);
+
+/*
+ * Check for Reboot Loop
+ * 
+ * Returns:
+ *   true: At least BOOT_LOOP_THRESHOLD consecutive boots were unstable
+ *   false: No reboot loop detected
+ */
+bool boot_guard_loop_detected(void);
+
+/*
+ * Get Start-up Delay
+ * 
+ * Returns the delay to apply before bringing up the radio while a reboot
+ * loop is detected. The delay doubles with each further unstable boot up
+ * to BOOT_LOOP_BACKOFF_MAX_MS, with random jitter so devices recovering
+ * from the same outage do not reconnect in step.
+ * 
+ * Returns:
+ *   uint32_t: Delay in milliseconds (0 when no loop is detected)
+ */
+uint32_t boot_guard_startup_delay_ms(void);
+
+/*
+ * Record Degraded Start
+ * 
+ * Counts this boot as one that started without connectivity.
+ * Only the first call per boot is recorded.
+ */
+void boot_guard_mark_degraded(void);
+
+/*
+ * Mark Boot as Stable
+ * 
+ * Clears the consecutive unstable boot count once uptime has reached
+ * BOOT_STABLE_TIME_SEC. Cheap to call on every cycle; NVS is only written
+ * the first time the boot becomes stable.
+ */
+void boot_guard_mark_stable(void);
+
+/*
+ * Get Boot Counters
+ * 
+ * Parameters:
+ *   counters: Pointer to boot_guard_counters_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Counters retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid counters pointer
+ */
+esp_err_t boot_guard_get_counters(boot_guard_counters_t *counters);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_GUARD_H
@@ -0,0 +1,279 @@
+/*
+ * Boot Orchestrator Implementation
+ * 
+ * Runs the startup sequence with WiFi association and service
+ * initialization overlapped, and records per-stage boot timings.
+ * WiFi failures do not fail the boot; the application starts degraded
+ * and connectivity is retried in the background.
+ */
+
+#include "boot_orchestrator.h"
+#include "config.h"
+#include "wifi_manager.h"
+#include "sensor_service.h"
+#include "http_client.h"
+#include "boot_guard.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs_flash.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+
+// Module logging tag
+static const char *TAG = "BOOT";
+
+// Completion bits for concurrent initialization jobs
+#define BOOT_SENSOR_DONE_BIT       BIT0
+#define BOOT_HTTP_DONE_BIT         BIT1
+
+// Concurrent initialization job
+typedef struct {
+    boot_stage_t stage;
+    esp_err_t (*init)(void);
+    EventBits_t done_bit;
+    const char *task_name;
+} boot_job_t;
+
+// Module state management
+typedef struct {
+    bool completed;
+    esp_err_t result;                    // Result of the completed sequence
+    boot_timings_t timings;
+    EventGroupHandle_t job_events;
+} boot_context_t;
+
+// Global module context
+static boot_context_t s_context = {
+    .completed = false,
+    .result = ESP_OK,
+    .job_events = NULL
+};
+
+// Services that do not depend on each other or on the network
+static const boot_job_t s_jobs[] = {
+    { BOOT_STAGE_SENSOR_INIT, sensor_service_init, BOOT_SENSOR_DONE_BIT, "boot_sensor" },
+    { BOOT_STAGE_HTTP_INIT,   http_client_init,    BOOT_HTTP_DONE_BIT,   "boot_http"   },
+};
+
+static const char *s_stage_names[BOOT_STAGE_MAX] = {
+    [BOOT_STAGE_NVS]          = "nvs",
+    [BOOT_STAGE_WIFI_INIT]    = "wifi_init",
+    [BOOT_STAGE_SENSOR_INIT]  = "sensor_init",
+    [BOOT_STAGE_HTTP_INIT]    = "http_init",
+    [BOOT_STAGE_WIFI_CONNECT] = "wifi_connect",
+    [BOOT_STAGE_FIRST_SAMPLE] = "first_sample",
+    [BOOT_STAGE_FIRST_UPLOAD] = "first_upload",
+};
+
+/*
+ * Initialize NVS Flash
+ * 
+ * Initializes Non-Volatile Storage which is required for WiFi and other
+ * ESP-IDF components that need persistent storage.
+ */
+static esp_err_t init_nvs_flash(void)
+{
+    ESP_LOGI(TAG, "Initializing NVS flash...");
+    
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        // NVS partition was truncated and needs to be erased
+        ESP_LOGW(TAG, "NVS partition needs to be erased, performing erase...");
+        ret = nvs_flash_erase();
+        if (ret == ESP_OK) {
+            ret = nvs_flash_init();
+        }
+    }
+    
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "NVS flash initialized successfully");
+    } else {
+        ESP_LOGE(TAG, "Failed to initialize NVS flash: %s", esp_err_to_name(ret));
+    }
+    
+    return ret;
+}
+
+/*
+ * Concurrent Initialization Task
+ * 
+ * Runs one service initializer, records its timing and signals completion.
+ */
+static void boot_job_task(void *arg)
+{
+    const boot_job_t *job = (const boot_job_t *)arg;
+    
+    boot_orchestrator_stage_begin(job->stage);
+    esp_err_t ret = job->init();
+    boot_orchestrator_stage_end(job->stage, ret);
+    
+    xEventGroupSetBits(s_context.job_events, job->done_bit);
+    vTaskDelete(NULL);
+}
+
+/*
+ * Run Boot Sequence
+ */
+esp_err_t boot_orchestrator_run(void)
+{
+    if (s_context.completed) {
+        return s_context.result;
+    }
+    
+    // Step 1: NVS is a prerequisite for WiFi. Without it the boot continues
+    // without persistence; WiFi init will most likely fail and the
+    // application runs degraded.
+    boot_orchestrator_stage_begin(BOOT_STAGE_NVS);
+    esp_err_t ret = init_nvs_flash();
+    boot_orchestrator_stage_end(BOOT_STAGE_NVS, ret);
+    
+    // Reboot loop detection needs NVS; without it boot continues unguarded
+    if (ret == ESP_OK) {
+        boot_guard_init();
+    } else {
+        ESP_LOGW(TAG, "Continuing without persistent storage");
+    }
+    
+    // Step 2: Start association first; it is the slowest stage. A WiFi
+    // failure does not stop the boot, the application runs degraded.
+    boot_orchestrator_stage_begin(BOOT_STAGE_WIFI_INIT);
+    ret = wifi_manager_init();
+    boot_orchestrator_stage_end(BOOT_STAGE_WIFI_INIT, ret);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to initialize WiFi manager: %s", esp_err_to_name(ret));
+    } else if (boot_guard_loop_detected()) {
+        // Hold off the radio instead of repeating the same failing sequence
+        uint32_t delay_ms = boot_guard_startup_delay_ms();
+        ESP_LOGW(TAG, "Reboot loop detected, delaying WiFi start by %lu ms",
+                 (unsigned long)delay_ms);
+        boot_orchestrator_stage_begin(BOOT_STAGE_WIFI_CONNECT);
+        wifi_manager_connect_after(delay_ms);
+    } else {
+        boot_orchestrator_stage_begin(BOOT_STAGE_WIFI_CONNECT);
+        ret = wifi_manager_connect_async();
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to start WiFi association: %s", esp_err_to_name(ret));
+        }
+    }
+    
+    // Step 3: Initialize remaining services concurrently while the link comes up
+    if (s_context.job_events == NULL) {
+        s_context.job_events = xEventGroupCreate();
+        if (s_context.job_events == NULL) {
+            ESP_LOGW(TAG, "Failed to create job event group, initializing inline");
+        }
+    }
+    if (s_context.job_events != NULL) {
+        xEventGroupClearBits(s_context.job_events, BOOT_SENSOR_DONE_BIT | BOOT_HTTP_DONE_BIT);
+    }
+    
+    EventBits_t wait_bits = 0;
+    for (size_t i = 0; i < ARRAY_SIZE(s_jobs); i++) {
+        if (s_context.job_events != NULL &&
+            xTaskCreate(boot_job_task, s_jobs[i].task_name, TASK_STACK_SIZE,
+                        (void *)&s_jobs[i], BOOT_TASK_PRIORITY, NULL) == pdPASS) {
+            wait_bits |= s_jobs[i].done_bit;
+        } else {
+            // Fall back to running the job inline
+            ESP_LOGW(TAG, "Failed to create %s task, initializing inline", s_jobs[i].task_name);
+            boot_orchestrator_stage_begin(s_jobs[i].stage);
+            boot_orchestrator_stage_end(s_jobs[i].stage, s_jobs[i].init());
+        }
+    }
+    
+    if (wait_bits != 0) {
+        xEventGroupWaitBits(s_context.job_events, wait_bits, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    
+    // A failing service does not stop the boot; the application runs
+    // degraded and the first error is returned to the caller
+    esp_err_t first_error = s_context.timings.stages[BOOT_STAGE_NVS].result;
+    for (size_t i = 0; i < ARRAY_SIZE(s_jobs); i++) {
+        esp_err_t job_ret = s_context.timings.stages[s_jobs[i].stage].result;
+        if (job_ret != ESP_OK) {
+            ESP_LOGE(TAG, "Stage %s failed: %s",
+                     boot_orchestrator_stage_name(s_jobs[i].stage), esp_err_to_name(job_ret));
+            if (first_error == ESP_OK) {
+                first_error = job_ret;
+            }
+        }
+    }
+    
+    // The sequence is not repeated, even when degraded: re-initializing
+    // would not fix a failing stage and would only cost time on every wake
+    s_context.completed = true;
+    s_context.result = first_error;
+    
+    if (first_error != ESP_OK) {
+        boot_guard_mark_degraded();
+        return first_error;
+    }
+    
+    ESP_LOGI(TAG, "Services ready at %lld ms after reset",
+             (long long)(esp_timer_get_time() / 1000));
+    return ESP_OK;
+}
+
+/*
+ * Record Stage Start
+ */
+void boot_orchestrator_stage_begin(boot_stage_t stage)
+{
+    if (stage >= BOOT_STAGE_MAX || s_context.timings.stages[stage].start_us != 0) {
+        return;
+    }
+    
+    s_context.timings.stages[stage].start_us = esp_timer_get_time();
+}
+
+/*
+ * Record Stage End
+ */
+void boot_orchestrator_stage_end(boot_stage_t stage, esp_err_t result)
+{
+    if (stage >= BOOT_STAGE_MAX) {
+        return;
+    }
+    
+    // A failed attempt is replaced by a later one, so the stage ends at the
+    // first success (e.g. a background reconnect after a failed boot connect)
+    boot_stage_timing_t *timing = &s_context.timings.stages[stage];
+    if (timing->end_us != 0 && timing->result == ESP_OK) {
+        return;
+    }
+    
+    timing->end_us = esp_timer_get_time();
+    timing->result = result;
+    
+    ESP_LOGI(TAG, "Stage %s: %lld..%lld ms (%s)", boot_orchestrator_stage_name(stage),
+             (long long)(timing->start_us / 1000), (long long)(timing->end_us / 1000),
+             esp_err_to_name(result));
+}
+
+/*
+ * Get Boot Timings
+ */
+esp_err_t boot_orchestrator_get_timings(boot_timings_t *timings)
+{
+    if (!timings) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *timings = s_context.timings;
+    return ESP_OK;
+}
+
+/*
+ * Get Boot Stage Name
+ */
+const char *boot_orchestrator_stage_name(boot_stage_t stage)
+{
+    if (stage >= BOOT_STAGE_MAX) {
+        return "unknown";
+    }
+    
+    return s_stage_names[stage];
+}
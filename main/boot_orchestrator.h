@@ -0,0 +1,132 @@
+/*
+ * Boot Orchestrator Module
+ * 
+ * Brings the application up with as much overlap as possible. WiFi
+ * association is started first, and the sensor service and HTTP client
+ * (including its JSON encoder) are initialized concurrently on their own
+ * tasks while the link comes up. Every stage is timestamped relative to
+ * reset so boot performance can be reported once the first upload is in.
+ * 
+ * Features:
+ * - Early, non-blocking start of WiFi association
+ * - Concurrent initialization of independent services
+ * - Per-stage boot timings (start, end, result) from reset
+ * 
+ * Usage:
+ *   boot_orchestrator_run();                   // never aborts, see below
+ *   esp_err_t ret = wifi_manager_connect();    // waits for association
+ *   boot_orchestrator_stage_end(BOOT_STAGE_WIFI_CONNECT, ret);
+ * 
+ *   boot_timings_t timings;
+ *   boot_orchestrator_get_timings(&timings);
+ */
+
+#ifndef BOOT_ORCHESTRATOR_H
+#define BOOT_ORCHESTRATOR_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Boot Stages
+ */
+typedef enum {
+    BOOT_STAGE_NVS = 0,                  // NVS flash initialization
+    BOOT_STAGE_WIFI_INIT,                // WiFi manager initialization
+    BOOT_STAGE_SENSOR_INIT,              // Sensor service initialization (concurrent)
+    BOOT_STAGE_HTTP_INIT,                // HTTP client initialization (concurrent)
+    BOOT_STAGE_WIFI_CONNECT,             // Association start until IP address
+    BOOT_STAGE_FIRST_SAMPLE,             // First sensor reading
+    BOOT_STAGE_FIRST_UPLOAD,             // First data upload
+    BOOT_STAGE_MAX
+} boot_stage_t;
+
+/*
+ * Timing of a Single Boot Stage
+ * 
+ * Times are microseconds since reset as measured by esp_timer, which
+ * starts during early startup. Zero means the stage has not happened.
+ */
+typedef struct {
+    int64_t start_us;                    // Stage start time
+    int64_t end_us;                      // Stage end time
+    esp_err_t result;                    // Stage result
+} boot_stage_timing_t;
+
+/*
+ * Boot Timings
+ */
+typedef struct {
+    boot_stage_timing_t stages[BOOT_STAGE_MAX];
+} boot_timings_t;
+
+/*
+ * Run Boot Sequence
+ * 
+ * Initializes NVS, starts WiFi association without waiting for it, then
+ * initializes the sensor service and HTTP client concurrently. Returns
+ * once all services are initialized; the WiFi link may still be coming up.
+ * Calling it again does nothing and returns the result of the first run.
+ * 
+ * WiFi failures do not fail the boot. While boot_guard reports a reboot
+ * loop, association is deferred by boot_guard_startup_delay_ms().
+ * 
+ * Failing stages do not stop the sequence either: without NVS the boot
+ * continues without persistence, and a failing service is logged and
+ * the boot marked degraded (boot_guard_mark_degraded()). The caller can
+ * keep running; the returned error only tells it what is missing.
+ * 
+ * Returns:
+ *   ESP_OK: All services initialized (WiFi may be unavailable)
+ *   ESP_ERR_*: Error of the first failing stage (boot continued degraded)
+ */
+esp_err_t boot_orchestrator_run(void);
+
+/*
+ * Record Stage Start / End
+ * 
+ * Only the first start and the first successful end of each stage are
+ * recorded, so these can be called on every cycle for stages such as
+ * BOOT_STAGE_FIRST_UPLOAD. A failed end is overwritten by a later end;
+ * the stage then spans from the first attempt to the first success.
+ * 
+ * Parameters:
+ *   stage: Stage being recorded
+ *   result: Stage result (end only)
+ */
+void boot_orchestrator_stage_begin(boot_stage_t stage);
+void boot_orchestrator_stage_end(boot_stage_t stage, esp_err_t result);
+
+/*
+ * Get Boot Timings
+ * 
+ * Parameters:
+ *   timings: Pointer to boot_timings_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Timings retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid timings pointer
+ */
+esp_err_t boot_orchestrator_get_timings(boot_timings_t *timings);
+
+/*
+ * Get Boot Stage Name
+ * 
+ * Parameters:
+ *   stage: Boot stage
+ * 
+ * Returns:
+ *   const char*: Short stage name (also used as JSON key)
+ */
+const char *boot_orchestrator_stage_name(boot_stage_t stage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BOOT_ORCHESTRATOR_H
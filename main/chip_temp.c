@@ -0,0 +1,269 @@
+/*
+ * On-Chip Temperature Sensor Driver Implementation
+ * 
+ * Power state is shared between the reading task and the idle timer
+ * callback, so both run under a mutex. esp_timer_stop() does not wait
+ * for a callback already dispatched, so deinit raises a stopping flag
+ * and waits until no callback is inside before deleting the mutex.
+ */
+
+#include "chip_temp.h"
+#include "config.h"
+#include "stats_block.h"
+
+#include <stdatomic.h>
+#include "esp_log.h"
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    CHIP_TEMP_STAT_READS = 0,
+    CHIP_TEMP_STAT_ERRORS,
+    CHIP_TEMP_STAT_POWER_UPS,
+    CHIP_TEMP_STAT_COUNT
+} chip_temp_stat_t;
+
+// Updated by the reading task, read by status and metrics (also
+// reported when the driver is unavailable)
+STATS_BLOCK_DEFINE(s_stats, CHIP_TEMP_STAT_COUNT);
+
+#if CHIP_TEMP_SENSOR_ENABLED
+
+#include "driver/temperature_sensor.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+// Module logging tag
+static const char *TAG = "CHIP_TEMP";
+
+// Module state management
+typedef struct {
+    temperature_sensor_handle_t handle;  // Installed once, holds range and calibration
+    SemaphoreHandle_t lock;
+    esp_timer_handle_t idle_timer;
+    bool powered;
+    int64_t last_read_us;
+    atomic_bool stopping;                // Set by deinit, callbacks leave the lock alone
+    atomic_int callbacks_active;         // Idle timer callbacks currently running
+} chip_temp_context_t;
+
+// Global module context
+static chip_temp_context_t s_context = {
+    .handle = NULL,
+    .lock = NULL,
+    .idle_timer = NULL,
+    .powered = false
+};
+
+/*
+ * Internal function to power the sensor down (lock held)
+ */
+static void power_off(void)
+{
+    if (s_context.powered) {
+        temperature_sensor_disable(s_context.handle);
+        s_context.powered = false;
+    }
+}
+
+/*
+ * Internal function called when the idle window may have expired
+ */
+static void idle_timer_callback(void *arg)
+{
+    // Counted before the flag is checked, so deinit either sees this
+    // callback or this callback sees the flag
+    atomic_fetch_add(&s_context.callbacks_active, 1);
+    if (atomic_load(&s_context.stopping)) {
+        atomic_fetch_sub(&s_context.callbacks_active, 1);
+        return;
+    }
+    
+    xSemaphoreTake(s_context.lock, portMAX_DELAY);
+    
+    // Deinit may have started while this callback waited for the lock
+    if (!atomic_load(&s_context.stopping)) {
+        int64_t idle_us = esp_timer_get_time() - s_context.last_read_us;
+        int64_t window_us = (int64_t)CHIP_TEMP_IDLE_MS * 1000;
+        if (idle_us >= window_us) {
+            power_off();
+        } else {
+            esp_timer_start_once(s_context.idle_timer, window_us - idle_us);
+        }
+    }
+    
+    xSemaphoreGive(s_context.lock);
+    atomic_fetch_sub(&s_context.callbacks_active, 1);
+}
+
+/*
+ * Driver init: install the peripheral once
+ */
+static esp_err_t chip_temp_init(void)
+{
+    if (s_context.handle) {
+        return ESP_OK;
+    }
+    
+    atomic_store(&s_context.stopping, false);
+    
+    temperature_sensor_config_t config = TEMPERATURE_SENSOR_CONFIG_DEFAULT(CHIP_TEMP_RANGE_MIN, CHIP_TEMP_RANGE_MAX);
+    esp_err_t ret = temperature_sensor_install(&config, &s_context.handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to install temperature sensor: %s", esp_err_to_name(ret));
+        s_context.handle = NULL;
+        return ret;
+    }
+    
+    s_context.lock = xSemaphoreCreateMutex();
+    if (!s_context.lock) {
+        temperature_sensor_uninstall(s_context.handle);
+        s_context.handle = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (CHIP_TEMP_IDLE_MS > 0) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = idle_timer_callback,
+            .name = "chip_temp_idle"
+        };
+        ret = esp_timer_create(&timer_args, &s_context.idle_timer);
+        if (ret != ESP_OK) {
+            vSemaphoreDelete(s_context.lock);
+            temperature_sensor_uninstall(s_context.handle);
+            s_context.lock = NULL;
+            s_context.handle = NULL;
+            return ret;
+        }
+    }
+    
+    ESP_LOGI(TAG, "On-chip temperature sensor installed (range %d..%d °C, idle window %d ms)",
+             CHIP_TEMP_RANGE_MIN, CHIP_TEMP_RANGE_MAX, CHIP_TEMP_IDLE_MS);
+    return ESP_OK;
+}
+
+/*
+ * Driver read: power up if needed, convert, schedule power down
+ */
+static esp_err_t chip_temp_read(sensor_value_t *value)
+{
+    if (!s_context.handle) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    xSemaphoreTake(s_context.lock, portMAX_DELAY);
+    
+    esp_err_t ret = ESP_OK;
+    bool powered_up = false;
+    if (!s_context.powered) {
+        ret = temperature_sensor_enable(s_context.handle);
+        if (ret == ESP_OK) {
+            s_context.powered = true;
+            powered_up = true;
+        }
+    }
+    
+    if (ret == ESP_OK) {
+        ret = temperature_sensor_get_celsius(s_context.handle, &value->f);
+    }
+    
+    stats_update_begin(&s_stats);
+    if (powered_up) {
+        stats_inc(&s_stats, CHIP_TEMP_STAT_POWER_UPS);
+    }
+    stats_inc(&s_stats, (ret == ESP_OK) ? CHIP_TEMP_STAT_READS : CHIP_TEMP_STAT_ERRORS);
+    stats_update_end(&s_stats);
+    
+    s_context.last_read_us = esp_timer_get_time();
+    if (CHIP_TEMP_IDLE_MS == 0) {
+        power_off();
+    } else if (s_context.powered && !esp_timer_is_active(s_context.idle_timer)) {
+        esp_timer_start_once(s_context.idle_timer, (uint64_t)CHIP_TEMP_IDLE_MS * 1000);
+    }
+    
+    xSemaphoreGive(s_context.lock);
+    
+    ESP_LOGD(TAG, "CPU temperature: %.1f°C", value->f);
+    return ret;
+}
+
+/*
+ * Driver deinit: power down and release the peripheral
+ */
+static void chip_temp_deinit(void)
+{
+    if (!s_context.handle) {
+        return;
+    }
+    
+    // Keep new callbacks away from the lock, then wait for the one that
+    // may already be dispatched before the timer and the lock go away
+    atomic_store(&s_context.stopping, true);
+    if (s_context.idle_timer) {
+        esp_timer_stop(s_context.idle_timer);
+        while (atomic_load(&s_context.callbacks_active) > 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        esp_timer_delete(s_context.idle_timer);
+        s_context.idle_timer = NULL;
+    }
+    
+    xSemaphoreTake(s_context.lock, portMAX_DELAY);
+    power_off();
+    temperature_sensor_uninstall(s_context.handle);
+    s_context.handle = NULL;
+    xSemaphoreGive(s_context.lock);
+    
+    vSemaphoreDelete(s_context.lock);
+    s_context.lock = NULL;
+}
+
+static const sensor_driver_t s_chip_temp_driver = {
+    .type = SENSOR_TYPE_CPU_TEMP,
+    .name = "CHIP_TEMP",
+    .json_field = JSON_FIELD_CPU_TEMP,
+    .value_type = SENSOR_VALUE_FLOAT,
+    .encoding = SENSOR_ENCODING_NUMBER,
+    .decimals = 2,
+    .init = chip_temp_init,
+    .read = chip_temp_read,
+    .deinit = chip_temp_deinit,
+};
+
+/*
+ * Get On-Chip Temperature Driver
+ */
+const sensor_driver_t *chip_temp_get_driver(void)
+{
+    return &s_chip_temp_driver;
+}
+
+#else // !CHIP_TEMP_SENSOR_ENABLED
+
+/*
+ * Get On-Chip Temperature Driver (not available, simulation is used)
+ */
+const sensor_driver_t *chip_temp_get_driver(void)
+{
+    return NULL;
+}
+
+#endif // CHIP_TEMP_SENSOR_ENABLED
+
+/*
+ * Get Driver Statistics
+ */
+void chip_temp_get_stats(chip_temp_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    uint32_t values[CHIP_TEMP_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    stats->reads = values[CHIP_TEMP_STAT_READS];
+    stats->errors = values[CHIP_TEMP_STAT_ERRORS];
+    stats->power_ups = values[CHIP_TEMP_STAT_POWER_UPS];
+}
@@ -0,0 +1,72 @@
+/*
+ * On-Chip Temperature Sensor Driver
+ * 
+ * Sensor driver for the internal temperature sensor of the ESP32-S2/S3/C3
+ * family, using the ESP-IDF temperature_sensor API. The peripheral is
+ * installed once in init(), which selects the measurement range and loads
+ * its calibration; reads only power the sensor up and down.
+ * 
+ * The sensor is powered only during read windows: with
+ * CHIP_TEMP_IDLE_MS == 0 it is enabled and disabled around every read,
+ * otherwise it stays on until no read happened for CHIP_TEMP_IDLE_MS, so
+ * a fast sampler does not pay the power-up on every reading.
+ * 
+ * The sensor service installs this driver for SENSOR_TYPE_CPU_TEMP when
+ * CHIP_TEMP_SENSOR_ENABLED. On targets without the peripheral (including
+ * the linux host target) chip_temp_get_driver() returns NULL and the
+ * simulated temperature stays in place, behind the same driver interface.
+ * 
+ * Features:
+ * - Range and calibration set up once per boot
+ * - Power kept on only while reads are in progress
+ * - Read, error and power-up counters
+ * 
+ * Usage:
+ *   const sensor_driver_t *driver = chip_temp_get_driver();
+ *   if (driver) {
+ *       sensor_service_register_driver(driver);
+ *   }
+ */
+
+#ifndef CHIP_TEMP_H
+#define CHIP_TEMP_H
+
+#include "esp_err.h"
+#include "sensor_service.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Driver Statistics
+ */
+typedef struct {
+    uint32_t reads;                      // Successful conversions
+    uint32_t errors;                     // Failed power-ups or conversions
+    uint32_t power_ups;                  // Times the sensor was enabled
+} chip_temp_stats_t;
+
+/*
+ * Get On-Chip Temperature Driver
+ * 
+ * Returns:
+ *   Driver descriptor for SENSOR_TYPE_CPU_TEMP, or NULL when the target has
+ *   no temperature sensor or the driver is disabled in the configuration
+ */
+const sensor_driver_t *chip_temp_get_driver(void);
+
+/*
+ * Get Driver Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to chip_temp_stats_t structure to populate
+ */
+void chip_temp_get_stats(chip_temp_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHIP_TEMP_H
@@ -34,6 +34,41 @@
 #define WIFI_MAXIMUM_RETRY          CONFIG_TCP_CLIENT_MAXIMUM_RETRY
 #define WIFI_CONNECT_TIMEOUT_MS     10000                              // 10 seconds
 #define WIFI_AUTH_MODE              WIFI_AUTH_WPA2_PSK                 // Security mode
+#define WIFI_RECONNECT_BASE_MS      5000                               // First background reconnect delay
+#define WIFI_RECONNECT_MAX_MS       300000                             // Backoff ceiling (5 minutes)
+
+// WiFi power policy (modem sleep level and listen interval)
+#if defined(CONFIG_TCP_CLIENT_WIFI_POWER_SAVE_NONE)
+#define WIFI_POWER_SAVE_DEFAULT     WIFI_POWER_SAVE_NONE
+#elif defined(CONFIG_TCP_CLIENT_WIFI_POWER_SAVE_MAX)
+#define WIFI_POWER_SAVE_DEFAULT     WIFI_POWER_SAVE_MAX
+#else
+#define WIFI_POWER_SAVE_DEFAULT     WIFI_POWER_SAVE_MIN
+#endif
+#define WIFI_LISTEN_INTERVAL        CONFIG_TCP_CLIENT_WIFI_LISTEN_INTERVAL
+#define WIFI_BEACON_INTERVAL_US     102400                             // Typical AP beacon interval (100 TU)
+#define WIFI_BEACON_WAKE_US         3000                               // Radio-on time per beacon wake (estimate)
+
+// Link quality telemetry
+#define WIFI_LINK_SAMPLE_INTERVAL_MS CONFIG_TCP_CLIENT_LINK_SAMPLE_INTERVAL_MS
+#define WIFI_LINK_HISTORY_LEN       32                                 // Link samples kept in history ring
+#ifdef CONFIG_TCP_CLIENT_LINK_TELEMETRY_UPLOAD
+    #define LINK_TELEMETRY_UPLOAD   1
+#else
+    #define LINK_TELEMETRY_UPLOAD   0
+#endif
+
+// Simulated link of the linux target (see wifi_manager_fake.c)
+#ifdef CONFIG_TCP_CLIENT_FAKE_WIFI_DROP_INTERVAL
+    #define WIFI_FAKE_DROP_INTERVAL_S  CONFIG_TCP_CLIENT_FAKE_WIFI_DROP_INTERVAL
+    #define WIFI_FAKE_OUTAGE_MS        CONFIG_TCP_CLIENT_FAKE_WIFI_OUTAGE_MS
+#else
+    #define WIFI_FAKE_DROP_INTERVAL_S  0
+    #define WIFI_FAKE_OUTAGE_MS        0
+#endif
+#define WIFI_FAKE_ASSOC_MS          150                                // Simulated association + DHCP time
+#define WIFI_FAKE_RSSI_DBM          (-55)                              // Mean simulated signal strength
+#define WIFI_FAKE_CHANNEL           6                                  // Simulated primary channel
 
 // WiFi Event Bits for FreeRTOS event groups
 #define WIFI_CONNECTED_BIT          BIT0
@@ -46,12 +81,41 @@
 #define HTTP_TIMEOUT_MS            5000                               // 5 seconds
 #define HTTP_CONTENT_TYPE          "application/json"
 #define HTTP_USER_AGENT            "ESP32-TCP-Client/1.0"
+#define REQUEST_ARENA_SIZE         CONFIG_TCP_CLIENT_REQUEST_ARENA_SIZE // JSON arena per request (bytes)
 
 /*
  * Data Transmission Configuration
  */
 #define POST_INTERVAL_SEC          CONFIG_TCP_CLIENT_POST_INTERVAL
 #define POST_INTERVAL_MS           (POST_INTERVAL_SEC * 1000)        // Convert to milliseconds
+#define UPLOAD_BATCH_SIZE          CONFIG_TCP_CLIENT_UPLOAD_BATCH_SIZE // Samples sent per HTTP POST
+
+/*
+ * Degraded Mode and Reboot Loop Protection
+ */
+#define OFFLINE_BUFFER_SIZE        CONFIG_TCP_CLIENT_OFFLINE_BUFFER_SIZE // Samples kept while offline
+#define OFFLINE_FLUSH_MAX_BATCHES  4                                 // Backlog batches sent per cycle
+#define BOOT_LOOP_THRESHOLD        CONFIG_TCP_CLIENT_BOOT_LOOP_THRESHOLD
+#define BOOT_STABLE_TIME_SEC       120                               // Uptime after which a boot counts as stable
+#define BOOT_LOOP_BACKOFF_BASE_MS  10000                             // WiFi start delay on first detected loop
+#define BOOT_LOOP_BACKOFF_MAX_MS   600000                            // WiFi start delay ceiling (10 minutes)
+
+#if OFFLINE_BUFFER_SIZE < UPLOAD_BATCH_SIZE
+#error "TCP_CLIENT_OFFLINE_BUFFER_SIZE must be at least TCP_CLIENT_UPLOAD_BATCH_SIZE"
+#endif
+
+/*
+ * Deep-Sleep Duty-Cycle Configuration
+ */
+#ifdef CONFIG_TCP_CLIENT_DUTY_CYCLE_MODE
+    #define DUTY_CYCLE_ENABLED          1
+    #define DUTY_CYCLE_WAKES_PER_FLUSH  CONFIG_TCP_CLIENT_DUTY_CYCLE_WAKES_PER_FLUSH
+    #define RTC_BUFFER_CAPACITY         CONFIG_TCP_CLIENT_RTC_BUFFER_CAPACITY
+#else
+    #define DUTY_CYCLE_ENABLED          0
+    #define DUTY_CYCLE_WAKES_PER_FLUSH  1
+    #define RTC_BUFFER_CAPACITY         8
+#endif
 
 /*
  * Sensor Configuration
@@ -61,6 +125,67 @@
 #define TEMP_SIMULATION_PERIOD     300.0f                            // 5 minute variation period
 #define TEMP_MIN_LIMIT             20.0f                             // Minimum realistic temperature
 #define TEMP_MAX_LIMIT             45.0f                             // Maximum realistic temperature
+#define TEMP_SIMULATION_NOISE      0.8f                              // Uniform noise half-width in °C
+
+// On-chip temperature sensor (replaces the simulation on targets that have one)
+#if defined(CONFIG_TCP_CLIENT_CHIP_TEMP_SENSOR) && !CONFIG_IDF_TARGET_LINUX
+    #define CHIP_TEMP_SENSOR_ENABLED  1
+    #define CHIP_TEMP_IDLE_MS         CONFIG_TCP_CLIENT_CHIP_TEMP_IDLE_MS
+#else
+    #define CHIP_TEMP_SENSOR_ENABLED  0
+    #define CHIP_TEMP_IDLE_MS         0
+#endif
+#define CHIP_TEMP_RANGE_MIN        -10                               // Expected range, selects calibration
+#define CHIP_TEMP_RANGE_MAX        80
+
+// Simulation micro-benchmark at startup
+#ifdef CONFIG_TCP_CLIENT_SIM_BENCHMARK
+    #define SIM_BENCHMARK_ENABLED  1
+#else
+    #define SIM_BENCHMARK_ENABLED  0
+#endif
+#define SIM_BENCHMARK_ITERATIONS   10000                             // Samples per timed loop
+
+// Background sampler (0 = sample once per transmission interval in the main loop)
+#define SAMPLER_RATE_HZ            CONFIG_TCP_CLIENT_SAMPLER_RATE_HZ
+#define SAMPLER_MAX_RATE_HZ        1000                              // Upper bound accepted by the sampler
+#define SAMPLER_RING_CAPACITY      CONFIG_TCP_CLIENT_SAMPLER_RING_SIZE // Records in the sampler ring
+#define SAMPLER_DRAIN_CHUNK        32                                // Records drained per bulk read
+
+#if (SAMPLER_RING_CAPACITY & (SAMPLER_RING_CAPACITY - 1)) != 0
+#error "TCP_CLIENT_SAMPLER_RING_SIZE must be a power of two"
+#endif
+
+// Windowed aggregation (upload one summary per window instead of raw samples)
+#ifdef CONFIG_TCP_CLIENT_AGGREGATION
+    #define AGGREGATION_ENABLED    1
+    #define AGG_WINDOW_SEC         CONFIG_TCP_CLIENT_AGG_WINDOW_SEC
+    #define AGG_HOP_SEC            CONFIG_TCP_CLIENT_AGG_HOP_SEC
+#else
+    #define AGGREGATION_ENABLED    0
+    #define AGG_WINDOW_SEC         60
+    #define AGG_HOP_SEC            60
+#endif
+#define AGG_MAX_PANES              12                                // Sliding window panes (window / hop)
+#define AGG_SKETCH_CENTROIDS       16                                // Percentile sketch size per sensor
+#define AGG_OUTPUT_QUEUE_LEN       4                                 // Summaries waiting to be taken
+
+// Report-by-exception filter (deadbands in sensor units, heartbeat in seconds)
+#ifdef CONFIG_TCP_CLIENT_REPORT_FILTER
+    #define REPORT_FILTER_ENABLED  1
+    #define REPORT_DEADBAND_ABS    (CONFIG_TCP_CLIENT_DEADBAND_ABS_MILLI / 1000.0f)
+    #define REPORT_DEADBAND_REL    (CONFIG_TCP_CLIENT_DEADBAND_REL_PERMILLE / 1000.0f)
+    #define REPORT_HEARTBEAT_SEC   CONFIG_TCP_CLIENT_REPORT_HEARTBEAT_SEC
+#else
+    #define REPORT_FILTER_ENABLED  0
+    #define REPORT_DEADBAND_ABS    0.0f
+    #define REPORT_DEADBAND_REL    0.0f
+    #define REPORT_HEARTBEAT_SEC   0
+#endif
+
+#if (AGG_WINDOW_SEC % AGG_HOP_SEC) != 0 || (AGG_WINDOW_SEC / AGG_HOP_SEC) > AGG_MAX_PANES
+#error "TCP_CLIENT_AGG_WINDOW_SEC must be a multiple of TCP_CLIENT_AGG_HOP_SEC, at most 12 hops"
+#endif
 
 /*
  * System Configuration
@@ -80,6 +205,57 @@
  */
 #define TASK_STACK_SIZE           4096                               // Default task stack size
 #define EVENT_QUEUE_SIZE          10                                 // Event queue depth
+#define BOOT_TASK_PRIORITY        5                                  // Priority of concurrent init tasks
+#define SAMPLER_TASK_PRIORITY     6                                  // Above the main loop so sampling is not delayed by I/O
+
+// Task CPU and stack profiler
+#ifdef CONFIG_TCP_CLIENT_TASK_PROFILER
+    #define TASK_PROFILER_ENABLED      1
+    #define TASK_PROFILER_INTERVAL_MS  (CONFIG_TCP_CLIENT_TASK_PROFILER_INTERVAL_SEC * 1000)
+#else
+    #define TASK_PROFILER_ENABLED      0
+    #define TASK_PROFILER_INTERVAL_MS  10000
+#endif
+#ifdef CONFIG_TCP_CLIENT_TASK_PROFILE_UPLOAD
+    #define TASK_PROFILE_UPLOAD        1
+#else
+    #define TASK_PROFILE_UPLOAD        0
+#endif
+
+// Self-telemetry block on every Nth upload (see health_report.h)
+#ifdef CONFIG_TCP_CLIENT_HEALTH_UPLOAD
+    #define HEALTH_UPLOAD_ENABLED      1
+    #define HEALTH_UPLOAD_INTERVAL     CONFIG_TCP_CLIENT_HEALTH_UPLOAD_INTERVAL
+#else
+    #define HEALTH_UPLOAD_ENABLED      0
+    #define HEALTH_UPLOAD_INTERVAL     10
+#endif
+
+// Per-state current model for energy accounting (see energy_model.h)
+#ifdef CONFIG_TCP_CLIENT_ENERGY_MODEL
+    #define ENERGY_MODEL_ENABLED       1
+    #define ENERGY_SUPPLY_MV           CONFIG_TCP_CLIENT_ENERGY_SUPPLY_MV
+    #define ENERGY_RADIO_ACTIVE_UA     CONFIG_TCP_CLIENT_ENERGY_RADIO_ACTIVE_UA
+    #define ENERGY_RADIO_LISTEN_UA     CONFIG_TCP_CLIENT_ENERGY_RADIO_LISTEN_UA
+    #define ENERGY_CPU_ACTIVE_UA       CONFIG_TCP_CLIENT_ENERGY_CPU_ACTIVE_UA
+    #define ENERGY_LIGHT_SLEEP_UA      CONFIG_TCP_CLIENT_ENERGY_LIGHT_SLEEP_UA
+    #define ENERGY_DEEP_SLEEP_UA       CONFIG_TCP_CLIENT_ENERGY_DEEP_SLEEP_UA
+#else
+    #define ENERGY_MODEL_ENABLED       0
+    #define ENERGY_SUPPLY_MV           3300
+    #define ENERGY_RADIO_ACTIVE_UA     180000
+    #define ENERGY_RADIO_LISTEN_UA     100000
+    #define ENERGY_CPU_ACTIVE_UA       30000
+    #define ENERGY_LIGHT_SLEEP_UA      800
+    #define ENERGY_DEEP_SLEEP_UA       10
+#endif
+
+// Idle CPU time is spent in automatic light sleep (power management with tickless idle)
+#if defined(CONFIG_PM_ENABLE) && defined(CONFIG_FREERTOS_USE_TICKLESS_IDLE)
+    #define ENERGY_IDLE_LIGHT_SLEEP    1
+#else
+    #define ENERGY_IDLE_LIGHT_SLEEP    0
+#endif
 
 /*
  * Development & Debugging
@@ -92,12 +268,94 @@
     #define VERBOSE_LOGGING        0
 #endif
 
+// Deferred logging (see deferred_log.h)
+#ifdef CONFIG_TCP_CLIENT_DEFERRED_LOG
+    #define DEFERRED_LOG_ENABLED   1
+    #define DEFERRED_LOG_QUEUE_LEN CONFIG_TCP_CLIENT_DEFERRED_LOG_QUEUE_LEN
+#else
+    #define DEFERRED_LOG_ENABLED   0
+    #define DEFERRED_LOG_QUEUE_LEN 1
+#endif
+#define DEFERRED_LOG_TASK_PRIORITY 1                                 // Just above idle
+
+// Prometheus metrics endpoint (see metrics_server.h)
+#ifdef CONFIG_TCP_CLIENT_METRICS_SERVER
+    #define METRICS_SERVER_ENABLED 1
+    #define METRICS_SERVER_PORT    CONFIG_TCP_CLIENT_METRICS_SERVER_PORT
+#else
+    #define METRICS_SERVER_ENABLED 0
+    #define METRICS_SERVER_PORT    9100
+#endif
+#define METRICS_CHUNK_SIZE         512                               // Response rendered in chunks of this size
+#define METRICS_SERVER_MAX_SOCKETS 3                                 // Concurrent scrape connections
+#define METRICS_SERVER_TASK_PRIORITY 2                               // Below the sampler and boot tasks
+
+// Binary event trace (see trace.h)
+#ifdef CONFIG_TCP_CLIENT_TRACE
+    #define TRACE_ENABLED          1
+    #define TRACE_BUFFER_EVENTS    CONFIG_TCP_CLIENT_TRACE_EVENTS
+#else
+    #define TRACE_ENABLED          0
+    #define TRACE_BUFFER_EVENTS    1                                 // No ring
+#endif
+#ifdef CONFIG_TCP_CLIENT_TRACE_OUTPUT_SERIAL
+    #define TRACE_DUMP_SERIAL      1
+#else
+    #define TRACE_DUMP_SERIAL      0
+#endif
+#ifdef CONFIG_TCP_CLIENT_TRACE_OUTPUT_UPLOAD
+    #define TRACE_UPLOAD_ENABLED   1
+    #define TRACE_UPLOAD_URL       CONFIG_TCP_CLIENT_TRACE_UPLOAD_URL
+#else
+    #define TRACE_UPLOAD_ENABLED   0
+    #define TRACE_UPLOAD_URL       ""
+#endif
+#define TRACE_CONTENT_TYPE         "application/octet-stream"
+
+#if (TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) != 0
+#error "TCP_CLIENT_TRACE_EVENTS must be a power of two"
+#endif
+
 /*
  * Hardware Configuration
- * (Ready for future GPIO sensor expansion)
  */
-#define ADC_WIDTH                  ADC_WIDTH_BIT_12
-#define ADC_ATTEN                  ADC_ATTEN_DB_0
+#define ADC_WIDTH                  ADC_BITWIDTH_12
+#define ADC_ATTEN                  ADC_ATTEN_DB_12
+#define ADC_FULL_SCALE_MV          3100                              // Nominal range at ADC_ATTEN (uncalibrated)
+
+// Continuous ADC pipeline (analog input via DMA, block processing)
+#ifdef CONFIG_TCP_CLIENT_ADC_PIPELINE
+    #define ADC_PIPELINE_ENABLED   1
+    #define ADC_CHANNEL            CONFIG_TCP_CLIENT_ADC_CHANNEL
+    #define ADC_SAMPLE_RATE_HZ     CONFIG_TCP_CLIENT_ADC_SAMPLE_RATE_HZ
+    #define ADC_DECIMATION         CONFIG_TCP_CLIENT_ADC_DECIMATION
+#else
+    #define ADC_PIPELINE_ENABLED   0
+    #define ADC_CHANNEL            0
+    #define ADC_SAMPLE_RATE_HZ     20000
+    #define ADC_DECIMATION         100
+#endif
+#if CONFIG_IDF_TARGET_LINUX || defined(CONFIG_TCP_CLIENT_ADC_SYNTHETIC)
+    #define ADC_SYNTHETIC_SOURCE   1                                 // Generated blocks instead of the ADC
+#else
+    #define ADC_SYNTHETIC_SOURCE   0
+#endif
+#define ADC_FRAME_SAMPLES          256                               // Conversions per processed block
+#define ADC_TASK_PRIORITY          5                                 // Below the sensor sampler
+#define ADC_LOWPASS_RATIO          0.4f                              // Anti-alias cutoff as fraction of output rate
+#define ADC_LOWPASS_Q              0.707f                            // Butterworth response
+
+// DSP kernels: esp-dsp (SIMD on ESP32-S3) or portable C
+#ifdef CONFIG_TCP_CLIENT_DSP_ESP_DSP
+    #define DSP_USE_ESP_DSP        1
+#else
+    #define DSP_USE_ESP_DSP        0
+#endif
+#ifdef CONFIG_TCP_CLIENT_DSP_SELF_CHECK
+    #define DSP_SELF_CHECK_ENABLED 1
+#else
+    #define DSP_SELF_CHECK_ENABLED 0
+#endif
 
 /*
  * JSON Field Names
@@ -105,8 +363,16 @@
  */
 #define JSON_FIELD_CPU_TEMP        "cpu_temp"
 #define JSON_FIELD_UPTIME          "sys_uptime"
-#define JSON_FIELD_TIMESTAMP       "timestamp"          // For future use
+#define JSON_FIELD_ANALOG          "analog_mv"          // Decimated analog input in millivolts
+#define JSON_FIELD_TIMESTAMP       "timestamp"          // Per-sample timestamp in batch uploads
 #define JSON_FIELD_DEVICE_ID       "device_id"          // For future use
+#define JSON_FIELD_SAMPLES         "samples"            // Array of samples in batch uploads
+#define JSON_FIELD_LINK            "link"               // Link quality summary object
+#define JSON_FIELD_BOOT            "boot"               // Boot stage timings object
+#define JSON_FIELD_TASKS           "tasks"              // Task CPU and stack profile object
+#define JSON_FIELD_HEALTH          "health"             // Self-telemetry object (counter deltas)
+#define JSON_FIELD_STATS           "stats"              // Per-sensor window statistics object
+#define JSON_FIELD_WINDOW          "window_s"           // Window length of the statistics
 
 /*
  * Utility Macros
@@ -0,0 +1,406 @@
+/*
+ * Deferred Log Implementation
+ * 
+ * The format string is walked twice: by the caller to pull the arguments
+ * off its va_list with their real types, and by the log task to format
+ * each conversion with snprintf() and the stored value. Literal text is
+ * copied as-is, so only the conversions themselves go through snprintf().
+ */
+
+#include "deferred_log.h"
+#include "config.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+// Capacity of one queue entry
+#define DLOG_MAX_ARGS              8                                 // Conversions per message
+#define DLOG_STRING_POOL           64                                // Bytes for copied %s arguments
+#define DLOG_SPEC_MAX              16                                // Longest conversion spec, e.g. "%-08.3lf"
+
+// Longest formatted message (longer ones are truncated)
+#define DLOG_LINE_MAX              192
+
+// Argument types, from a conversion's length modifier and specifier
+typedef enum {
+    ARG_INT = 0,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_SIZE,
+    ARG_INTMAX,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER,
+    ARG_UNSUPPORTED                      // '*' width, long double, %n, malformed
+} arg_kind_t;
+
+// One captured argument
+typedef union {
+    int i;
+    long l;
+    long long ll;
+    size_t z;
+    intmax_t j;
+    ptrdiff_t t;
+    double d;
+    const void *p;
+    uint16_t str;                        // Offset into the entry's string pool
+} dlog_arg_t;
+
+// Queued message
+typedef struct {
+    const char *tag;
+    const char *format;
+    uint32_t timestamp_ms;
+    uint8_t level;
+    uint8_t arg_count;
+    uint8_t pool_used;
+    dlog_arg_t args[DLOG_MAX_ARGS];
+    char pool[DLOG_STRING_POOL];
+} dlog_entry_t;
+
+// Module state management
+typedef struct {
+    bool started;
+    QueueHandle_t queue;
+    TaskHandle_t task;
+    _Atomic uint32_t deferred;
+    _Atomic uint32_t immediate;
+    _Atomic uint32_t dropped;
+    _Atomic uint32_t high_water;
+} deferred_log_context_t;
+
+// Global module context
+static deferred_log_context_t s_context;
+
+/*
+ * Internal function to find the next conversion
+ * 
+ * Returns a pointer to the '%' of the next conversion after p, or NULL.
+ * *end is set past the conversion and *kind to the argument it takes.
+ * "%%" is literal text and skipped.
+ */
+static const char *next_conversion(const char *p, const char **end, arg_kind_t *kind)
+{
+    while ((p = strchr(p, '%')) != NULL) {
+        const char *q = p + 1;
+        if (*q == '%') {
+            p = q + 1;
+            continue;
+        }
+        
+        arg_kind_t size_kind = ARG_INT;
+        bool supported = true;
+        
+        q += strspn(q, "-+ #0");
+        if (*q == '*') {
+            supported = false;
+            q++;
+        }
+        q += strspn(q, "0123456789");
+        if (*q == '.') {
+            q++;
+            if (*q == '*') {
+                supported = false;
+                q++;
+            }
+            q += strspn(q, "0123456789");
+        }
+        
+        switch (*q) {
+            case 'h':
+                q += (q[1] == 'h') ? 2 : 1;  // Promoted to int
+                break;
+            case 'l':
+                size_kind = (q[1] == 'l') ? ARG_LLONG : ARG_LONG;
+                q += (q[1] == 'l') ? 2 : 1;
+                break;
+            case 'z':
+                size_kind = ARG_SIZE;
+                q++;
+                break;
+            case 'j':
+                size_kind = ARG_INTMAX;
+                q++;
+                break;
+            case 't':
+                size_kind = ARG_PTRDIFF;
+                q++;
+                break;
+            case 'L':
+                supported = false;
+                q++;
+                break;
+            default:
+                break;
+        }
+        
+        switch (*q) {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                *kind = size_kind;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                *kind = ARG_DOUBLE;
+                break;
+            case 's':
+                *kind = (size_kind == ARG_INT) ? ARG_STRING : ARG_UNSUPPORTED;
+                break;
+            case 'p':
+                *kind = ARG_POINTER;
+                break;
+            default:
+                supported = false;
+                break;
+        }
+        
+        if (!supported) {
+            *kind = ARG_UNSUPPORTED;
+        }
+        *end = (*q != '\0') ? q + 1 : q;
+        return p;
+    }
+    
+    return NULL;
+}
+
+/*
+ * Internal function to pull the arguments of a message off the va_list
+ * 
+ * Returns false if the message cannot be deferred.
+ */
+static bool capture_args(dlog_entry_t *entry, va_list args)
+{
+    const char *p = entry->format;
+    const char *end;
+    arg_kind_t kind;
+    
+    while ((p = next_conversion(p, &end, &kind)) != NULL) {
+        if (kind == ARG_UNSUPPORTED || end - p >= DLOG_SPEC_MAX ||
+            entry->arg_count == DLOG_MAX_ARGS) {
+            return false;
+        }
+        
+        dlog_arg_t *arg = &entry->args[entry->arg_count++];
+        switch (kind) {
+            case ARG_INT:     arg->i = va_arg(args, int); break;
+            case ARG_LONG:    arg->l = va_arg(args, long); break;
+            case ARG_LLONG:   arg->ll = va_arg(args, long long); break;
+            case ARG_SIZE:    arg->z = va_arg(args, size_t); break;
+            case ARG_INTMAX:  arg->j = va_arg(args, intmax_t); break;
+            case ARG_PTRDIFF: arg->t = va_arg(args, ptrdiff_t); break;
+            case ARG_DOUBLE:  arg->d = va_arg(args, double); break;
+            case ARG_POINTER: arg->p = va_arg(args, const void *); break;
+            case ARG_STRING: {
+                const char *str = va_arg(args, const char *);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                size_t room = DLOG_STRING_POOL - entry->pool_used;
+                size_t len = strnlen(str, room);
+                if (len == room) {
+                    return false;  // Does not fit with its terminator
+                }
+                memcpy(entry->pool + entry->pool_used, str, len + 1);
+                arg->str = entry->pool_used;
+                entry->pool_used += len + 1;
+                break;
+            }
+            default:
+                return false;
+        }
+        p = end;
+    }
+    
+    return true;
+}
+
+/*
+ * Internal function to append literal format text ("%%" becomes '%')
+ */
+static size_t append_literal(char *out, size_t size, size_t used, const char *text, size_t len)
+{
+    for (size_t i = 0; i < len && used + 1 < size; i++) {
+        if (text[i] == '%' && i + 1 < len && text[i + 1] == '%') {
+            i++;
+        }
+        out[used++] = text[i];
+    }
+    out[used] = '\0';
+    
+    return used;
+}
+
+/*
+ * Internal function to format a captured message
+ */
+static void format_entry(const dlog_entry_t *entry, char *out, size_t size)
+{
+    const char *p = entry->format;
+    const char *conv;
+    const char *end;
+    arg_kind_t kind;
+    size_t used = 0;
+    int index = 0;
+    
+    out[0] = '\0';
+    while ((conv = next_conversion(p, &end, &kind)) != NULL) {
+        used = append_literal(out, size, used, p, (size_t)(conv - p));
+        
+        char spec[DLOG_SPEC_MAX];
+        memcpy(spec, conv, (size_t)(end - conv));
+        spec[end - conv] = '\0';
+        
+        const dlog_arg_t *arg = &entry->args[index++];
+        char *dst = out + used;
+        size_t room = size - used;
+        int written = 0;
+        switch (kind) {
+            case ARG_INT:     written = snprintf(dst, room, spec, arg->i); break;
+            case ARG_LONG:    written = snprintf(dst, room, spec, arg->l); break;
+            case ARG_LLONG:   written = snprintf(dst, room, spec, arg->ll); break;
+            case ARG_SIZE:    written = snprintf(dst, room, spec, arg->z); break;
+            case ARG_INTMAX:  written = snprintf(dst, room, spec, arg->j); break;
+            case ARG_PTRDIFF: written = snprintf(dst, room, spec, arg->t); break;
+            case ARG_DOUBLE:  written = snprintf(dst, room, spec, arg->d); break;
+            case ARG_POINTER: written = snprintf(dst, room, spec, arg->p); break;
+            case ARG_STRING:  written = snprintf(dst, room, spec, entry->pool + arg->str); break;
+            default:          break;
+        }
+        if (written > 0) {
+            used += ((size_t)written < room) ? (size_t)written : room - 1;
+        }
+        p = end;
+    }
+    
+    append_literal(out, size, used, p, strlen(p));
+}
+
+/*
+ * Internal function to write one line in the ESP_LOGx format
+ */
+static void write_line(esp_log_level_t level, const char *tag, uint32_t timestamp_ms, const char *message)
+{
+    static const char letters[] = "NEWIDV";
+    char letter = (level < sizeof(letters) - 1) ? letters[level] : '?';
+    
+    esp_log_write(level, tag, "%c (%lu) %s: %s\n", letter, (unsigned long)timestamp_ms, tag, message);
+}
+
+/*
+ * Deferred log task: formats and writes queued messages
+ */
+static void deferred_log_task(void *arg)
+{
+    // Only this task formats, so the buffers need not be on its stack
+    static dlog_entry_t entry;
+    static char line[DLOG_LINE_MAX];
+    
+    while (1) {
+        if (xQueueReceive(s_context.queue, &entry, portMAX_DELAY) == pdTRUE) {
+            format_entry(&entry, line, sizeof(line));
+            write_line(entry.level, entry.tag, entry.timestamp_ms, line);
+        }
+    }
+}
+
+/*
+ * Start Deferred Logging
+ */
+esp_err_t deferred_log_start(void)
+{
+    if (!DEFERRED_LOG_ENABLED || s_context.started) {
+        return ESP_OK;
+    }
+    
+    s_context.queue = xQueueCreate(DEFERRED_LOG_QUEUE_LEN, sizeof(dlog_entry_t));
+    if (s_context.queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    if (xTaskCreate(deferred_log_task, "deferred_log", TASK_STACK_SIZE, NULL,
+                    DEFERRED_LOG_TASK_PRIORITY, &s_context.task) != pdPASS) {
+        vQueueDelete(s_context.queue);
+        s_context.queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    s_context.started = true;
+    return ESP_OK;
+}
+
+/*
+ * Write Log Message
+ */
+void deferred_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    if (level > esp_log_level_get(tag)) {
+        return;
+    }
+    
+    uint32_t timestamp_ms = esp_log_timestamp();
+    va_list args;
+    va_start(args, format);
+    
+    if (s_context.started) {
+        dlog_entry_t entry = {
+            .tag = tag,
+            .format = format,
+            .timestamp_ms = timestamp_ms,
+            .level = (uint8_t)level,
+        };
+        
+        va_list captured;
+        va_copy(captured, args);
+        bool deferrable = capture_args(&entry, captured);
+        va_end(captured);
+        
+        if (deferrable) {
+            if (xQueueSend(s_context.queue, &entry, 0) != pdTRUE) {
+                atomic_fetch_add_explicit(&s_context.dropped, 1, memory_order_relaxed);
+            } else {
+                atomic_fetch_add_explicit(&s_context.deferred, 1, memory_order_relaxed);
+                // Several producers may raise the maximum at once
+                uint32_t waiting = uxQueueMessagesWaiting(s_context.queue);
+                uint32_t high = atomic_load_explicit(&s_context.high_water, memory_order_relaxed);
+                while (waiting > high &&
+                       !atomic_compare_exchange_weak_explicit(&s_context.high_water, &high, waiting,
+                                                              memory_order_relaxed,
+                                                              memory_order_relaxed)) {
+                }
+            }
+            va_end(args);
+            return;
+        }
+    }
+    
+    // Not started, or too many arguments for an entry: write now
+    char line[DLOG_LINE_MAX];
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    write_line(level, tag, timestamp_ms, line);
+    atomic_fetch_add_explicit(&s_context.immediate, 1, memory_order_relaxed);
+}
+
+/*
+ * Get Deferred Log Statistics
+ */
+void deferred_log_get_stats(deferred_log_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    stats->deferred = atomic_load_explicit(&s_context.deferred, memory_order_relaxed);
+    stats->immediate = atomic_load_explicit(&s_context.immediate, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&s_context.dropped, memory_order_relaxed);
+    stats->high_water = atomic_load_explicit(&s_context.high_water, memory_order_relaxed);
+    stats->queue_len = s_context.started ? DEFERRED_LOG_QUEUE_LEN : 0;
+}
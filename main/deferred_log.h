@@ -0,0 +1,104 @@
+/*
+ * Deferred Log Module
+ * 
+ * Logging backend for hot paths. DLOG_x() calls do not format anything:
+ * they capture the format string pointer, the raw arguments and a
+ * timestamp into a queue entry, and a low-priority task formats and
+ * writes the line later. The caller never waits for printf formatting or
+ * the UART; when the queue is full the message is dropped and counted
+ * rather than blocking.
+ * 
+ * Arguments are captured by walking the format string, so the usual
+ * printf conversions work (integers with any length modifier, floating
+ * point, %c, %p). Strings passed with %s are copied into the entry, so
+ * stack buffers are safe to log. Messages with more arguments than an
+ * entry holds, or with '*' widths, are written immediately instead.
+ * 
+ * Deferred lines carry the time they were logged, but may appear after
+ * synchronous ESP_LOGx output logged later. Before deferred_log_start()
+ * (and when TCP_CLIENT_DEFERRED_LOG is disabled) DLOG_x() writes
+ * synchronously. Not for use from ISRs.
+ * 
+ * Features:
+ * - No formatting or UART I/O on the calling task
+ * - Never blocks; drops are counted
+ * - Copies string arguments
+ * - Same "I (ms) TAG: message" line format as ESP_LOGx
+ * 
+ * Usage:
+ *   deferred_log_start();
+ * 
+ *   DLOG_I(TAG, "Sensor data - Temperature: %.1f°C, Uptime: %s",
+ *          data.cpu_temp, data.uptime);
+ * 
+ *   deferred_log_stats_t stats;
+ *   deferred_log_get_stats(&stats);
+ */
+
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include "esp_err.h"
+#include "esp_log.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Logging shorthands (same arguments as ESP_LOGx)
+#define DLOG_E(tag, format, ...)   deferred_log_write(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define DLOG_W(tag, format, ...)   deferred_log_write(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define DLOG_I(tag, format, ...)   deferred_log_write(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+#define DLOG_D(tag, format, ...)   deferred_log_write(ESP_LOG_DEBUG, tag, format, ##__VA_ARGS__)
+
+/*
+ * Deferred Log Statistics
+ */
+typedef struct {
+    uint32_t deferred;                   // Messages queued for the log task
+    uint32_t immediate;                  // Messages written on the calling task
+    uint32_t dropped;                    // Messages lost because the queue was full
+    uint32_t high_water;                 // Most messages waiting at once
+    uint32_t queue_len;                  // Queue capacity
+} deferred_log_stats_t;
+
+/*
+ * Start Deferred Logging
+ * 
+ * Creates the queue and the low-priority log task. Until this succeeds,
+ * DLOG_x() writes synchronously.
+ * 
+ * Returns:
+ *   ESP_OK: Deferred logging active (or disabled in menuconfig)
+ *   ESP_ERR_NO_MEM: Queue or task creation failed
+ */
+esp_err_t deferred_log_start(void);
+
+/*
+ * Write Log Message
+ * 
+ * Use through the DLOG_x() macros. The format string and tag must be
+ * string literals (or otherwise outlive the message).
+ * 
+ * Parameters:
+ *   level: Log level
+ *   tag: Log tag
+ *   format: printf format
+ */
+void deferred_log_write(esp_log_level_t level, const char *tag, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/*
+ * Get Deferred Log Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to deferred_log_stats_t structure to populate
+ */
+void deferred_log_get_stats(deferred_log_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEFERRED_LOG_H
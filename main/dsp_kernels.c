@@ -0,0 +1,467 @@
+/*
+ * DSP Kernels Implementation
+ * 
+ * The esp-dsp path keeps the library's own filter structures out of the
+ * public state: a fir_f32_t is rebuilt from dsp_fir_t for every call,
+ * which only costs a few stores per block.
+ */
+
+#include "dsp_kernels.h"
+#include "config.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+#if DSP_USE_ESP_DSP
+#include "esp_dsp.h"
+#endif
+
+// Module logging tag
+static const char *TAG = "DSP";
+
+// Self-check parameters
+#define CHECK_LEN              500
+#define CHECK_FIR_TAPS         32
+#define CHECK_FIR_DECIM        4
+#define CHECK_AVG_WINDOW       16
+#define CHECK_TOLERANCE        1e-4f
+
+// Self-check FIR buffers (aligned for the optimized routines)
+static DSP_ALIGN float s_check_coeffs[CHECK_FIR_TAPS];
+static DSP_ALIGN float s_check_delay[CHECK_FIR_TAPS];
+
+/*
+ * Get Active Backend Name
+ */
+const char *dsp_backend_name(void)
+{
+    return DSP_USE_ESP_DSP ? "esp-dsp" : "portable";
+}
+
+/*
+ * Design FIR Low-Pass Filter
+ */
+esp_err_t dsp_fir_design_lowpass(float *coeffs, uint16_t taps, float cutoff)
+{
+    if (!coeffs || taps == 0 || cutoff <= 0.0f || cutoff >= 0.5f) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    float center = (taps - 1) / 2.0f;
+    float sum = 0.0f;
+    for (uint16_t i = 0; i < taps; i++) {
+        float t = i - center;
+        float sinc = (t == 0.0f) ? 2.0f * cutoff : sinf(2.0f * (float)M_PI * cutoff * t) / ((float)M_PI * t);
+        float window = (taps > 1) ? 0.54f - 0.46f * cosf(2.0f * (float)M_PI * i / (taps - 1)) : 1.0f;
+        coeffs[i] = sinc * window;
+        sum += coeffs[i];
+    }
+    
+    // Unity gain at DC
+    for (uint16_t i = 0; i < taps; i++) {
+        coeffs[i] /= sum;
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Initialize FIR Filter
+ */
+esp_err_t dsp_fir_init(dsp_fir_t *fir, float *coeffs, float *delay, uint16_t taps, uint16_t decim)
+{
+    if (!fir || !coeffs || !delay || taps == 0 || decim == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    fir->coeffs = coeffs;
+    fir->delay = delay;
+    fir->taps = taps;
+    fir->decim = decim;
+    fir->pos = 0;
+
+#if DSP_USE_ESP_DSP
+    // Validates length and alignment for the optimized routine
+    fir_f32_t impl;
+    if (dsps_fird_init_f32(&impl, coeffs, delay, taps, decim) != ESP_OK) {
+        return ESP_ERR_INVALID_ARG;
+    }
+#endif
+    memset(delay, 0, taps * sizeof(float));
+    
+    return ESP_OK;
+}
+
+/*
+ * Run FIR Filter
+ */
+size_t dsp_fir_process(dsp_fir_t *fir, const float *in, float *out, size_t n)
+{
+    size_t outputs = n / fir->decim;
+
+#if DSP_USE_ESP_DSP
+    fir_f32_t impl = {
+        .coeffs = fir->coeffs,
+        .delay = fir->delay,
+        .N = fir->taps,
+        .pos = fir->pos,
+        .decim = fir->decim,
+    };
+    // len is the number of output samples (esp-dsp >= 1.4)
+    outputs = (size_t)dsps_fird_f32(&impl, in, out, (int)outputs);
+    fir->pos = (uint16_t)impl.pos;
+#else
+    const float *coeffs = fir->coeffs;
+    float *delay = fir->delay;
+    uint16_t taps = fir->taps;
+    uint16_t pos = fir->pos;
+    
+    for (size_t k = 0; k < outputs; k++) {
+        for (uint16_t d = 0; d < fir->decim; d++) {
+            delay[pos++] = *in++;
+            if (pos >= taps) {
+                pos = 0;
+            }
+        }
+        
+        // Oldest sample (at pos) first, in two contiguous runs
+        float acc = 0.0f;
+        uint16_t c = 0;
+        for (uint16_t i = pos; i < taps; i++) {
+            acc += coeffs[c++] * delay[i];
+        }
+        for (uint16_t i = 0; i < pos; i++) {
+            acc += coeffs[c++] * delay[i];
+        }
+        out[k] = acc;
+    }
+    
+    fir->pos = pos;
+#endif
+    
+    return outputs;
+}
+
+/*
+ * Configure Biquad Low-Pass Filter
+ */
+esp_err_t dsp_biquad_lowpass(dsp_biquad_t *biquad, float cutoff, float q)
+{
+    if (!biquad || cutoff <= 0.0f || cutoff >= 0.5f || q <= 0.0f) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    // RBJ cookbook low-pass, same formulas as dsps_biquad_gen_lpf_f32()
+    float w0 = 2.0f * (float)M_PI * cutoff;
+    float c = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float a0 = 1.0f + alpha;
+    
+    biquad->coeffs[0] = (1.0f - c) / 2.0f / a0;
+    biquad->coeffs[1] = (1.0f - c) / a0;
+    biquad->coeffs[2] = biquad->coeffs[0];
+    biquad->coeffs[3] = -2.0f * c / a0;
+    biquad->coeffs[4] = (1.0f - alpha) / a0;
+    biquad->w[0] = 0.0f;
+    biquad->w[1] = 0.0f;
+    
+    return ESP_OK;
+}
+
+/*
+ * Run Biquad Filter
+ */
+void dsp_biquad_process(dsp_biquad_t *biquad, const float *in, float *out, size_t n)
+{
+#if DSP_USE_ESP_DSP
+    dsps_biquad_f32(in, out, (int)n, biquad->coeffs, biquad->w);
+#else
+    const float *k = biquad->coeffs;
+    float w0 = biquad->w[0];
+    float w1 = biquad->w[1];
+    
+    for (size_t i = 0; i < n; i++) {
+        float d = in[i] - k[3] * w0 - k[4] * w1;
+        out[i] = k[0] * d + k[1] * w0 + k[2] * w1;
+        w1 = w0;
+        w0 = d;
+    }
+    
+    biquad->w[0] = w0;
+    biquad->w[1] = w1;
+#endif
+}
+
+/*
+ * Initialize Moving Average
+ */
+esp_err_t dsp_moving_avg_init(dsp_moving_avg_t *avg, float *history, uint16_t window)
+{
+    if (!avg || !history || window == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    avg->history = history;
+    avg->window = window;
+    avg->pos = 0;
+    avg->filled = 0;
+    avg->sum = 0.0f;
+    memset(history, 0, window * sizeof(float));
+    
+    return ESP_OK;
+}
+
+/*
+ * Run Moving Average
+ */
+void dsp_moving_avg_process(dsp_moving_avg_t *avg, const float *in, float *out, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        float x = in[i];
+        avg->sum += x - avg->history[avg->pos];
+        avg->history[avg->pos] = x;
+        if (++avg->pos >= avg->window) {
+            avg->pos = 0;
+        }
+        if (avg->filled < avg->window) {
+            avg->filled++;
+        }
+        out[i] = avg->sum / avg->filled;
+    }
+}
+
+/*
+ * Block Measurements
+ */
+float dsp_mean(const float *x, size_t n)
+{
+    if (n == 0) {
+        return 0.0f;
+    }
+    
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += x[i];
+    }
+    return sum / n;
+}
+
+float dsp_rms(const float *x, size_t n)
+{
+    if (n == 0) {
+        return 0.0f;
+    }
+    
+    float sum_sq = 0.0f;
+#if DSP_USE_ESP_DSP
+    dsps_dotprod_f32(x, x, &sum_sq, (int)n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        sum_sq += x[i] * x[i];
+    }
+#endif
+    return sqrtf(sum_sq / n);
+}
+
+float dsp_peak(const float *x, size_t n)
+{
+    float peak = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        float a = fabsf(x[i]);
+        if (a > peak) {
+            peak = a;
+        }
+    }
+    return peak;
+}
+
+void dsp_offset(float *x, size_t n, float value)
+{
+#if DSP_USE_ESP_DSP
+    dsps_addc_f32(x, x, (int)n, value, 1, 1);
+#else
+    for (size_t i = 0; i < n; i++) {
+        x[i] += value;
+    }
+#endif
+}
+
+/*
+ * int16 Kernels
+ */
+void dsp_i16_to_f32(const int16_t *in, float *out, size_t n, float scale)
+{
+    for (size_t i = 0; i < n; i++) {
+        out[i] = in[i] * scale;
+    }
+}
+
+float dsp_rms_i16(const int16_t *x, size_t n)
+{
+    if (n == 0) {
+        return 0.0f;
+    }
+    
+    int64_t sum_sq = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum_sq += (int32_t)x[i] * x[i];
+    }
+    return sqrtf((float)sum_sq / n);
+}
+
+int32_t dsp_peak_i16(const int16_t *x, size_t n)
+{
+    int32_t peak = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t a = x[i] < 0 ? -(int32_t)x[i] : x[i];
+        if (a > peak) {
+            peak = a;
+        }
+    }
+    return peak;
+}
+
+/*
+ * Internal function to record the relative error of one comparison
+ */
+static void track_error(float *worst, double actual, double expected, double scale)
+{
+    float error = (float)(fabs(actual - expected) / (scale > 0.0 ? scale : 1.0));
+    if (error > *worst) {
+        *worst = error;
+    }
+}
+
+/*
+ * Check Kernels Against Reference
+ */
+esp_err_t dsp_self_check(float *max_error)
+{
+    // Uneven chunks exercise state carried across blocks (FIR chunks are multiples of the decimation)
+    static const size_t fir_chunks[] = { 100, 36, 64, 200, 100 };
+    static const size_t chunks[] = { 1, 99, 250, 150 };
+    
+    float *x = malloc(CHECK_LEN * sizeof(float));
+    float *y = malloc(CHECK_LEN * sizeof(float));
+    int16_t *x16 = malloc(CHECK_LEN * sizeof(int16_t));
+    float *coeffs = s_check_coeffs;
+    float history[CHECK_AVG_WINDOW];
+    
+    if (!x || !y || !x16) {
+        free(x);
+        free(y);
+        free(x16);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    float worst = 0.0f;
+    
+    // Test signal: two tones plus a deterministic ripple
+    for (int i = 0; i < CHECK_LEN; i++) {
+        x[i] = sinf(2.0f * (float)M_PI * 0.01f * i) + 0.5f * sinf(2.0f * (float)M_PI * 0.23f * i) +
+               0.1f * ((float)((i * 7919) % 97) / 97.0f - 0.5f);
+        x16[i] = (int16_t)(x[i] * 10000.0f);
+    }
+    
+    // Decimating FIR
+    dsp_fir_t fir;
+    dsp_fir_design_lowpass(coeffs, CHECK_FIR_TAPS, 0.05f);
+    dsp_fir_init(&fir, coeffs, s_check_delay, CHECK_FIR_TAPS, CHECK_FIR_DECIM);
+    size_t produced = 0;
+    size_t consumed = 0;
+    for (size_t c = 0; c < ARRAY_SIZE(fir_chunks); c++) {
+        produced += dsp_fir_process(&fir, &x[consumed], &y[produced], fir_chunks[c]);
+        consumed += fir_chunks[c];
+    }
+    if (produced != CHECK_LEN / CHECK_FIR_DECIM) {
+        worst = INFINITY;
+    }
+    for (size_t k = 0; k < produced; k++) {
+        int newest = (int)((k + 1) * CHECK_FIR_DECIM) - 1;
+        double expected = 0.0;
+        for (int j = 0; j < CHECK_FIR_TAPS; j++) {
+            int idx = newest - CHECK_FIR_TAPS + 1 + j;
+            if (idx >= 0) {
+                expected += (double)coeffs[j] * x[idx];
+            }
+        }
+        track_error(&worst, y[k], expected, 1.5);
+    }
+    
+    // Biquad low-pass against direct form I in double precision
+    dsp_biquad_t biquad;
+    dsp_biquad_lowpass(&biquad, 0.05f, 0.707f);
+    consumed = 0;
+    for (size_t c = 0; c < ARRAY_SIZE(chunks); c++) {
+        dsp_biquad_process(&biquad, &x[consumed], &y[consumed], chunks[c]);
+        consumed += chunks[c];
+    }
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    const float *k = biquad.coeffs;
+    for (int i = 0; i < CHECK_LEN; i++) {
+        double out = k[0] * (double)x[i] + k[1] * x1 + k[2] * x2 - k[3] * y1 - k[4] * y2;
+        x2 = x1;
+        x1 = x[i];
+        y2 = y1;
+        y1 = out;
+        track_error(&worst, y[i], out, 1.5);
+    }
+    
+    // Moving average
+    dsp_moving_avg_t avg;
+    dsp_moving_avg_init(&avg, history, CHECK_AVG_WINDOW);
+    consumed = 0;
+    for (size_t c = 0; c < ARRAY_SIZE(chunks); c++) {
+        dsp_moving_avg_process(&avg, &x[consumed], &y[consumed], chunks[c]);
+        consumed += chunks[c];
+    }
+    for (int i = 0; i < CHECK_LEN; i++) {
+        int first = i - CHECK_AVG_WINDOW + 1 < 0 ? 0 : i - CHECK_AVG_WINDOW + 1;
+        double sum = 0.0;
+        for (int j = first; j <= i; j++) {
+            sum += x[j];
+        }
+        track_error(&worst, y[i], sum / (i - first + 1), 1.5);
+    }
+    
+    // Block measurements
+    double sum = 0.0, sum_sq = 0.0, peak = 0.0, sum_sq16 = 0.0, peak16 = 0.0;
+    for (int i = 0; i < CHECK_LEN; i++) {
+        sum += x[i];
+        sum_sq += (double)x[i] * x[i];
+        peak = fmax(peak, fabs(x[i]));
+        sum_sq16 += (double)x16[i] * x16[i];
+        peak16 = fmax(peak16, fabs((double)x16[i]));
+    }
+    track_error(&worst, dsp_mean(x, CHECK_LEN), sum / CHECK_LEN, 1.0);
+    track_error(&worst, dsp_rms(x, CHECK_LEN), sqrt(sum_sq / CHECK_LEN), 1.0);
+    track_error(&worst, dsp_peak(x, CHECK_LEN), peak, 1.0);
+    track_error(&worst, dsp_rms_i16(x16, CHECK_LEN), sqrt(sum_sq16 / CHECK_LEN), 10000.0);
+    track_error(&worst, dsp_peak_i16(x16, CHECK_LEN), peak16, 10000.0);
+    
+    memcpy(y, x, CHECK_LEN * sizeof(float));
+    dsp_offset(y, CHECK_LEN, -0.25f);
+    for (int i = 0; i < CHECK_LEN; i++) {
+        track_error(&worst, y[i], x[i] - 0.25, 1.5);
+    }
+    dsp_i16_to_f32(x16, y, CHECK_LEN, 1.0f / 10000.0f);
+    for (int i = 0; i < CHECK_LEN; i++) {
+        track_error(&worst, y[i], x16[i] / 10000.0, 1.5);
+    }
+    
+    free(x);
+    free(y);
+    free(x16);
+    
+    if (max_error) {
+        *max_error = worst;
+    }
+    
+    bool passed = worst <= CHECK_TOLERANCE;
+    ESP_LOGI(TAG, "Self-check (%s): max relative error %.2e, %s",
+             dsp_backend_name(), worst, passed ? "passed" : "FAILED");
+    return passed ? ESP_OK : ESP_FAIL;
+}
@@ -0,0 +1,234 @@
+/*
+ * DSP Kernels Module
+ * 
+ * Block filtering and measurement kernels for sampled signals, operating
+ * on contiguous float (or int16) arrays. Every kernel has a portable C
+ * implementation; on the ESP32 and ESP32-S3 the FIR, biquad and
+ * dot-product based kernels can use the esp-dsp library instead
+ * (DSP_USE_ESP_DSP), whose ESP32-S3 routines use the SIMD (PIE)
+ * instructions. Both paths share the same state layout and coefficient
+ * order, so filters can be switched without other changes.
+ * 
+ * dsp_self_check() runs the active kernels against straightforward double
+ * precision reference implementations, feeding data in uneven chunks so
+ * state carried between blocks is checked as well.
+ * 
+ * Buffers passed to the FIR kernels should be 16-byte aligned (DSP_ALIGN)
+ * and FIR lengths a multiple of 4, as required by the esp-dsp routines.
+ * 
+ * Features:
+ * - Decimating FIR filter and windowed-sinc low-pass design
+ * - Biquad (IIR) low-pass, direct form II
+ * - Moving average with running sum
+ * - Mean, RMS, peak and offset over a block
+ * - int16 conversion, RMS and peak
+ * 
+ * Usage:
+ *   static DSP_ALIGN float coeffs[32], delay[32];
+ *   dsp_fir_t fir;
+ *   dsp_fir_design_lowpass(coeffs, 32, 0.05f);
+ *   dsp_fir_init(&fir, coeffs, delay, 32, 4);
+ *   size_t produced = dsp_fir_process(&fir, block, decimated, block_len);
+ * 
+ *   dsp_biquad_t lowpass;
+ *   dsp_biquad_lowpass(&lowpass, 0.01f, 0.707f);
+ *   dsp_biquad_process(&lowpass, block, filtered, block_len);
+ *   float rms = dsp_rms(filtered, block_len);
+ */
+
+#ifndef DSP_KERNELS_H
+#define DSP_KERNELS_H
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment for FIR coefficient and delay buffers
+#define DSP_ALIGN                  __attribute__((aligned(16)))
+
+/*
+ * FIR Filter State
+ * 
+ * Coefficients are applied oldest sample first (esp-dsp order); symmetric
+ * (linear phase) designs are unaffected by the order.
+ */
+typedef struct {
+    float *coeffs;                       // taps coefficients (caller owned)
+    float *delay;                        // taps samples of history (caller owned)
+    uint16_t taps;
+    uint16_t decim;                      // Output one sample per decim inputs
+    uint16_t pos;                        // Next write position in delay
+} dsp_fir_t;
+
+/*
+ * Biquad Filter State
+ * 
+ * coeffs = { b0, b1, b2, a1, a2 } with a0 normalized to 1.
+ */
+typedef struct {
+    float coeffs[5];
+    float w[2];                          // Direct form II state
+} dsp_biquad_t;
+
+/*
+ * Moving Average State
+ */
+typedef struct {
+    float *history;                      // window samples (caller owned)
+    uint16_t window;
+    uint16_t pos;
+    uint16_t filled;
+    float sum;
+} dsp_moving_avg_t;
+
+/*
+ * Get Active Backend Name
+ * 
+ * Returns:
+ *   "esp-dsp" or "portable"
+ */
+const char *dsp_backend_name(void);
+
+/*
+ * Design FIR Low-Pass Filter
+ * 
+ * Windowed-sinc design (Hamming window) with unity DC gain.
+ * 
+ * Parameters:
+ *   coeffs: Output array of taps coefficients
+ *   taps: Filter length
+ *   cutoff: Cutoff frequency as fraction of the sample rate (0 < cutoff < 0.5)
+ * 
+ * Returns:
+ *   ESP_OK: Coefficients written
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, length or cutoff
+ */
+esp_err_t dsp_fir_design_lowpass(float *coeffs, uint16_t taps, float cutoff);
+
+/*
+ * Initialize FIR Filter
+ * 
+ * Parameters:
+ *   fir: Filter state to initialize
+ *   coeffs: taps coefficients, must stay valid while the filter is used
+ *   delay: taps floats of history, cleared here
+ *   taps: Filter length (multiple of 4)
+ *   decim: Decimation factor (1 = no decimation)
+ * 
+ * Returns:
+ *   ESP_OK: Filter ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, length or factor
+ */
+esp_err_t dsp_fir_init(dsp_fir_t *fir, float *coeffs, float *delay, uint16_t taps, uint16_t decim);
+
+/*
+ * Run FIR Filter
+ * 
+ * Parameters:
+ *   fir: Initialized filter
+ *   in: Input samples
+ *   out: Output samples (n / decim), may not alias in
+ *   n: Number of input samples (multiple of decim)
+ * 
+ * Returns:
+ *   Number of output samples written
+ */
+size_t dsp_fir_process(dsp_fir_t *fir, const float *in, float *out, size_t n);
+
+/*
+ * Configure Biquad Low-Pass Filter
+ * 
+ * Parameters:
+ *   biquad: Filter state to initialize (history cleared)
+ *   cutoff: Cutoff frequency as fraction of the sample rate (0 < cutoff < 0.5)
+ *   q: Quality factor (0.707 = Butterworth)
+ * 
+ * Returns:
+ *   ESP_OK: Filter ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, cutoff or q
+ */
+esp_err_t dsp_biquad_lowpass(dsp_biquad_t *biquad, float cutoff, float q);
+
+/*
+ * Run Biquad Filter
+ * 
+ * Parameters:
+ *   biquad: Configured filter
+ *   in: Input samples
+ *   out: Output samples, may alias in
+ *   n: Number of samples
+ */
+void dsp_biquad_process(dsp_biquad_t *biquad, const float *in, float *out, size_t n);
+
+/*
+ * Initialize Moving Average
+ * 
+ * Parameters:
+ *   avg: State to initialize
+ *   history: window floats of history
+ *   window: Averaging length
+ * 
+ * Returns:
+ *   ESP_OK: Ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer or zero window
+ */
+esp_err_t dsp_moving_avg_init(dsp_moving_avg_t *avg, float *history, uint16_t window);
+
+/*
+ * Run Moving Average
+ * 
+ * Until window samples have been seen, outputs average what is available.
+ * 
+ * Parameters:
+ *   avg: Initialized state
+ *   in: Input samples
+ *   out: Output samples, may alias in
+ *   n: Number of samples
+ */
+void dsp_moving_avg_process(dsp_moving_avg_t *avg, const float *in, float *out, size_t n);
+
+/*
+ * Block Measurements
+ * 
+ * dsp_mean: arithmetic mean
+ * dsp_rms: root mean square (including any DC part)
+ * dsp_peak: largest absolute value
+ * dsp_offset: adds value to every sample in place
+ */
+float dsp_mean(const float *x, size_t n);
+float dsp_rms(const float *x, size_t n);
+float dsp_peak(const float *x, size_t n);
+void dsp_offset(float *x, size_t n, float value);
+
+/*
+ * int16 Kernels
+ * 
+ * dsp_i16_to_f32: out[i] = in[i] * scale
+ * dsp_rms_i16 / dsp_peak_i16: as above, in input units
+ */
+void dsp_i16_to_f32(const int16_t *in, float *out, size_t n, float scale);
+float dsp_rms_i16(const int16_t *x, size_t n);
+int32_t dsp_peak_i16(const int16_t *x, size_t n);
+
+/*
+ * Check Kernels Against Reference
+ * 
+ * Parameters:
+ *   max_error: Largest relative deviation found (may be NULL)
+ * 
+ * Returns:
+ *   ESP_OK: All kernels within tolerance
+ *   ESP_FAIL: A kernel deviates from the reference
+ *   ESP_ERR_NO_MEM: Not enough memory for the test buffers
+ */
+esp_err_t dsp_self_check(float *max_error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DSP_KERNELS_H
@@ -0,0 +1,268 @@
+/*
+ * Deep-Sleep Duty-Cycle Implementation
+ * 
+ * Implements the RTC-memory sample ring buffer, wake scheduling and the
+ * deep-sleep entry used by the duty-cycle operating mode.
+ */
+
+#include "duty_cycle.h"
+#include "config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_sleep.h"
+#endif
+
+// Module logging tag
+static const char *TAG = "DUTY_CYCLE";
+
+// Marks RTC contents as valid (anything else means cold boot)
+#define DUTY_CYCLE_RTC_MAGIC       0x44435931u
+
+// Longest flush interval after repeated failures (DUTY_CYCLE_WAKES_PER_FLUSH << 4)
+#define DUTY_CYCLE_MAX_BACKOFF_SHIFT  4
+
+// Uptime is not stored per record, it is rebuilt from time_s
+#define DUTY_CYCLE_STORED_VALUES   (SENSOR_TYPE_MAX - 1)
+
+// Compact sample record kept in RTC memory instead of a full sensor_data_t
+typedef struct {
+    uint32_t time_s;                     // Seconds since first cold boot
+    sensor_value_t values[DUTY_CYCLE_STORED_VALUES];
+    uint16_t valid_mask;                 // Bit per sensor_type_t
+} duty_cycle_record_t;
+
+// State that must survive deep sleep
+typedef struct {
+    uint32_t magic;
+    uint32_t wake_count;
+    uint32_t flush_count;
+    uint32_t dropped;
+    uint32_t failed_flushes;             // Consecutive failed flushes, drives the backoff
+    uint32_t wakes_since_flush;          // Wakes since the last flush attempt
+    uint16_t head;                       // Index of oldest record
+    uint16_t count;                      // Number of stored records
+    uint64_t elapsed_us;                 // Time since cold boot, up to the start of this wake
+    duty_cycle_record_t records[RTC_BUFFER_CAPACITY];
+} duty_cycle_rtc_t;
+
+/*
+ * RTC memory backend
+ * 
+ * On the device the state lives in RTC slow memory. On the linux target
+ * a plain static variable simulates it; because simulated deep sleep
+ * returns to the caller, it behaves like RTC memory across wakes.
+ */
+#if CONFIG_IDF_TARGET_LINUX
+static duty_cycle_rtc_t s_rtc;
+#else
+static RTC_SLOW_ATTR duty_cycle_rtc_t s_rtc;
+#endif
+
+// Start of the current wake on the esp_timer time base
+static int64_t s_wake_start_time = 0;
+
+/*
+ * Internal function to map a sensor type to its slot in a record
+ */
+static size_t record_slot(sensor_type_t type)
+{
+    return (type < SENSOR_TYPE_UPTIME) ? type : type - 1;
+}
+
+/*
+ * Internal function to get the time since first cold boot
+ */
+static uint64_t elapsed_now_us(void)
+{
+    return s_rtc.elapsed_us + (uint64_t)(esp_timer_get_time() - s_wake_start_time);
+}
+
+/*
+ * Begin a Wake Cycle
+ */
+bool duty_cycle_begin_wake(void)
+{
+    s_wake_start_time = esp_timer_get_time();
+    
+    if (s_rtc.magic != DUTY_CYCLE_RTC_MAGIC) {
+        ESP_LOGI(TAG, "Cold boot, creating RTC sample buffer (%d samples)", RTC_BUFFER_CAPACITY);
+        memset(&s_rtc, 0, sizeof(s_rtc));
+        s_rtc.magic = DUTY_CYCLE_RTC_MAGIC;
+    }
+    
+    s_rtc.wake_count++;
+    s_rtc.wakes_since_flush++;
+    
+    // Back off exponentially while uploads keep failing
+    uint32_t shift = (s_rtc.failed_flushes < DUTY_CYCLE_MAX_BACKOFF_SHIFT) ?
+                     s_rtc.failed_flushes : DUTY_CYCLE_MAX_BACKOFF_SHIFT;
+    uint32_t interval = (uint32_t)DUTY_CYCLE_WAKES_PER_FLUSH << shift;
+    
+    // Flush on schedule, or early if the next sample would overwrite data.
+    // After a failure the ring simply overwrites the oldest samples, so the
+    // early flush is skipped until an upload succeeds again.
+    bool buffer_full = (s_rtc.count + 1 >= RTC_BUFFER_CAPACITY);
+    bool flush_due = (s_rtc.wakes_since_flush >= interval) ||
+                     (buffer_full && s_rtc.failed_flushes == 0);
+    
+    if (flush_due) {
+        s_rtc.wakes_since_flush = 0;
+    }
+    
+    ESP_LOGD(TAG, "Wake %lu, %u samples pending, flush interval %lu, flush %s",
+             (unsigned long)s_rtc.wake_count, s_rtc.count, (unsigned long)interval,
+             flush_due ? "due" : "not due");
+    
+    return flush_due;
+}
+
+/*
+ * Append Sample to RTC Buffer
+ */
+esp_err_t duty_cycle_append(const sensor_data_t *data)
+{
+    if (!data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (s_rtc.count == RTC_BUFFER_CAPACITY) {
+        // Overwrite oldest record
+        s_rtc.head = (s_rtc.head + 1) % RTC_BUFFER_CAPACITY;
+        s_rtc.count--;
+        s_rtc.dropped++;
+    }
+    
+    uint16_t index = (s_rtc.head + s_rtc.count) % RTC_BUFFER_CAPACITY;
+    duty_cycle_record_t *record = &s_rtc.records[index];
+    
+    record->time_s = (uint32_t)(elapsed_now_us() / 1000000);
+    record->valid_mask = (uint16_t)data->valid_mask;
+    for (size_t type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (type != SENSOR_TYPE_UPTIME) {
+            record->values[record_slot(type)] = data->values[type];
+        }
+    }
+    s_rtc.count++;
+    
+    return ESP_OK;
+}
+
+/*
+ * Get Number of Pending Samples
+ */
+size_t duty_cycle_pending(void)
+{
+    return s_rtc.count;
+}
+
+/*
+ * Read Oldest Pending Samples
+ */
+esp_err_t duty_cycle_peek(sensor_data_t *samples, size_t max_count, size_t *count)
+{
+    if (!samples || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    size_t n = (s_rtc.count < max_count) ? s_rtc.count : max_count;
+    
+    for (size_t i = 0; i < n; i++) {
+        const duty_cycle_record_t *record = &s_rtc.records[(s_rtc.head + i) % RTC_BUFFER_CAPACITY];
+        sensor_record_t expanded = {
+            .timestamp_us = (int64_t)record->time_s * 1000000,
+            .valid_mask = record->valid_mask,
+        };
+        
+        for (size_t type = 0; type < SENSOR_TYPE_MAX; type++) {
+            if (type != SENSOR_TYPE_UPTIME) {
+                expanded.values[type] = record->values[record_slot(type)];
+            }
+        }
+        // Uptime continues across deep sleep instead of restarting each wake
+        expanded.values[SENSOR_TYPE_UPTIME].u = record->time_s;
+        
+        sensor_service_record_to_data(&expanded, &samples[i]);
+    }
+    
+    *count = n;
+    return ESP_OK;
+}
+
+/*
+ * Remove Uploaded Samples
+ */
+esp_err_t duty_cycle_consume(size_t count)
+{
+    if (count > s_rtc.count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    s_rtc.head = (s_rtc.head + count) % RTC_BUFFER_CAPACITY;
+    s_rtc.count -= count;
+    s_rtc.flush_count++;
+    
+    return ESP_OK;
+}
+
+/*
+ * Report Flush Result
+ */
+void duty_cycle_flush_done(bool success)
+{
+    if (success) {
+        s_rtc.failed_flushes = 0;
+    } else if (s_rtc.failed_flushes < UINT32_MAX) {
+        s_rtc.failed_flushes++;
+        ESP_LOGW(TAG, "Flush failed %lu times in a row, backing off",
+                 (unsigned long)s_rtc.failed_flushes);
+    }
+}
+
+/*
+ * Enter Deep Sleep
+ */
+void duty_cycle_sleep(void)
+{
+    uint64_t sleep_us = (uint64_t)POST_INTERVAL_MS * 1000;
+    
+    // Account for this wake and the sleep ahead, since esp_timer restarts on wake
+    s_rtc.elapsed_us = elapsed_now_us() + sleep_us;
+    
+    ESP_LOGI(TAG, "Entering deep sleep for %d seconds (%u samples pending)",
+             POST_INTERVAL_SEC, s_rtc.count);
+
+#if CONFIG_IDF_TARGET_LINUX
+    // Simulated deep sleep: RTC state is kept in ordinary memory
+    vTaskDelay(MS_TO_TICKS(POST_INTERVAL_MS));
+#else
+    esp_sleep_enable_timer_wakeup(sleep_us);
+    esp_deep_sleep_start();
+#endif
+}
+
+/*
+ * Get Duty-Cycle Statistics
+ */
+esp_err_t duty_cycle_get_stats(duty_cycle_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    stats->wake_count = s_rtc.wake_count;
+    stats->pending_samples = s_rtc.count;
+    stats->dropped_samples = s_rtc.dropped;
+    stats->flush_count = s_rtc.flush_count;
+    stats->failed_flushes = s_rtc.failed_flushes;
+    stats->elapsed_us = elapsed_now_us();
+    
+    return ESP_OK;
+}
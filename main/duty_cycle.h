@@ -0,0 +1,161 @@
+/*
+ * Deep-Sleep Duty-Cycle Module
+ * 
+ * Keeps the device in deep sleep between samples for battery deployments.
+ * Each wake takes one sample and appends it to a ring buffer held in RTC
+ * slow memory, which survives deep sleep. WiFi is only brought up every
+ * DUTY_CYCLE_WAKES_PER_FLUSH wakes to upload the stored batch; while
+ * uploads keep failing the interval doubles up to a fixed limit.
+ * 
+ * Features:
+ * - Compact sample records stored in RTC slow memory
+ * - Wake counting and flush scheduling with exponential backoff
+ * - Time base that continues across deep-sleep cycles
+ * - Simulated RTC-memory backend on the linux (host) target
+ * 
+ * Usage:
+ *   bool flush_due = duty_cycle_begin_wake();
+ * 
+ *   sensor_data_t data;
+ *   if (sensor_service_read(&data) == ESP_OK) {
+ *       duty_cycle_append(&data);
+ *   }
+ * 
+ *   if (flush_due) {
+ *       // bring up WiFi, then duty_cycle_peek() / duty_cycle_consume()
+ *       duty_cycle_flush_done(uploaded);
+ *   }
+ * 
+ *   duty_cycle_sleep();  // does not return on the device
+ */
+
+#ifndef DUTY_CYCLE_H
+#define DUTY_CYCLE_H
+
+#include "esp_err.h"
+#include "sensor_service.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Duty-Cycle Statistics
+ */
+typedef struct {
+    uint32_t wake_count;                 // Wakes since the RTC buffer was created
+    uint32_t pending_samples;            // Samples waiting for upload
+    uint32_t dropped_samples;            // Samples overwritten because the buffer was full
+    uint32_t flush_count;                // Successful uploads
+    uint32_t failed_flushes;             // Consecutive failed flush wakes
+    uint64_t elapsed_us;                 // Time since first cold boot (including sleep)
+} duty_cycle_stats_t;
+
+/*
+ * Begin a Wake Cycle
+ * 
+ * Validates the RTC buffer (re-creating it after a cold boot) and counts
+ * this wake. Must be called once per boot before any other function.
+ * 
+ * Returns:
+ *   true: This wake should bring up WiFi and upload the stored batch
+ *   false: Sample-only wake, WiFi can be skipped
+ */
+bool duty_cycle_begin_wake(void);
+
+/*
+ * Append Sample to RTC Buffer
+ * 
+ * Stores the sensor values and valid mask of the sample in compact form;
+ * uptime is rebuilt from the duty-cycle time base. When the buffer is full
+ * the oldest sample is overwritten and counted as dropped.
+ * 
+ * Parameters:
+ *   data: Sensor sample to store
+ * 
+ * Returns:
+ *   ESP_OK: Sample stored
+ *   ESP_ERR_INVALID_ARG: Invalid data pointer
+ */
+esp_err_t duty_cycle_append(const sensor_data_t *data);
+
+/*
+ * Get Number of Pending Samples
+ * 
+ * Returns:
+ *   size_t: Samples stored in the RTC buffer
+ */
+size_t duty_cycle_pending(void);
+
+/*
+ * Read Oldest Pending Samples
+ * 
+ * Reconstructs up to max_count of the oldest stored samples without
+ * removing them. Timestamps and uptime strings are derived from the
+ * duty-cycle time base, so they stay continuous across deep sleep.
+ * 
+ * Parameters:
+ *   samples: Array to populate
+ *   max_count: Capacity of the array
+ *   count: Pointer to store the number of samples written
+ * 
+ * Returns:
+ *   ESP_OK: Samples read (count may be 0)
+ *   ESP_ERR_INVALID_ARG: Invalid parameters
+ */
+esp_err_t duty_cycle_peek(sensor_data_t *samples, size_t max_count, size_t *count);
+
+/*
+ * Remove Uploaded Samples
+ * 
+ * Drops the given number of oldest samples after a successful upload.
+ * 
+ * Parameters:
+ *   count: Number of samples to remove
+ * 
+ * Returns:
+ *   ESP_OK: Samples removed
+ *   ESP_ERR_INVALID_ARG: More samples than are pending
+ */
+esp_err_t duty_cycle_consume(size_t count);
+
+/*
+ * Report Flush Result
+ * 
+ * Must be called at the end of every flush wake. A failure lengthens the
+ * flush interval exponentially; a success restores the normal schedule.
+ * 
+ * Parameters:
+ *   success: true if the whole buffer was uploaded
+ */
+void duty_cycle_flush_done(bool success);
+
+/*
+ * Enter Deep Sleep
+ * 
+ * Sleeps for the transmission interval. On the device this function does
+ * not return; the next wake starts again from app_main(). On the linux
+ * target deep sleep is simulated with a task delay and the function
+ * returns so the caller can run the next wake.
+ */
+void duty_cycle_sleep(void);
+
+/*
+ * Get Duty-Cycle Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to duty_cycle_stats_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Statistics retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid stats pointer
+ */
+esp_err_t duty_cycle_get_stats(duty_cycle_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DUTY_CYCLE_H
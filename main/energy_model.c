@@ -0,0 +1,230 @@
+/*
+ * Energy Model Implementation
+ * 
+ * Each update takes the awake time since the previous update, charges
+ * the growth of the WiFi manager's burst and beacon-listen totals to the
+ * radio states, and splits the rest between CPU active and light sleep
+ * by the CPU load of the last task profiler window. Totals and the
+ * delivered sample count are kept in RTC memory; the per-boot reference
+ * points restart at zero with esp_timer on every wake.
+ */
+
+#include "energy_model.h"
+#include "config.h"
+#include "task_profiler.h"
+#include "wifi_manager.h"
+
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+// Marks RTC contents as valid (anything else means cold boot)
+#define ENERGY_RTC_MAGIC           0x454E5231u
+
+// Totals that must survive deep sleep
+typedef struct {
+    uint32_t magic;
+    uint32_t delivered_samples;
+    uint64_t time_us[ENERGY_STATE_MAX];
+} energy_rtc_t;
+
+// Module state management (reference points of the current wake)
+typedef struct {
+    int64_t last_update_us;              // esp_timer time of the previous update
+    uint64_t last_tx_us;                 // Radio burst total at the previous update
+    uint64_t last_listen_us;             // Beacon-listen total at the previous update
+} energy_model_context_t;
+
+/*
+ * RTC memory backend (see duty_cycle.c)
+ */
+#if CONFIG_IDF_TARGET_LINUX
+static energy_rtc_t s_rtc;
+#else
+static RTC_SLOW_ATTR energy_rtc_t s_rtc;
+#endif
+
+// Global module context
+static energy_model_context_t s_context;
+
+// Updated from the main task and the metrics server
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Current drawn in each state
+static const uint32_t s_state_current_ua[ENERGY_STATE_MAX] = {
+    [ENERGY_STATE_RADIO_ACTIVE] = ENERGY_RADIO_ACTIVE_UA,
+    [ENERGY_STATE_RADIO_LISTEN] = ENERGY_RADIO_LISTEN_UA,
+    [ENERGY_STATE_CPU_ACTIVE]   = ENERGY_CPU_ACTIVE_UA,
+    [ENERGY_STATE_LIGHT_SLEEP]  = ENERGY_LIGHT_SLEEP_UA,
+    [ENERGY_STATE_DEEP_SLEEP]   = ENERGY_DEEP_SLEEP_UA,
+};
+
+static const char *s_state_names[ENERGY_STATE_MAX] = {
+    [ENERGY_STATE_RADIO_ACTIVE] = "radio_active",
+    [ENERGY_STATE_RADIO_LISTEN] = "radio_listen",
+    [ENERGY_STATE_CPU_ACTIVE]   = "cpu_active",
+    [ENERGY_STATE_LIGHT_SLEEP]  = "light_sleep",
+    [ENERGY_STATE_DEEP_SLEEP]   = "deep_sleep",
+};
+
+/*
+ * Internal function to validate the RTC totals (caller holds s_lock)
+ */
+static void ensure_rtc(void)
+{
+    if (s_rtc.magic != ENERGY_RTC_MAGIC) {
+        memset(&s_rtc, 0, sizeof(s_rtc));
+        s_rtc.magic = ENERGY_RTC_MAGIC;
+    }
+}
+
+/*
+ * Internal function to take the part of a total not yet accounted
+ * 
+ * Inputs are read before the lock, so a concurrent update may already
+ * have accounted past 'now'; the reference point then stays put instead
+ * of moving back and counting the same time twice.
+ */
+static uint64_t take_delta(uint64_t now, uint64_t *last, uint64_t limit)
+{
+    if (now <= *last) {
+        return 0;
+    }
+    
+    uint64_t delta = now - *last;
+    *last = now;
+    return (delta < limit) ? delta : limit;
+}
+
+/*
+ * Account Elapsed Time
+ */
+void energy_model_update(void)
+{
+    // Inputs are read outside the lock; their owners take their own locks
+    wifi_radio_stats_t radio = {0};
+    wifi_manager_get_radio_stats(&radio);
+    
+    uint32_t idle_permille = 0;
+    if (ENERGY_IDLE_LIGHT_SLEEP) {
+        task_profile_t profile;
+        if (task_profiler_get_profile(&profile) == ESP_OK) {
+            idle_permille = 1000 - profile.cpu_load_permille;
+        }
+    }
+    
+    portENTER_CRITICAL(&s_lock);
+    ensure_rtc();
+    
+    int64_t now = esp_timer_get_time();
+    if (now > s_context.last_update_us) {
+        uint64_t awake_us = (uint64_t)(now - s_context.last_update_us);
+        s_context.last_update_us = now;
+        
+        uint64_t tx_us = take_delta(radio.tx_active_us, &s_context.last_tx_us, awake_us);
+        uint64_t listen_us = take_delta(radio.listen_us, &s_context.last_listen_us, awake_us - tx_us);
+        uint64_t cpu_us = awake_us - tx_us - listen_us;
+        uint64_t light_us = cpu_us * idle_permille / 1000;
+        
+        s_rtc.time_us[ENERGY_STATE_RADIO_ACTIVE] += tx_us;
+        s_rtc.time_us[ENERGY_STATE_RADIO_LISTEN] += listen_us;
+        s_rtc.time_us[ENERGY_STATE_CPU_ACTIVE] += cpu_us - light_us;
+        s_rtc.time_us[ENERGY_STATE_LIGHT_SLEEP] += light_us;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Count Delivered Samples
+ */
+void energy_model_add_delivered(uint32_t samples)
+{
+    portENTER_CRITICAL(&s_lock);
+    ensure_rtc();
+    s_rtc.delivered_samples += samples;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Account Deep Sleep
+ */
+void energy_model_enter_deep_sleep(uint64_t sleep_us)
+{
+    energy_model_update();
+    
+    portENTER_CRITICAL(&s_lock);
+    s_rtc.time_us[ENERGY_STATE_DEEP_SLEEP] += sleep_us;
+#if CONFIG_IDF_TARGET_LINUX
+    // Simulated sleep keeps esp_timer running; skip it on the next update
+    s_context.last_update_us = esp_timer_get_time() + (int64_t)sleep_us;
+#else
+    // esp_timer restarts at zero on wake
+    memset(&s_context, 0, sizeof(s_context));
+#endif
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Get Energy Report
+ */
+esp_err_t energy_model_get_report(energy_report_t *report)
+{
+    if (!report) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    energy_model_update();
+    
+    energy_rtc_t totals;
+    portENTER_CRITICAL(&s_lock);
+    totals = s_rtc;
+    portEXIT_CRITICAL(&s_lock);
+    
+    memset(report, 0, sizeof(*report));
+    uint64_t total_us = 0;
+    for (int state = 0; state < ENERGY_STATE_MAX; state++) {
+        // uA * mV * us = 1e-12 mJ
+        report->time_us[state] = totals.time_us[state];
+        report->energy_mj[state] = (float)((double)totals.time_us[state] *
+                                           s_state_current_ua[state] * ENERGY_SUPPLY_MV / 1e12);
+        report->total_mj += report->energy_mj[state];
+        total_us += totals.time_us[state];
+    }
+    
+    if (total_us > 0) {
+        // mJ / (mV * us) = 1e9 mA
+        report->average_ma = (float)(report->total_mj * 1e9 / ((double)total_us * ENERGY_SUPPLY_MV));
+    }
+    
+    report->delivered_samples = totals.delivered_samples;
+    if (totals.delivered_samples > 0) {
+        report->mj_per_sample = report->total_mj / totals.delivered_samples;
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Get Power State Name
+ */
+const char *energy_model_state_name(energy_state_t state)
+{
+    if ((unsigned)state >= ENERGY_STATE_MAX) {
+        return "unknown";
+    }
+    return s_state_names[state];
+}
+
+/*
+ * Reset Energy Totals
+ */
+void energy_model_reset(void)
+{
+    energy_model_update();
+    
+    portENTER_CRITICAL(&s_lock);
+    memset(s_rtc.time_us, 0, sizeof(s_rtc.time_us));
+    s_rtc.delivered_samples = 0;
+    portEXIT_CRITICAL(&s_lock);
+}
@@ -0,0 +1,127 @@
+/*
+ * Energy Model Module
+ * 
+ * Estimates the energy spent per delivered sample. Run time is split into
+ * power states from timestamps the firmware already takes: transmit
+ * bursts bracketed by the sender, beacon listening implied by the WiFi
+ * power-save policy, idle CPU time from the task profiler (light sleep
+ * when power management with tickless idle is enabled) and the planned
+ * deep-sleep time of the duty cycle. Each state is charged with its
+ * configured current at the supply voltage.
+ * 
+ * The totals live in RTC memory like the duty-cycle buffer, so the
+ * estimate covers sleep and sample-only wakes, and is divided by the
+ * number of samples the backend actually accepted.
+ * 
+ * Features:
+ * - Time per radio/CPU power state
+ * - Configurable per-state current model (Kconfig)
+ * - Energy per delivered sample and mean current
+ * - Totals kept across deep sleep
+ * 
+ * Usage:
+ *   if (http_client_post_sample_batch(&batch) == ESP_OK) {
+ *       energy_model_add_delivered(count);
+ *   }
+ * 
+ *   energy_report_t report;
+ *   energy_model_get_report(&report);
+ *   ESP_LOGI(TAG, "%.3f mJ/sample", report.mj_per_sample);
+ * 
+ *   energy_model_enter_deep_sleep(sleep_us);  // before esp_deep_sleep_start()
+ */
+
+#ifndef ENERGY_MODEL_H
+#define ENERGY_MODEL_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Power States
+ */
+typedef enum {
+    ENERGY_STATE_RADIO_ACTIVE = 0,       // Transmit/receive burst
+    ENERGY_STATE_RADIO_LISTEN,           // Radio awake for beacons between bursts
+    ENERGY_STATE_CPU_ACTIVE,             // CPU on, radio asleep or off (modem sleep)
+    ENERGY_STATE_LIGHT_SLEEP,            // Idle CPU in automatic light sleep
+    ENERGY_STATE_DEEP_SLEEP,             // Between duty-cycle wakes
+    ENERGY_STATE_MAX
+} energy_state_t;
+
+/*
+ * Energy Report
+ * 
+ * Totals since the first cold boot (or the last reset).
+ */
+typedef struct {
+    uint64_t time_us[ENERGY_STATE_MAX];  // Time spent in each state
+    float energy_mj[ENERGY_STATE_MAX];   // Energy charged to each state
+    float total_mj;                      // Sum over all states
+    float average_ma;                    // Mean current over the accounted time
+    uint32_t delivered_samples;          // Samples accepted by the backend
+    float mj_per_sample;                 // Energy per delivered sample (0 before the first)
+} energy_report_t;
+
+/*
+ * Account Elapsed Time
+ * 
+ * Splits the time since the previous update across the awake states.
+ * Called by the other functions; call it directly only to close an
+ * interval at a specific point.
+ */
+void energy_model_update(void);
+
+/*
+ * Count Delivered Samples
+ * 
+ * Parameters:
+ *   samples: Samples in an upload the backend accepted
+ */
+void energy_model_add_delivered(uint32_t samples);
+
+/*
+ * Account Deep Sleep
+ * 
+ * Closes the current wake and charges the planned sleep in advance,
+ * since nothing runs until the next wake.
+ * 
+ * Parameters:
+ *   sleep_us: Planned deep-sleep duration
+ */
+void energy_model_enter_deep_sleep(uint64_t sleep_us);
+
+/*
+ * Get Energy Report
+ * 
+ * Parameters:
+ *   report: Pointer to energy_report_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Report filled
+ *   ESP_ERR_INVALID_ARG: Invalid report pointer
+ */
+esp_err_t energy_model_get_report(energy_report_t *report);
+
+/*
+ * Get Power State Name
+ * 
+ * Returns:
+ *   Short lowercase name (e.g. "radio_active"), "unknown" if out of range
+ */
+const char *energy_model_state_name(energy_state_t state);
+
+/*
+ * Reset Energy Totals
+ */
+void energy_model_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENERGY_MODEL_H
@@ -0,0 +1,193 @@
+/*
+ * Health Report Implementation
+ * 
+ * Keeps two copies of the monotonic counters: the baseline (last
+ * delivered report) and the pending snapshot (last collected report).
+ * Gauges are read fresh on every collection and need no baseline.
+ */
+
+#include "health_report.h"
+#include "config.h"
+#include "http_client.h"
+#include "mem_stats.h"
+#include "sensor_service.h"
+#include "wifi_manager.h"
+
+#include <string.h>
+#include "esp_timer.h"
+
+// Monotonic counters a report is computed from
+typedef struct {
+    int64_t time_us;
+    uint32_t http_ok;
+    uint32_t http_failed;
+    uint32_t http_timeouts;
+    uint32_t http_network_errors;
+    uint64_t latency_sum_us;
+    uint32_t latency_buckets[HTTP_LATENCY_BUCKETS];
+    uint32_t sensor_reads;
+    uint32_t sensor_errors;
+    uint32_t sampler_records;
+    uint32_t sampler_overflows;
+    uint32_t wifi_disconnects;
+    uint32_t wifi_retries;
+    uint32_t tx_bursts;
+} health_counters_t;
+
+// Module state management
+typedef struct {
+    health_counters_t baseline;          // Counters of the last delivered report (zero at boot)
+    health_counters_t pending;           // Counters of the last collected report
+    bool pending_valid;
+} health_report_context_t;
+
+// Global module context
+static health_report_context_t s_context;
+
+// Latency histogram bucket bounds (see http_client.h)
+static const uint32_t s_latency_bounds_ms[HTTP_LATENCY_BUCKETS - 1] = HTTP_LATENCY_BOUNDS_MS;
+
+/*
+ * Internal function to compute a counter delta (restarting after a reset)
+ */
+static inline uint32_t delta(uint32_t now, uint32_t then)
+{
+    return (now >= then) ? now - then : now;
+}
+
+/*
+ * Internal function to find the latency bucket bound of a percentile
+ */
+static uint32_t latency_percentile_ms(const uint32_t buckets[HTTP_LATENCY_BUCKETS], uint32_t total,
+                                      uint32_t percent)
+{
+    if (total == 0) {
+        return 0;
+    }
+    
+    uint32_t rank = (uint32_t)(((uint64_t)total * percent + 99) / 100);
+    uint32_t cumulative = 0;
+    for (int i = 0; i < HTTP_LATENCY_BUCKETS - 1; i++) {
+        cumulative += buckets[i];
+        if (cumulative >= rank) {
+            return s_latency_bounds_ms[i];
+        }
+    }
+    
+    // Slower than the largest bound
+    return s_latency_bounds_ms[HTTP_LATENCY_BUCKETS - 2];
+}
+
+/*
+ * Internal function to read the current counters
+ */
+static void read_counters(health_counters_t *counters, http_client_stats_t *http,
+                          sensor_status_t *sensor, wifi_radio_stats_t *radio)
+{
+    memset(counters, 0, sizeof(*counters));
+    counters->time_us = esp_timer_get_time();
+    
+    if (http_client_get_stats(http) == ESP_OK) {
+        counters->http_ok = http->successful_requests;
+        counters->http_failed = http->failed_requests;
+        counters->http_timeouts = http->timeout_count;
+        counters->http_network_errors = http->network_errors;
+        counters->latency_sum_us = http->latency_sum_us;
+        memcpy(counters->latency_buckets, http->latency_buckets, sizeof(counters->latency_buckets));
+    }
+    
+    if (sensor_service_get_status(sensor) == ESP_OK) {
+        counters->sensor_reads = sensor->read_count;
+        counters->sensor_errors = sensor->error_count;
+        counters->sampler_records = sensor->sampler_records;
+        counters->sampler_overflows = sensor->sampler_overflows;
+    }
+    
+    // Read without resetting the window (uploads own it)
+    wifi_link_summary_t link;
+    if (wifi_manager_get_link_summary(&link, false) == ESP_OK) {
+        counters->wifi_disconnects = link.total_disconnects;
+        counters->wifi_retries = link.total_retries;
+    }
+    
+    if (wifi_manager_get_radio_stats(radio) == ESP_OK) {
+        counters->tx_bursts = radio->tx_bursts;
+    }
+}
+
+/*
+ * Collect Health Report
+ */
+esp_err_t health_report_collect(health_report_t *report)
+{
+    if (!report) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    http_client_stats_t http = {0};
+    sensor_status_t sensor = {0};
+    wifi_radio_stats_t radio = {0};
+    health_counters_t *now = &s_context.pending;
+    const health_counters_t *then = &s_context.baseline;
+    read_counters(now, &http, &sensor, &radio);
+    s_context.pending_valid = true;
+    
+    memset(report, 0, sizeof(*report));
+    report->interval_ms = (uint32_t)((now->time_us - then->time_us) / 1000);
+    
+    mem_stats_snapshot_t heap;
+    mem_stats_get_snapshot(&heap);
+    report->heap_free = heap.heap_free;
+    report->heap_min_free = heap.heap_min_free;
+    report->heap_largest_block = heap.heap_largest_block;
+    report->fragmentation_pct = heap.fragmentation_pct;
+    
+    report->http_ok = delta(now->http_ok, then->http_ok);
+    report->http_failed = delta(now->http_failed, then->http_failed);
+    report->http_timeouts = delta(now->http_timeouts, then->http_timeouts);
+    report->http_network_errors = delta(now->http_network_errors, then->http_network_errors);
+    report->http_last_status = http.last_status_code;
+    
+    uint32_t buckets[HTTP_LATENCY_BUCKETS];
+    uint32_t requests = 0;
+    for (int i = 0; i < HTTP_LATENCY_BUCKETS; i++) {
+        buckets[i] = delta(now->latency_buckets[i], then->latency_buckets[i]);
+        requests += buckets[i];
+    }
+    if (requests > 0) {
+        uint64_t sum_us = (now->latency_sum_us >= then->latency_sum_us) ?
+                          now->latency_sum_us - then->latency_sum_us : now->latency_sum_us;
+        report->http_latency_avg_ms = (uint32_t)(sum_us / requests / 1000);
+        report->http_latency_p90_ms = latency_percentile_ms(buckets, requests, 90);
+    }
+    
+    report->sensor_reads = delta(now->sensor_reads, then->sensor_reads);
+    report->sensor_errors = delta(now->sensor_errors, then->sensor_errors);
+    report->sampler_records = delta(now->sampler_records, then->sampler_records);
+    report->sampler_overflows = delta(now->sampler_overflows, then->sampler_overflows);
+    report->sampler_high_water = sensor.sampler_high_water;
+    
+    int8_t rssi;
+    if (wifi_manager_is_connected() && wifi_manager_get_rssi(&rssi) == ESP_OK) {
+        report->rssi = rssi;
+    }
+    report->wifi_disconnects = delta(now->wifi_disconnects, then->wifi_disconnects);
+    report->wifi_retries = delta(now->wifi_retries, then->wifi_retries);
+    report->tx_bursts = delta(now->tx_bursts, then->tx_bursts);
+    report->radio_on_ms_per_hour = radio.radio_on_ms_per_hour;
+    
+    return ESP_OK;
+}
+
+/*
+ * Commit Health Report
+ */
+void health_report_commit(void)
+{
+    if (!s_context.pending_valid) {
+        return;
+    }
+    
+    s_context.baseline = s_context.pending;
+    s_context.pending_valid = false;
+}
@@ -0,0 +1,114 @@
+/*
+ * Health Report Module
+ * 
+ * Builds the self-telemetry block that is piggy-backed on every Nth data
+ * upload. The block holds heap watermarks, current gauges (RSSI, radio
+ * duty) and the change of the HTTP client, sensor service and WiFi
+ * counters since the previous delivered block, so the backend can sum
+ * deltas across the fleet without tracking reboots or counter resets.
+ * 
+ * The baseline only moves when a block was delivered: a failed upload
+ * leaves it in place and the next block covers the whole interval.
+ * Counters that went backwards (statistics reset) restart from zero.
+ * 
+ * Upload encoding (JSON_FIELD_HEALTH, fixed-order arrays):
+ *   "health": {
+ *     "dt":   interval in seconds,
+ *     "heap": [free, min_free, largest_block, fragmentation_pct],
+ *     "http": [ok, failed, timeouts, net_errors, avg_ms, p90_ms, last_status],
+ *     "sens": [reads, errors, sampler_records, sampler_overflows, sampler_high_water],
+ *     "wifi": [rssi, disconnects, retries, tx_bursts, radio_on_ms_per_hour]
+ *   }
+ * 
+ * Features:
+ * - Deltas instead of absolute counters
+ * - Latency mean and 90th percentile from the request histogram
+ * - Baseline advances only on delivery
+ * 
+ * Usage:
+ *   health_report_t report;
+ *   health_report_collect(&report);
+ *   http_client_attach_health(&report);
+ *   if (http_client_post_sample_batch(&batch) == ESP_OK) {
+ *       health_report_commit();
+ *   }
+ */
+
+#ifndef HEALTH_REPORT_H
+#define HEALTH_REPORT_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Health Report
+ * 
+ * Counters (marked delta) cover interval_ms; everything else is the value
+ * at collection time.
+ */
+typedef struct {
+    uint32_t interval_ms;                // Time since the previous delivered report
+    
+    // Heap watermarks
+    uint32_t heap_free;                  // Free heap
+    uint32_t heap_min_free;              // Lowest free heap since boot
+    uint32_t heap_largest_block;         // Largest allocatable block
+    uint8_t fragmentation_pct;           // 100 - largest block / free heap
+    
+    // HTTP client
+    uint32_t http_ok;                    // Successful requests (delta)
+    uint32_t http_failed;                // Failed requests (delta)
+    uint32_t http_timeouts;              // Timeouts (delta)
+    uint32_t http_network_errors;        // Transport errors (delta)
+    uint32_t http_latency_avg_ms;        // Mean request duration (0 without requests)
+    uint32_t http_latency_p90_ms;        // Histogram bucket bound holding the 90th percentile
+    int http_last_status;                // Status code of the last response
+    
+    // Sensor service
+    uint32_t sensor_reads;               // Successful reads (delta)
+    uint32_t sensor_errors;              // Read errors (delta)
+    uint32_t sampler_records;            // Sampler records produced (delta)
+    uint32_t sampler_overflows;          // Sampler records dropped (delta)
+    uint32_t sampler_high_water;         // Largest sampler ring fill level seen
+    
+    // WiFi
+    int8_t rssi;                         // Signal strength in dBm (0 when not connected)
+    uint32_t wifi_disconnects;           // Disconnect events (delta)
+    uint32_t wifi_retries;               // Connection retries (delta)
+    uint32_t tx_bursts;                  // Transmit bursts (delta)
+    uint32_t radio_on_ms_per_hour;       // Estimated radio-on time per hour
+} health_report_t;
+
+/*
+ * Collect Health Report
+ * 
+ * Snapshots all statistics and computes deltas against the baseline of
+ * the last committed report (boot for the first one). The snapshot is
+ * kept until health_report_commit() or the next collection.
+ * 
+ * Parameters:
+ *   report: Pointer to health_report_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Report collected
+ *   ESP_ERR_INVALID_ARG: Invalid report pointer
+ */
+esp_err_t health_report_collect(health_report_t *report);
+
+/*
+ * Commit Health Report
+ * 
+ * Call once the last collected report was delivered; the next report
+ * starts from its snapshot.
+ */
+void health_report_commit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HEALTH_REPORT_H
@@ -7,11 +7,18 @@
 
 #include "http_client.h"
 #include "config.h"
+#include "arena.h"
+#include "mem_stats.h"
+#include "trace.h"
+#include "deferred_log.h"
+#include "stats_block.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
 #include "esp_log.h"
+#include "esp_system.h"
 #include "esp_http_client.h"
 #include "esp_timer.h"
 #include "cJSON.h"
@@ -19,22 +26,61 @@
 // Module logging tag
 static const char *TAG = "HTTP_CLIENT";
 
+// esp_http_client receive and transmit buffers (accounted to the module)
+#define HTTP_CLIENT_RX_BUFFER_SIZE 1024
+#define HTTP_CLIENT_TX_BUFFER_SIZE 1024
+
+// Trace events per upload; larger backlogs go out in several POSTs
+#define TRACE_UPLOAD_CHUNK_EVENTS  (TRACE_UPLOAD_ENABLED ? 64 : 1)
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    HTTP_STAT_TOTAL = 0,
+    HTTP_STAT_SUCCESS,
+    HTTP_STAT_FAILED,
+    HTTP_STAT_TIMEOUTS,
+    HTTP_STAT_NETWORK_ERRORS,
+    HTTP_STAT_LAST_STATUS,
+    HTTP_STAT_LAST_REQUEST_TIME,         // 64-bit (two slots)
+    HTTP_STAT_BYTES_SENT = HTTP_STAT_LAST_REQUEST_TIME + 2, // 64-bit
+    HTTP_STAT_LATENCY_SUM = HTTP_STAT_BYTES_SENT + 2,       // 64-bit
+    HTTP_STAT_LATENCY_BUCKET = HTTP_STAT_LATENCY_SUM + 2,   // HTTP_LATENCY_BUCKETS slots
+    HTTP_STAT_COUNT = HTTP_STAT_LATENCY_BUCKET + HTTP_LATENCY_BUCKETS
+} http_stat_t;
+
+// Updated from the requesting task and the HTTP event handler
+STATS_BLOCK_DEFINE(s_stats, HTTP_STAT_COUNT);
+
 // Module state management
 typedef struct {
     bool initialized;
-    http_client_stats_t stats;
     http_response_t last_response;
     char *response_buffer;               // Buffer for response data
     size_t response_buffer_size;         // Size of response buffer
+    wifi_link_summary_t link_summary;    // Link summary for next upload
+    bool link_summary_attached;          // Whether link_summary is pending
+    boot_timings_t boot_timings;         // Boot timings for next upload
+    bool boot_timings_attached;          // Whether boot_timings is pending
+    task_profile_t task_profile;         // Task profile for next upload
+    bool task_profile_attached;          // Whether task_profile is pending
+    health_report_t health;              // Health report for next upload
+    bool health_attached;                // Whether health is pending
+    esp_http_client_handle_t client;     // Reused for every request (created on first use)
+    size_t client_heap_bytes;            // Buffer sizes accounted for the client handle
+    arena_t request_arena;               // JSON trees, payloads and response parsing
 } http_client_context_t;
 
 // Global module context
 static http_client_context_t s_context = {
     .initialized = false,
-    .stats = {0},
     .last_response = {0},
     .response_buffer = NULL,
-    .response_buffer_size = 0
+    .response_buffer_size = 0,
+    .link_summary = {0},
+    .link_summary_attached = false,
+    .boot_timings_attached = false,
+    .task_profile_attached = false,
+    .health_attached = false
 };
 
 /*
@@ -46,23 +92,28 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
 {
     switch(evt->event_id) {
         case HTTP_EVENT_ERROR:
+            TRACE_INSTANT(TRACE_EV_HTTP_ERROR, 0, 0);
             ESP_LOGE(TAG, "HTTP Error occurred");
-            s_context.stats.network_errors++;
+            stats_inc(&s_stats, HTTP_STAT_NETWORK_ERRORS);
             break;
             
         case HTTP_EVENT_ON_CONNECTED:
+            TRACE_INSTANT(TRACE_EV_HTTP_CONNECTED, 0, 0);
             ESP_LOGD(TAG, "HTTP Connected to server");
             break;
             
         case HTTP_EVENT_HEADER_SENT:
+            TRACE_INSTANT(TRACE_EV_HTTP_HEADER_SENT, 0, 0);
             ESP_LOGD(TAG, "HTTP Headers sent");
             break;
             
         case HTTP_EVENT_ON_HEADER:
+            TRACE_INSTANT(TRACE_EV_HTTP_ON_HEADER, evt->data_len, 0);
             ESP_LOGD(TAG, "HTTP Header received: %.*s", evt->data_len, (char*)evt->data);
             break;
             
         case HTTP_EVENT_ON_DATA:
+            TRACE_INSTANT(TRACE_EV_HTTP_ON_DATA, evt->data_len, 0);
             ESP_LOGD(TAG, "HTTP Data received: %.*s", evt->data_len, (char*)evt->data);
             
             // Store response data if we have a buffer
@@ -80,10 +131,12 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
             break;
             
         case HTTP_EVENT_ON_FINISH:
+            TRACE_INSTANT(TRACE_EV_HTTP_FINISH, 0, 0);
             ESP_LOGD(TAG, "HTTP Request finished");
             break;
             
         case HTTP_EVENT_DISCONNECTED:
+            TRACE_INSTANT(TRACE_EV_HTTP_DISCONNECTED, 0, 0);
             ESP_LOGD(TAG, "HTTP Disconnected from server");
             break;
             
@@ -94,6 +147,84 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
     return ESP_OK;
 }
 
+// Latency histogram bucket bounds
+static const uint32_t s_latency_bounds_ms[HTTP_LATENCY_BUCKETS - 1] = HTTP_LATENCY_BOUNDS_MS;
+
+/*
+ * Internal function to count a completed request
+ * 
+ * One update group, so snapshots always see total == success + failed
+ * and a latency bucket for every request.
+ */
+static void record_request(size_t len, int64_t start_us, int64_t duration_us, int status_code,
+                           esp_err_t err)
+{
+    int bucket = 0;
+    while (bucket < HTTP_LATENCY_BUCKETS - 1 &&
+           duration_us > (int64_t)s_latency_bounds_ms[bucket] * 1000) {
+        bucket++;
+    }
+    
+    stats_update_begin(&s_stats);
+    stats_inc(&s_stats, HTTP_STAT_TOTAL);
+    stats_set64(&s_stats, HTTP_STAT_LAST_REQUEST_TIME, (uint64_t)start_us);
+    stats_add64(&s_stats, HTTP_STAT_BYTES_SENT, len);
+    stats_add64(&s_stats, HTTP_STAT_LATENCY_SUM, (uint64_t)duration_us);
+    stats_inc(&s_stats, HTTP_STAT_LATENCY_BUCKET + bucket);
+    if (err == ESP_OK) {
+        stats_set(&s_stats, HTTP_STAT_LAST_STATUS, (uint32_t)status_code);
+    }
+    if (err == ESP_OK && status_code >= 200 && status_code < 300) {
+        stats_inc(&s_stats, HTTP_STAT_SUCCESS);
+    } else {
+        stats_inc(&s_stats, HTTP_STAT_FAILED);
+        if (err == ESP_ERR_TIMEOUT) {
+            stats_inc(&s_stats, HTTP_STAT_TIMEOUTS);
+        } else if (err != ESP_OK) {
+            stats_inc(&s_stats, HTTP_STAT_NETWORK_ERRORS);
+        }
+    }
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Internal function to count a request that failed before it was sent
+ * 
+ * Same group rule as record_request(): total and failed move together.
+ */
+static void record_local_failure(void)
+{
+    stats_update_begin(&s_stats);
+    stats_inc(&s_stats, HTTP_STAT_TOTAL);
+    stats_inc(&s_stats, HTTP_STAT_FAILED);
+    stats_update_end(&s_stats);
+}
+
+// Request arena storage
+static uint8_t s_request_arena_storage[REQUEST_ARENA_SIZE] ARENA_ALIGN;
+
+/*
+ * Internal cJSON allocation hooks
+ * 
+ * cJSON memory comes from the request arena, which rewinds once the tree
+ * and the printed payload of a request are released. Requests that do
+ * not fit fall back to the heap (accounted to the JSON encoder).
+ */
+static void *json_malloc(size_t size)
+{
+    void *ptr = arena_alloc(&s_context.request_arena, size);
+    return ptr ? ptr : mem_stats_malloc(MEM_MODULE_JSON, size);
+}
+
+static void json_free(void *ptr)
+{
+    if (arena_owns(&s_context.request_arena, ptr)) {
+        arena_release(&s_context.request_arena, ptr);
+    } else {
+        mem_stats_free(MEM_MODULE_JSON, ptr);
+    }
+}
+
 /*
  * Initialize HTTP Client
  */
@@ -108,15 +239,22 @@ esp_err_t http_client_init(void)
     
     // Allocate response buffer
     s_context.response_buffer_size = 512;  // 512 bytes for response data
-    s_context.response_buffer = malloc(s_context.response_buffer_size);
+    s_context.response_buffer = mem_stats_malloc(MEM_MODULE_HTTP_CLIENT, s_context.response_buffer_size);
     if (!s_context.response_buffer) {
         ESP_LOGE(TAG, "Failed to allocate response buffer");
         return ESP_ERR_NO_MEM;
     }
     
+    // Serve cJSON trees and printed payloads from the request arena
+    arena_init(&s_context.request_arena, s_request_arena_storage, sizeof(s_request_arena_storage));
+    cJSON_Hooks hooks = {
+        .malloc_fn = json_malloc,
+        .free_fn = json_free,
+    };
+    cJSON_InitHooks(&hooks);
+    
     // Initialize statistics
-    memset(&s_context.stats, 0, sizeof(s_context.stats));
-    s_context.stats.initialized = true;
+    stats_reset(&s_stats);
     
     // Initialize last response
     memset(&s_context.last_response, 0, sizeof(s_context.last_response));
@@ -130,6 +268,317 @@ esp_err_t http_client_init(void)
     return ESP_OK;
 }
 
+/*
+ * Internal function to drop digits a sensor cannot resolve
+ */
+static double round_to_decimals(double value, uint8_t decimals)
+{
+    static const double scale[] = { 1.0, 10.0, 100.0, 1000.0, 10000.0 };
+    double factor = scale[decimals < ARRAY_SIZE(scale) ? decimals : ARRAY_SIZE(scale) - 1];
+    return round(value * factor) / factor;
+}
+
+/*
+ * Internal function to add the statistics of one sensor to a stats object
+ */
+static bool add_stats_item(cJSON *stats_obj, const sensor_driver_t *driver, const sensor_stats_t *stats)
+{
+    uint8_t decimals = driver->decimals + 1;   // One extra digit for derived values
+    cJSON *item = cJSON_AddObjectToObject(stats_obj, driver->json_field);
+    if (item == NULL ||
+        !cJSON_AddNumberToObject(item, "n", stats->count) ||
+        !cJSON_AddNumberToObject(item, "min", round_to_decimals(stats->min, decimals)) ||
+        !cJSON_AddNumberToObject(item, "max", round_to_decimals(stats->max, decimals)) ||
+        !cJSON_AddNumberToObject(item, "mean", round_to_decimals(stats->mean, decimals)) ||
+        !cJSON_AddNumberToObject(item, "sd", round_to_decimals(stats->stddev, decimals)) ||
+        !cJSON_AddNumberToObject(item, "p50", round_to_decimals(stats->p50, decimals)) ||
+        !cJSON_AddNumberToObject(item, "p90", round_to_decimals(stats->p90, decimals)) ||
+        !cJSON_AddNumberToObject(item, "p99", round_to_decimals(stats->p99, decimals))) {
+        ESP_LOGE(TAG, "Failed to create %s stats JSON item", driver->json_field);
+        return false;
+    }
+    
+    return true;
+}
+
+/*
+ * Internal function to add window statistics of an aggregated sample
+ * 
+ * Adds {"stats": {"<field>": {"n", "min", "max", "mean", "sd", "p50",
+ * "p90", "p99"}}, "window_s": ...}; the sensor fields carry the means.
+ * stats[type] is only read for types with their bit set in stats_mask.
+ */
+static bool add_sensor_stats(cJSON *json, const sensor_driver_t *const drivers[SENSOR_TYPE_MAX],
+                             const sensor_stats_t *const stats[SENSOR_TYPE_MAX],
+                             uint32_t stats_mask, uint32_t window_ms)
+{
+    cJSON *stats_obj = cJSON_AddObjectToObject(json, JSON_FIELD_STATS);
+    if (stats_obj == NULL) {
+        ESP_LOGE(TAG, "Failed to create stats JSON object");
+        return false;
+    }
+    
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (drivers[type] && (stats_mask & (1u << type)) &&
+            !add_stats_item(stats_obj, drivers[type], stats[type])) {
+            return false;
+        }
+    }
+    
+    if (!cJSON_AddNumberToObject(json, JSON_FIELD_WINDOW, window_ms / 1000.0)) {
+        ESP_LOGE(TAG, "Failed to create window JSON item");
+        return false;
+    }
+    
+    return true;
+}
+
+/*
+ * Internal function to add one sensor reading to a JSON object
+ */
+static bool add_sensor_value(cJSON *json, const sensor_driver_t *driver, const sensor_value_t *value)
+{
+    cJSON *item = NULL;
+    
+    if (driver->encoding == SENSOR_ENCODING_DURATION) {
+        char duration[UPTIME_STRING_MAX_LEN];
+        if (sensor_service_format_duration(value->u, duration, sizeof(duration)) == ESP_OK) {
+            item = cJSON_CreateString(duration);
+        }
+    } else if (driver->encoding == SENSOR_ENCODING_BOOL || driver->value_type == SENSOR_VALUE_BOOL) {
+        item = cJSON_CreateBool(value->b);
+    } else {
+        double number = (driver->value_type == SENSOR_VALUE_FLOAT) ? round_to_decimals(value->f, driver->decimals) :
+                        (driver->value_type == SENSOR_VALUE_INT) ? value->i : value->u;
+        item = cJSON_CreateNumber(number);
+    }
+    
+    if (item == NULL) {
+        ESP_LOGE(TAG, "Failed to create %s JSON item", driver->json_field);
+        return false;
+    }
+    cJSON_AddItemToObject(json, driver->json_field, item);
+    
+    return true;
+}
+
+/*
+ * Internal function to look up the driver of every sensor type
+ */
+static void get_drivers(const sensor_driver_t *drivers[SENSOR_TYPE_MAX])
+{
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        drivers[type] = sensor_service_get_driver(type);
+    }
+}
+
+/*
+ * Internal function to add sensor readings to a JSON object
+ */
+static bool add_sensor_fields(cJSON *json, const sensor_data_t *data)
+{
+    const sensor_driver_t *drivers[SENSOR_TYPE_MAX];
+    get_drivers(drivers);
+    
+    // Every registered sensor with a valid reading, encoded per its driver hints
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (drivers[type] && (data->valid_mask & (1u << type)) &&
+            !add_sensor_value(json, drivers[type], &data->values[type])) {
+            return false;
+        }
+    }
+    
+    if (data->stats_mask == 0) {
+        return true;
+    }
+    
+    const sensor_stats_t *stats[SENSOR_TYPE_MAX];
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        stats[type] = &data->stats[type];
+    }
+    return add_sensor_stats(json, drivers, stats, data->stats_mask, data->window_ms);
+}
+
+/*
+ * Internal function to add a millisecond timestamp to a sample object
+ */
+static bool add_sample_timestamp(cJSON *json, int64_t timestamp_us)
+{
+    // Millisecond timestamp lets the backend place each sample in time
+    cJSON *ts_item = cJSON_CreateNumber((double)(timestamp_us / 1000));
+    if (ts_item == NULL) {
+        ESP_LOGE(TAG, "Failed to create timestamp JSON item");
+        return false;
+    }
+    cJSON_AddItemToObject(json, JSON_FIELD_TIMESTAMP, ts_item);
+    
+    return true;
+}
+
+/*
+ * Internal function to add the device ID to a JSON object
+ */
+static bool add_device_id(cJSON *json)
+{
+    cJSON *device_id_item = cJSON_CreateString("esp32-s3");
+    if (device_id_item == NULL) {
+        ESP_LOGE(TAG, "Failed to create device_id JSON item");
+        return false;
+    }
+    cJSON_AddItemToObject(json, JSON_FIELD_DEVICE_ID, device_id_item);
+    
+    return true;
+}
+
+/*
+ * Internal function to add pending attachments to the payload root
+ */
+static bool add_attachments(cJSON *json)
+{
+    if (s_context.link_summary_attached) {
+        const wifi_link_summary_t *link = &s_context.link_summary;
+        cJSON *link_item = cJSON_AddObjectToObject(json, JSON_FIELD_LINK);
+        if (link_item == NULL) {
+            ESP_LOGE(TAG, "Failed to create link JSON item");
+            return false;
+        }
+        
+        // Short keys keep the summary compact on the uplink
+        if (link->samples > 0) {
+            cJSON_AddNumberToObject(link_item, "rssi_min", link->rssi_min);
+            cJSON_AddNumberToObject(link_item, "rssi_mean", link->rssi_mean);
+            cJSON_AddNumberToObject(link_item, "rssi_max", link->rssi_max);
+        }
+        cJSON_AddNumberToObject(link_item, "ch", link->channel);
+        cJSON_AddNumberToObject(link_item, "phy_mbps", link->phy_rate_mbps);
+        cJSON_AddNumberToObject(link_item, "disc", link->disconnects);
+        cJSON_AddNumberToObject(link_item, "retries", link->retries);
+        cJSON_AddNumberToObject(link_item, "reason", link->last_disconnect_reason);
+        cJSON_AddNumberToObject(link_item, "n", link->samples);
+    }
+    
+    if (s_context.boot_timings_attached) {
+        cJSON *boot_item = cJSON_AddObjectToObject(json, JSON_FIELD_BOOT);
+        if (boot_item == NULL) {
+            ESP_LOGE(TAG, "Failed to create boot JSON item");
+            return false;
+        }
+        
+        for (int stage = 0; stage < BOOT_STAGE_MAX; stage++) {
+            const boot_stage_timing_t *timing = &s_context.boot_timings.stages[stage];
+            if (timing->start_us == 0) {
+                continue;
+            }
+            
+            cJSON *span = cJSON_CreateArray();
+            if (span == NULL) {
+                ESP_LOGE(TAG, "Failed to create boot stage JSON item");
+                return false;
+            }
+            cJSON_AddItemToObject(boot_item, boot_orchestrator_stage_name(stage), span);
+            cJSON_AddItemToArray(span, cJSON_CreateNumber((double)(timing->start_us / 1000)));
+            cJSON_AddItemToArray(span, (timing->end_us != 0) ?
+                                 cJSON_CreateNumber((double)(timing->end_us / 1000)) :
+                                 cJSON_CreateNull());
+        }
+    }
+    
+    if (s_context.task_profile_attached) {
+        const task_profile_t *profile = &s_context.task_profile;
+        cJSON *tasks_item = cJSON_AddObjectToObject(json, JSON_FIELD_TASKS);
+        cJSON *list = cJSON_CreateArray();
+        if (tasks_item == NULL || list == NULL) {
+            cJSON_Delete(list);
+            ESP_LOGE(TAG, "Failed to create tasks JSON item");
+            return false;
+        }
+        
+        cJSON_AddNumberToObject(tasks_item, "load", profile->cpu_load_permille / 10.0);
+        cJSON_AddNumberToObject(tasks_item, "win_ms", profile->window_ms);
+        cJSON_AddItemToObject(tasks_item, "list", list);
+        for (int i = 0; i < profile->task_count; i++) {
+            const task_profile_entry_t *task = &profile->tasks[i];
+            cJSON *entry = cJSON_CreateArray();
+            if (entry == NULL) {
+                ESP_LOGE(TAG, "Failed to create task JSON item");
+                return false;
+            }
+            cJSON_AddItemToArray(list, entry);
+            cJSON_AddItemToArray(entry, cJSON_CreateString(task->name));
+            cJSON_AddItemToArray(entry, cJSON_CreateNumber(task->cpu_permille / 10.0));
+            cJSON_AddItemToArray(entry, cJSON_CreateNumber(task->stack_free_min));
+        }
+    }
+    
+    if (s_context.health_attached) {
+        const health_report_t *health = &s_context.health;
+        cJSON *health_item = cJSON_AddObjectToObject(json, JSON_FIELD_HEALTH);
+        if (health_item == NULL) {
+            ESP_LOGE(TAG, "Failed to create health JSON item");
+            return false;
+        }
+        
+        // Fixed-order arrays (layout in health_report.h) keep the block small
+        const double heap[] = {
+            health->heap_free, health->heap_min_free, health->heap_largest_block,
+            health->fragmentation_pct
+        };
+        const double http[] = {
+            health->http_ok, health->http_failed, health->http_timeouts,
+            health->http_network_errors, health->http_latency_avg_ms,
+            health->http_latency_p90_ms, health->http_last_status
+        };
+        const double sens[] = {
+            health->sensor_reads, health->sensor_errors, health->sampler_records,
+            health->sampler_overflows, health->sampler_high_water
+        };
+        const double wifi[] = {
+            health->rssi, health->wifi_disconnects, health->wifi_retries,
+            health->tx_bursts, health->radio_on_ms_per_hour
+        };
+        
+        cJSON_AddNumberToObject(health_item, "dt", health->interval_ms / 1000);
+        cJSON_AddItemToObject(health_item, "heap", cJSON_CreateDoubleArray(heap, ARRAY_SIZE(heap)));
+        cJSON_AddItemToObject(health_item, "http", cJSON_CreateDoubleArray(http, ARRAY_SIZE(http)));
+        cJSON_AddItemToObject(health_item, "sens", cJSON_CreateDoubleArray(sens, ARRAY_SIZE(sens)));
+        cJSON_AddItemToObject(health_item, "wifi", cJSON_CreateDoubleArray(wifi, ARRAY_SIZE(wifi)));
+    }
+    
+    return true;
+}
+
+/*
+ * Internal function to clear attachments once they have been delivered
+ */
+static void clear_attachments(void)
+{
+    s_context.link_summary_attached = false;
+    s_context.boot_timings_attached = false;
+    s_context.task_profile_attached = false;
+    s_context.health_attached = false;
+}
+
+/*
+ * Internal function to print a JSON object and release it
+ */
+static char* print_and_delete_json(cJSON *json)
+{
+    // Convert JSON object to string (no indentation, it only costs airtime)
+    char *json_string = cJSON_PrintUnformatted(json);
+    if (json_string == NULL) {
+        ESP_LOGE(TAG, "Failed to print JSON");
+        cJSON_Delete(json);
+        return NULL;
+    }
+    
+    ESP_LOGD(TAG, "Created JSON payload: %s", json_string);
+    
+    // Cleanup JSON object (string is now independent)
+    cJSON_Delete(json);
+    
+    return json_string;
+}
+
 /*
  * Create JSON from Sensor Data
  */
@@ -147,47 +596,138 @@ char* http_client_create_json(const sensor_data_t *data)
         return NULL;
     }
     
-    // Add temperature data (use centralized field names from config.h)
-    cJSON *temp_item = cJSON_CreateNumber(data->cpu_temp);
-    if (temp_item == NULL) {
-        ESP_LOGE(TAG, "Failed to create temperature JSON item");
+    if (!add_sensor_fields(json, data) || !add_device_id(json) || !add_attachments(json)) {
         cJSON_Delete(json);
         return NULL;
     }
-    cJSON_AddItemToObject(json, JSON_FIELD_CPU_TEMP, temp_item);
     
-    // Add uptime data
-    cJSON *uptime_item = cJSON_CreateString(data->uptime);
-    if (uptime_item == NULL) {
-        ESP_LOGE(TAG, "Failed to create uptime JSON item");
+    return print_and_delete_json(json);
+}
+
+/*
+ * Create JSON from a Batch of Sensor Samples
+ */
+char* http_client_create_batch_json(const sensor_data_t *samples, size_t count)
+{
+    if (!samples || count == 0) {
+        ESP_LOGE(TAG, "Invalid sensor batch");
+        return NULL;
+    }
+    
+    // A single sample keeps the original flat payload format
+    if (count == 1) {
+        return http_client_create_json(&samples[0]);
+    }
+    
+    cJSON *json = cJSON_CreateObject();
+    if (json == NULL) {
+        ESP_LOGE(TAG, "Failed to create JSON object");
+        return NULL;
+    }
+    
+    if (!add_device_id(json) || !add_attachments(json)) {
         cJSON_Delete(json);
         return NULL;
     }
-    cJSON_AddItemToObject(json, JSON_FIELD_UPTIME, uptime_item);
     
-    // Add device ID
-    cJSON *device_id_item = cJSON_CreateString("esp32-s3");
-    if (device_id_item == NULL) {
-        ESP_LOGE(TAG, "Failed to create device_id JSON item");
+    cJSON *array = cJSON_CreateArray();
+    if (array == NULL) {
+        ESP_LOGE(TAG, "Failed to create samples JSON array");
         cJSON_Delete(json);
         return NULL;
     }
-    cJSON_AddItemToObject(json, JSON_FIELD_DEVICE_ID, device_id_item);
+    cJSON_AddItemToObject(json, JSON_FIELD_SAMPLES, array);
     
-    // Convert JSON object to string
-    char *json_string = cJSON_Print(json);
-    if (json_string == NULL) {
-        ESP_LOGE(TAG, "Failed to print JSON");
+    for (size_t i = 0; i < count; i++) {
+        cJSON *item = cJSON_CreateObject();
+        if (item == NULL) {
+            ESP_LOGE(TAG, "Failed to create sample JSON object");
+            cJSON_Delete(json);
+            return NULL;
+        }
+        cJSON_AddItemToArray(array, item);
+        
+        if (!add_sensor_fields(item, &samples[i]) ||
+            !add_sample_timestamp(item, (int64_t)samples[i].timestamp_us)) {
+            cJSON_Delete(json);
+            return NULL;
+        }
+    }
+        
+    return print_and_delete_json(json);
+}
+
+/*
+ * Create JSON from a Column Batch of Sensor Samples
+ */
+char* http_client_create_sample_batch_json(const sensor_batch_t *batch)
+{
+    if (!batch || batch->count == 0) {
+        ESP_LOGE(TAG, "Invalid sensor batch");
+        return NULL;
+    }
+    
+    // A single sample keeps the original flat payload format
+    if (batch->count == 1) {
+        sensor_data_t sample;
+        sensor_batch_get_row(batch, 0, &sample);
+        return http_client_create_json(&sample);
+    }
+    
+    cJSON *json = cJSON_CreateObject();
+    if (json == NULL) {
+        ESP_LOGE(TAG, "Failed to create JSON object");
+        return NULL;
+    }
+    
+    if (!add_device_id(json) || !add_attachments(json)) {
         cJSON_Delete(json);
         return NULL;
     }
     
-    ESP_LOGD(TAG, "Created JSON payload: %s", json_string);
+    cJSON *array = cJSON_CreateArray();
+    if (array == NULL) {
+        ESP_LOGE(TAG, "Failed to create samples JSON array");
+        cJSON_Delete(json);
+        return NULL;
+    }
+    cJSON_AddItemToObject(json, JSON_FIELD_SAMPLES, array);
     
-    // Cleanup JSON object (string is now independent)
-    cJSON_Delete(json);
+    // Drivers are looked up once for the whole batch
+    const sensor_driver_t *drivers[SENSOR_TYPE_MAX];
+    get_drivers(drivers);
     
-    return json_string;
+    for (size_t i = 0; i < batch->count; i++) {
+        cJSON *item = cJSON_CreateObject();
+        if (item == NULL) {
+            ESP_LOGE(TAG, "Failed to create sample JSON object");
+            cJSON_Delete(json);
+            return NULL;
+        }
+        cJSON_AddItemToArray(array, item);
+        
+        bool ok = true;
+        for (int type = 0; ok && type < SENSOR_TYPE_MAX; type++) {
+            if (drivers[type] && (batch->valid_mask[i] & (1u << type))) {
+                ok = add_sensor_value(item, drivers[type], &batch->values[type][i]);
+            }
+        }
+        
+        if (ok && batch->stats_mask && batch->stats_mask[i] != 0) {
+            const sensor_stats_t *stats[SENSOR_TYPE_MAX];
+            for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+                stats[type] = &batch->stats[type][i];
+            }
+            ok = add_sensor_stats(item, drivers, stats, batch->stats_mask[i], batch->window_ms[i]);
+        }
+        
+        if (!ok || !add_sample_timestamp(item, batch->timestamp_us[i])) {
+            cJSON_Delete(json);
+            return NULL;
+        }
+    }
+    
+    return print_and_delete_json(json);
 }
 
 /*
@@ -209,16 +749,16 @@ bool http_client_validate_json(const char *json_string)
 }
 
 /*
- * Internal function to perform HTTP POST request
+ * Internal function to perform HTTP POST request with any payload
  */
-static esp_err_t perform_http_post(const char *url, const char *json_data)
+static esp_err_t perform_http_request(const char *url, const char *content_type,
+                                      const char *data, size_t len)
 {
-    if (!url || !json_data) {
+    if (!url || !content_type || !data) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    ESP_LOGI(TAG, "Sending HTTP POST to: %s", url);
-    ESP_LOGD(TAG, "JSON payload: %s", json_data);
+    DLOG_I(TAG, "Sending HTTP POST to: %s", url);
     
     // Reset last response data
     memset(&s_context.last_response, 0, sizeof(s_context.last_response));
@@ -227,75 +767,94 @@ static esp_err_t perform_http_post(const char *url, const char *json_data)
         s_context.response_buffer[0] = '\0';
     }
     
-    // Configure HTTP client
-    esp_http_client_config_t config = {
-        .url = url,
-        .event_handler = http_event_handler,
-        .method = HTTP_METHOD_POST,
-        .timeout_ms = HTTP_TIMEOUT_MS,
-        .buffer_size = 1024,                  // HTTP client buffer size
-        .buffer_size_tx = 1024,               // Transmit buffer size
-    };
+    // The client handle and its buffers are created once and reused
+    if (s_context.client == NULL) {
+        esp_http_client_config_t config = {
+            .url = url,
+            .event_handler = http_event_handler,
+            .method = HTTP_METHOD_POST,
+            .timeout_ms = HTTP_TIMEOUT_MS,
+            .buffer_size = HTTP_CLIENT_RX_BUFFER_SIZE,
+            .buffer_size_tx = HTTP_CLIENT_TX_BUFFER_SIZE,
+            .keep_alive_enable = true,
+        };
     
-    // Create HTTP client
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (client == NULL) {
-        ESP_LOGE(TAG, "Failed to initialize HTTP client");
-        s_context.stats.failed_requests++;
-        return ESP_FAIL;
+        s_context.client = esp_http_client_init(&config);
+        if (s_context.client == NULL) {
+            ESP_LOGE(TAG, "Failed to initialize HTTP client");
+            record_local_failure();
+            return ESP_FAIL;
+        }
+        
+        // Set HTTP headers
+        esp_http_client_set_header(s_context.client, "User-Agent", HTTP_USER_AGENT);
+        
+        // The configured buffers; handle, headers and URL copies are not counted
+        s_context.client_heap_bytes = HTTP_CLIENT_RX_BUFFER_SIZE + HTTP_CLIENT_TX_BUFFER_SIZE;
+        mem_stats_note_alloc(MEM_MODULE_HTTP_CLIENT, s_context.client_heap_bytes);
+    } else {
+        esp_http_client_set_url(s_context.client, url);
     }
-    
-    // Set HTTP headers
-    esp_http_client_set_header(client, "Content-Type", HTTP_CONTENT_TYPE);
-    esp_http_client_set_header(client, "User-Agent", HTTP_USER_AGENT);
+    esp_http_client_handle_t client = s_context.client;
     
     // Set POST data
-    esp_http_client_set_post_field(client, json_data, strlen(json_data));
-    
-    // Update statistics
-    s_context.stats.total_requests++;
-    s_context.stats.last_request_time = esp_timer_get_time();
+    esp_http_client_set_header(client, "Content-Type", content_type);
+    esp_http_client_set_post_field(client, data, (int)len);
     
     // Perform HTTP request
+    TRACE_BEGIN(TRACE_EV_HTTP_POST, len, 0);
+    int64_t start_us = esp_timer_get_time();
     esp_err_t err = esp_http_client_perform(client);
+    int status_code = (err == ESP_OK) ? esp_http_client_get_status_code(client) : 0;
+    TRACE_END(TRACE_EV_HTTP_POST, status_code, err);
+    
+    // Update statistics
+    record_request(len, start_us, esp_timer_get_time() - start_us, status_code, err);
     
     if (err == ESP_OK) {
         // Get response information
-        s_context.last_response.status_code = esp_http_client_get_status_code(client);
+        s_context.last_response.status_code = status_code;
         s_context.last_response.content_length = esp_http_client_get_content_length(client);
-        s_context.stats.last_status_code = s_context.last_response.status_code;
         
-        ESP_LOGI(TAG, "HTTP POST completed - Status: %d, Content-Length: %d", 
-                 s_context.last_response.status_code, s_context.last_response.content_length);
+        DLOG_I(TAG, "HTTP POST completed - Status: %d, Content-Length: %d", 
+               s_context.last_response.status_code, s_context.last_response.content_length);
         
         // Check if status code indicates success
         if (s_context.last_response.status_code >= 200 && s_context.last_response.status_code < 300) {
             s_context.last_response.success = true;
-            s_context.stats.successful_requests++;
-            ESP_LOGI(TAG, "Data successfully sent to API");
+            DLOG_I(TAG, "Data successfully sent to API");
         } else {
             s_context.last_response.success = false;
-            s_context.stats.failed_requests++;
-            ESP_LOGW(TAG, "API returned non-success status code: %d", s_context.last_response.status_code);
+            DLOG_W(TAG, "API returned non-success status code: %d", s_context.last_response.status_code);
             err = ESP_FAIL;
         }
+    } else if (err == ESP_ERR_TIMEOUT) {
+        ESP_LOGE(TAG, "HTTP POST request timeout");
     } else {
-        s_context.stats.failed_requests++;
-        if (err == ESP_ERR_TIMEOUT) {
-            s_context.stats.timeout_count++;
-            ESP_LOGE(TAG, "HTTP POST request timeout");
-        } else {
-            s_context.stats.network_errors++;
-            ESP_LOGE(TAG, "HTTP POST request failed: %s", esp_err_to_name(err));
-        }
+        ESP_LOGE(TAG, "HTTP POST request failed: %s", esp_err_to_name(err));
     }
     
-    // Cleanup
-    esp_http_client_cleanup(client);
+    // Drop the connection after errors so the next request starts clean
+    if (err != ESP_OK) {
+        esp_http_client_close(client);
+    }
     
     return err;
 }
 
+/*
+ * Internal function to perform HTTP POST request with a JSON payload
+ */
+static esp_err_t perform_http_post(const char *url, const char *json_data)
+{
+    if (!json_data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ESP_LOGD(TAG, "JSON payload: %s", json_data);
+    return perform_http_request(url, HTTP_CONTENT_TYPE, json_data, strlen(json_data));
+}
+
 /*
  * Send Sensor Data to Default API Endpoint
  */
@@ -311,22 +870,94 @@ esp_err_t http_client_post_sensor_data(const sensor_data_t *data)
     }
     
     // Create JSON payload
+    TRACE_BEGIN(TRACE_EV_ENCODE, 1, 0);
     char *json_string = http_client_create_json(data);
+    TRACE_END(TRACE_EV_ENCODE, json_string != NULL, 0);
     if (json_string == NULL) {
         ESP_LOGE(TAG, "Failed to create JSON payload");
-        s_context.stats.failed_requests++;
+        record_local_failure();
         return ESP_FAIL;
     }
     
     // Send HTTP request
     esp_err_t result = perform_http_post(API_ENDPOINT, json_string);
+    if (result == ESP_OK) {
+        clear_attachments();
+    }
     
     // Free JSON string
-    free(json_string);
+    cJSON_free(json_string);
     
     return result;
 }
 
+/*
+ * Internal function to send a batch payload and release it
+ */
+static esp_err_t post_batch_payload(char *json_string, size_t count)
+{
+    if (json_string == NULL) {
+        ESP_LOGE(TAG, "Failed to create JSON batch payload");
+        record_local_failure();
+        return ESP_FAIL;
+    }
+    
+    DLOG_I(TAG, "Sending batch of %u samples", (unsigned)count);
+    
+    // Send HTTP request
+    esp_err_t result = perform_http_post(API_ENDPOINT, json_string);
+    if (result == ESP_OK) {
+        clear_attachments();
+    }
+    
+    // Free JSON string
+    cJSON_free(json_string);
+    
+    return result;
+}
+
+/*
+ * Send a Batch of Sensor Samples to Default API Endpoint
+ */
+esp_err_t http_client_post_sensor_batch(const sensor_data_t *samples, size_t count)
+{
+    if (!samples || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        ESP_LOGE(TAG, "HTTP client not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    TRACE_BEGIN(TRACE_EV_ENCODE, count, 0);
+    char *json_string = http_client_create_batch_json(samples, count);
+    TRACE_END(TRACE_EV_ENCODE, json_string != NULL, 0);
+    
+    return post_batch_payload(json_string, count);
+}
+
+/*
+ * Send a Column Batch of Sensor Samples to Default API Endpoint
+ */
+esp_err_t http_client_post_sample_batch(const sensor_batch_t *batch)
+{
+    if (!batch || batch->count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        ESP_LOGE(TAG, "HTTP client not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    TRACE_BEGIN(TRACE_EV_ENCODE, batch->count, 0);
+    char *json_string = http_client_create_sample_batch_json(batch);
+    TRACE_END(TRACE_EV_ENCODE, json_string != NULL, 0);
+    
+    return post_batch_payload(json_string, batch->count);
+}
+
 /*
  * Send Custom JSON Data
  */
@@ -368,7 +999,7 @@ esp_err_t http_client_post_to_endpoint(const sensor_data_t *data, const char *en
     char *json_string = http_client_create_json(data);
     if (json_string == NULL) {
         ESP_LOGE(TAG, "Failed to create JSON payload");
-        s_context.stats.failed_requests++;
+        record_local_failure();
         return ESP_FAIL;
     }
     
@@ -376,11 +1007,129 @@ esp_err_t http_client_post_to_endpoint(const sensor_data_t *data, const char *en
     esp_err_t result = perform_http_post(endpoint_url, json_string);
     
     // Free JSON string
-    free(json_string);
+    cJSON_free(json_string);
     
     return result;
 }
 
+/*
+ * Upload Trace Events
+ */
+esp_err_t http_client_post_trace(const char *url)
+{
+    if (!url) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        ESP_LOGE(TAG, "HTTP client not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (trace_snapshot_size() == 0) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    
+    // Fixed chunk buffer: the backlog can be as large as the whole ring
+    static uint8_t chunk[sizeof(trace_header_t) + TRACE_UPLOAD_CHUNK_EVENTS * sizeof(trace_record_t)];
+    
+    // Each POST is a complete snapshot; trace_decode.py reads them concatenated.
+    // Stops after a partial chunk so events traced by the uploads themselves
+    // wait for the next call.
+    esp_err_t result = ESP_OK;
+    size_t len;
+    do {
+        uint32_t end_pos;
+        len = trace_snapshot(chunk, sizeof(chunk), &end_pos);
+        if (len <= sizeof(trace_header_t)) {
+            break;  // Nothing new
+        }
+    
+        result = perform_http_request(url, TRACE_CONTENT_TYPE, (const char *)chunk, len);
+        if (result == ESP_OK) {
+            trace_consume(end_pos);
+        }
+    } while (result == ESP_OK && len == sizeof(chunk));
+    
+    return result;
+}
+
+/*
+ * Attach Link Quality Summary to Next Upload
+ */
+esp_err_t http_client_attach_link_summary(const wifi_link_summary_t *summary)
+{
+    if (!summary) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    s_context.link_summary = *summary;
+    s_context.link_summary_attached = true;
+    
+    return ESP_OK;
+}
+
+/*
+ * Attach Boot Timings to Next Upload
+ */
+esp_err_t http_client_attach_boot_timings(const boot_timings_t *timings)
+{
+    if (!timings) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    s_context.boot_timings = *timings;
+    s_context.boot_timings_attached = true;
+    
+    return ESP_OK;
+}
+
+/*
+ * Attach Task Profile to Next Upload
+ */
+esp_err_t http_client_attach_task_profile(const task_profile_t *profile)
+{
+    if (!profile) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    s_context.task_profile = *profile;
+    s_context.task_profile_attached = true;
+    
+    return ESP_OK;
+}
+
+/*
+ * Attach Health Report to Next Upload
+ */
+esp_err_t http_client_attach_health(const health_report_t *report)
+{
+    if (!report) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    s_context.health = *report;
+    s_context.health_attached = true;
+    
+    return ESP_OK;
+}
+
 /*
  * Get Last HTTP Response
  */
@@ -394,7 +1143,7 @@ esp_err_t http_client_get_last_response(http_response_t *response)
         return ESP_ERR_INVALID_STATE;
     }
     
-    if (s_context.stats.total_requests == 0) {
+    if (stats_get(&s_stats, HTTP_STAT_TOTAL) == 0) {
         return ESP_ERR_INVALID_STATE;
     }
     
@@ -411,7 +1160,22 @@ esp_err_t http_client_get_stats(http_client_stats_t *stats)
         return ESP_ERR_INVALID_ARG;
     }
     
-    *stats = s_context.stats;
+    uint32_t values[HTTP_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    memset(stats, 0, sizeof(*stats));
+    stats->initialized = s_context.initialized;
+    stats->total_requests = values[HTTP_STAT_TOTAL];
+    stats->successful_requests = values[HTTP_STAT_SUCCESS];
+    stats->failed_requests = values[HTTP_STAT_FAILED];
+    stats->timeout_count = values[HTTP_STAT_TIMEOUTS];
+    stats->network_errors = values[HTTP_STAT_NETWORK_ERRORS];
+    stats->last_status_code = (int)values[HTTP_STAT_LAST_STATUS];
+    stats->last_request_time = (int64_t)stats_get64(values, HTTP_STAT_LAST_REQUEST_TIME);
+    stats->bytes_sent = stats_get64(values, HTTP_STAT_BYTES_SENT);
+    stats->latency_sum_us = stats_get64(values, HTTP_STAT_LATENCY_SUM);
+    memcpy(stats->latency_buckets, &values[HTTP_STAT_LATENCY_BUCKET], sizeof(stats->latency_buckets));
+    arena_get_stats(&s_context.request_arena, &stats->arena);
     return ESP_OK;
 }
 
@@ -426,10 +1190,7 @@ esp_err_t http_client_reset_stats(void)
     
     ESP_LOGI(TAG, "Resetting HTTP client statistics...");
     
-    // Preserve initialization flag
-    bool was_initialized = s_context.stats.initialized;
-    memset(&s_context.stats, 0, sizeof(s_context.stats));
-    s_context.stats.initialized = was_initialized;
+    stats_reset(&s_stats);
     
     return ESP_OK;
 }
@@ -470,9 +1231,15 @@ esp_err_t http_client_cleanup(void)
     
     ESP_LOGI(TAG, "Cleaning up HTTP client...");
     
+    if (s_context.client) {
+        esp_http_client_cleanup(s_context.client);
+        mem_stats_note_free(MEM_MODULE_HTTP_CLIENT, s_context.client_heap_bytes);
+        s_context.client = NULL;
+    }
+    
     // Free response buffer
     if (s_context.response_buffer) {
-        free(s_context.response_buffer);
+        mem_stats_free(MEM_MODULE_HTTP_CLIENT, s_context.response_buffer);
         s_context.response_buffer = NULL;
     }
     
@@ -16,7 +16,7 @@
  * Usage:
  *   esp_err_t ret = http_client_init();
  *   ESP_ERROR_CHECK(ret);
- *   
+ * 
  *   sensor_data_t data = { .cpu_temp = 25.5, .uptime = "1h 30m 45s" };
  *   ret = http_client_post_sensor_data(&data);
  *   if (ret == ESP_OK) {
@@ -28,13 +28,24 @@
 #define HTTP_CLIENT_H
 
 #include "esp_err.h"
+#include "arena.h"
+#include "sensor_batch.h"
 #include "sensor_service.h"
+#include "wifi_manager.h"
+#include "boot_orchestrator.h"
+#include "task_profiler.h"
+#include "health_report.h"
 #include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Upper bounds of the request latency histogram buckets (ms); a final
+// bucket counts everything slower
+#define HTTP_LATENCY_BOUNDS_MS     { 50, 100, 250, 500, 1000, 2500, 5000, 10000 }
+#define HTTP_LATENCY_BUCKETS       9
+
 /*
  * HTTP Response Information
  */
@@ -58,6 +69,10 @@ typedef struct {
     uint32_t network_errors;             // Number of network-related errors
     int64_t last_request_time;           // Timestamp of last request
     int last_status_code;                // Status code of last request
+    uint64_t bytes_sent;                 // Request body bytes handed to the client
+    uint64_t latency_sum_us;             // Total duration of all requests
+    uint32_t latency_buckets[HTTP_LATENCY_BUCKETS]; // Requests per latency bucket (not cumulative)
+    arena_stats_t arena;                 // Request arena usage (JSON encoding and parsing)
 } http_client_stats_t;
 
 /*
@@ -113,6 +128,54 @@ esp_err_t http_client_init(void);
  */
 esp_err_t http_client_post_sensor_data(const sensor_data_t *data);
 
+/*
+ * Send a Batch of Sensor Samples to Default API Endpoint
+ * 
+ * Sends several samples in a single HTTP POST so the radio is woken once
+ * per flush rather than once per sample. A batch of one sample is sent
+ * in the same format as http_client_post_sensor_data().
+ * 
+ * JSON Format (count > 1):
+ * {
+ *   "device_id": "esp32-s3",
+ *   "samples": [
+ *     { "cpu_temp": 25.4, "sys_uptime": "1h 30m 45s", "timestamp": 5445000 },
+ *     ...
+ *   ]
+ * }
+ * 
+ * Parameters:
+ *   samples: Array of sensor samples, oldest first
+ *   count: Number of samples in the array
+ * 
+ * Returns:
+ *   ESP_OK: Batch sent successfully (HTTP 2xx response)
+ *   ESP_ERR_INVALID_ARG: Invalid samples pointer or empty batch
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ *   ESP_ERR_TIMEOUT: Request timeout
+ *   ESP_FAIL: HTTP request failed or non-2xx response
+ */
+esp_err_t http_client_post_sensor_batch(const sensor_data_t *samples, size_t count);
+
+/*
+ * Send a Column Batch of Sensor Samples to Default API Endpoint
+ * 
+ * Same payload as http_client_post_sensor_batch(), encoded directly from
+ * the columns of a sensor_batch (for example a view from
+ * sample_buffer_peek_batch()) without building sensor_data_t records.
+ * 
+ * Parameters:
+ *   batch: Samples to send, oldest first
+ * 
+ * Returns:
+ *   ESP_OK: Batch sent successfully (HTTP 2xx response)
+ *   ESP_ERR_INVALID_ARG: Invalid batch pointer or empty batch
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ *   ESP_ERR_TIMEOUT: Request timeout
+ *   ESP_FAIL: HTTP request failed or non-2xx response
+ */
+esp_err_t http_client_post_sample_batch(const sensor_batch_t *batch);
+
 /*
  * Send Custom JSON Data
  * 
@@ -150,6 +213,112 @@ esp_err_t http_client_post_json(const char *json_data);
  */
 esp_err_t http_client_post_to_endpoint(const sensor_data_t *data, const char *endpoint_url);
 
+/*
+ * Upload Trace Events
+ * 
+ * POSTs the unread trace events (see trace.h) as application/octet-stream,
+ * at most 64 events per request, each request a complete snapshot copied
+ * through a fixed static buffer. Events are marked read only when the
+ * server accepts them. Decode with tools/trace_decode.py.
+ * 
+ * Parameters:
+ *   url: Upload URL
+ * 
+ * Returns:
+ *   ESP_OK: Events uploaded (or none unread)
+ *   ESP_ERR_INVALID_ARG: Invalid URL pointer
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ *   ESP_ERR_NOT_SUPPORTED: Tracing compiled out
+ *   ESP_FAIL: Request failed
+ */
+esp_err_t http_client_post_trace(const char *url);
+
+/*
+ * Attach Link Quality Summary to Next Upload
+ * 
+ * Adds a compact "link" object to the payload of the next sensor data
+ * upload. The attachment is dropped once an upload succeeds.
+ * 
+ * JSON Format:
+ * "link": {
+ *   "rssi_min": -71, "rssi_mean": -66.5, "rssi_max": -60,
+ *   "ch": 6, "phy_mbps": 72, "disc": 0, "retries": 0, "reason": 0, "n": 12
+ * }
+ * 
+ * Parameters:
+ *   summary: Link summary to attach (copied)
+ * 
+ * Returns:
+ *   ESP_OK: Summary attached
+ *   ESP_ERR_INVALID_ARG: Invalid summary pointer
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ */
+esp_err_t http_client_attach_link_summary(const wifi_link_summary_t *summary);
+
+/*
+ * Attach Boot Timings to Next Upload
+ * 
+ * Adds a "boot" object with the start and end time (ms since reset) of
+ * every boot stage that has started. Stages still running report null
+ * as their end time. The attachment is dropped once an upload succeeds.
+ * 
+ * JSON Format:
+ * "boot": { "nvs": [41, 63], "wifi_init": [63, 118], ..., "first_upload": [2710, 2934] }
+ * 
+ * Parameters:
+ *   timings: Boot timings to attach (copied)
+ * 
+ * Returns:
+ *   ESP_OK: Timings attached
+ *   ESP_ERR_INVALID_ARG: Invalid timings pointer
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ */
+esp_err_t http_client_attach_boot_timings(const boot_timings_t *timings);
+
+/*
+ * Attach Task Profile to Next Upload
+ * 
+ * Adds a "tasks" object with the CPU load and, busiest first, the CPU
+ * share (percent of all cores) and minimum free stack (bytes) of every
+ * task over the last profiler window. The attachment is dropped once an
+ * upload succeeds.
+ * 
+ * JSON Format:
+ * "tasks": { "load": 7.4, "win_ms": 10000,
+ *            "list": [["IDLE1", 49.6, 824], ["main", 3.1, 1820], ...] }
+ * 
+ * Parameters:
+ *   profile: Task profile to attach (copied)
+ * 
+ * Returns:
+ *   ESP_OK: Profile attached
+ *   ESP_ERR_INVALID_ARG: Invalid profile pointer
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ */
+esp_err_t http_client_attach_task_profile(const task_profile_t *profile);
+
+/*
+ * Attach Health Report to Next Upload
+ * 
+ * Adds a "health" object with heap watermarks, gauges and counter deltas
+ * (see health_report.h for the array layout). The attachment is dropped
+ * once an upload succeeds.
+ * 
+ * JSON Format:
+ * "health": { "dt": 600, "heap": [182344, 171020, 110592, 39],
+ *             "http": [60, 0, 0, 0, 212, 250, 200], "sens": [60, 0, 0, 0, 0],
+ *             "wifi": [-58, 0, 0, 60, 41200] }
+ * 
+ * Parameters:
+ *   report: Health report to attach (copied)
+ * 
+ * Returns:
+ *   ESP_OK: Report attached
+ *   ESP_ERR_INVALID_ARG: Invalid report pointer
+ *   ESP_ERR_INVALID_STATE: HTTP client not initialized
+ */
+esp_err_t http_client_attach_health(const health_report_t *report);
+
 /*
  * Get Last HTTP Response
  * 
@@ -229,17 +398,48 @@ esp_err_t http_client_cleanup(void);
  * Create JSON from Sensor Data
  * 
  * Creates a JSON string from sensor data structure.
- * Caller is responsible for freeing the returned string.
+ * Caller must free the returned string with cJSON_free().
  * 
  * Parameters:
  *   data: Pointer to sensor_data_t structure
  * 
  * Returns:
- *   char*: Allocated JSON string (must be freed by caller)
+ *   char*: Allocated JSON string (free with cJSON_free())
  *   NULL: JSON creation failed
  */
 char* http_client_create_json(const sensor_data_t *data);
 
+/*
+ * Create JSON from a Batch of Sensor Samples
+ * 
+ * Creates the batch payload described in http_client_post_sensor_batch().
+ * Caller must free the returned string with cJSON_free().
+ * 
+ * Parameters:
+ *   samples: Array of sensor samples
+ *   count: Number of samples in the array
+ * 
+ * Returns:
+ *   char*: Allocated JSON string (free with cJSON_free())
+ *   NULL: JSON creation failed
+ */
+char* http_client_create_batch_json(const sensor_data_t *samples, size_t count);
+
+/*
+ * Create JSON from a Column Batch of Sensor Samples
+ * 
+ * Creates the payload described in http_client_post_sensor_batch() from
+ * a sensor_batch. Caller must free the returned string with cJSON_free().
+ * 
+ * Parameters:
+ *   batch: Samples to encode
+ * 
+ * Returns:
+ *   char*: Allocated JSON string (free with cJSON_free())
+ *   NULL: JSON creation failed
+ */
+char* http_client_create_sample_batch_json(const sensor_batch_t *batch);
+
 /*
  * Validate JSON Format
  * 
@@ -6,9 +6,25 @@
  * 
  * Architecture:
  * - config.h: Centralized configuration management
- * - wifi_manager: WiFi connectivity service
+ * - wifi_manager: WiFi connectivity service (simulated link on the linux target)
  * - sensor_service: Data collection service (temperature, uptime)
  * - http_client: HTTP communication service
+ * - boot_orchestrator: Concurrent startup sequence with boot timings
+ * - boot_guard: Reboot loop detection and persistent reset counters
+ * - sample_buffer: Offline sample buffering while the network is down
+ * - sensor_batch: Column-wise sample batches for buffering, encoding and aggregation
+ * - aggregator: Windowed statistics uploaded instead of raw readings
+ * - report_filter: Report-by-exception deadbands and heartbeats
+ * - adc_pipeline: Continuous analog acquisition with block processing
+ * - mem_stats: Per-module heap accounting and fragmentation tracking
+ * - arena: Bump allocator serving the JSON request path
+ * - task_profiler: Per-task CPU share and stack high-water marks
+ * - trace: Binary hot-path event trace (serial dump or upload)
+ * - deferred_log: Per-cycle logging formatted by a low-priority task
+ * - metrics_server: Prometheus metrics endpoint for fleet scraping
+ * - health_report: Self-telemetry deltas piggy-backed on uploads
+ * - stats_block: Lock-free statistics counters shared by the modules
+ * - energy_model: Power-state time and energy per delivered sample
  * - main.c: Application orchestration (this file)
  * 
  * Features:
@@ -29,85 +45,39 @@
 #include "freertos/task.h"
 #include "esp_system.h"
 #include "esp_log.h"
-#include "nvs_flash.h"
 
 // Application modules
 #include "config.h"
 #include "wifi_manager.h"
 #include "sensor_service.h"
 #include "http_client.h"
+#include "duty_cycle.h"
+#include "boot_orchestrator.h"
+#include "boot_guard.h"
+#include "sample_buffer.h"
+#include "sensor_batch.h"
+#include "aggregator.h"
+#include "report_filter.h"
+#include "sim_signal.h"
+#include "chip_temp.h"
+#include "adc_pipeline.h"
+#include "dsp_kernels.h"
+#include "mem_stats.h"
+#include "task_profiler.h"
+#include "trace.h"
+#include "deferred_log.h"
+#include "metrics_server.h"
+#include "health_report.h"
+#include "energy_model.h"
 
 // Logging tag for this module
 static const char *TAG = APP_NAME;
 
-/*
- * Initialize NVS Flash
- * 
- * Initializes Non-Volatile Storage which is required for WiFi and other
- * ESP-IDF components that need persistent storage.
- */
-static esp_err_t init_nvs_flash(void)
-{
-    ESP_LOGI(TAG, "Initializing NVS flash...");
-    
-    esp_err_t ret = nvs_flash_init();
-    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
-        // NVS partition was truncated and needs to be erased
-        ESP_LOGW(TAG, "NVS partition needs to be erased, performing erase...");
-        ESP_ERROR_CHECK(nvs_flash_erase());
-        ret = nvs_flash_init();
-    }
-    
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "NVS flash initialized successfully");
-    } else {
-        ESP_LOGE(TAG, "Failed to initialize NVS flash: %s", esp_err_to_name(ret));
-    }
-    
-    return ret;
-}
-
-/*
- * Initialize All Application Services
- * 
- * Initializes all required services in the correct order.
- * Uses ESP-IDF error handling patterns for robust startup.
- */
-static esp_err_t init_application_services(void)
-{
-    esp_err_t ret;
-    
-    ESP_LOGI(TAG, "Initializing application services...");
-    
-    // Initialize WiFi manager
-    ret = wifi_manager_init();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize WiFi manager: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    // Initialize sensor service
-    ret = sensor_service_init();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize sensor service: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    // Initialize HTTP client
-    ret = http_client_init();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to initialize HTTP client: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    ESP_LOGI(TAG, "All application services initialized successfully");
-    return ESP_OK;
-}
-
 /*
  * Connect to WiFi Network
  * 
- * Establishes WiFi connectivity using the WiFi manager service.
+ * Establishes WiFi connectivity using the WiFi manager service. If the
+ * boot orchestrator already started association, waits for that attempt.
  * Returns only after successful connection or failure.
  */
 static esp_err_t connect_to_wifi(void)
@@ -115,6 +85,7 @@ static esp_err_t connect_to_wifi(void)
     ESP_LOGI(TAG, "Connecting to WiFi network...");
     
     esp_err_t ret = wifi_manager_connect();
+    boot_orchestrator_stage_end(BOOT_STAGE_WIFI_CONNECT, ret);
     if (ret == ESP_OK) {
         ESP_LOGI(TAG, "WiFi connection established successfully");
         
@@ -139,58 +110,307 @@ static esp_err_t connect_to_wifi(void)
     return ret;
 }
 
+// Scratch batch for duty-cycle uploads (samples are copied out of RTC memory)
+static sensor_data_t s_upload_batch[UPLOAD_BATCH_SIZE];
+
 /*
- * Perform Data Transmission Cycle
+ * Flush Sample Buffer
  * 
- * Collects sensor data and transmits it to the API endpoint.
- * This function encapsulates one complete data transmission cycle.
+ * Sends buffered samples in HTTP POSTs of up to UPLOAD_BATCH_SIZE samples.
+ * Each POST is reported to the WiFi manager as one radio burst for energy
+ * accounting. Samples are only removed from the buffer once the server
+ * accepted them, so an outage leaves them queued for the next cycle. At
+ * most OFFLINE_FLUSH_MAX_BATCHES POSTs are sent per cycle so a large
+ * backlog does not delay sampling.
  */
-static esp_err_t perform_data_transmission(void)
+static esp_err_t flush_sample_buffer(void)
 {
-    ESP_LOGI(TAG, "--- Starting data transmission cycle ---");
-    
     // Check WiFi connection status
     if (!wifi_manager_is_connected()) {
-        ESP_LOGW(TAG, "WiFi not connected, skipping transmission");
+        DLOG_W(TAG, "WiFi not connected, %u samples buffered", (unsigned)sample_buffer_count());
         return ESP_ERR_WIFI_NOT_CONNECT;
     }
     
-    // Read sensor data
-    sensor_data_t sensor_data;
-    esp_err_t ret = sensor_service_read(&sensor_data);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "Failed to read sensor data: %s", esp_err_to_name(ret));
-        return ret;
+    // Connection may have come up in the background
+    boot_orchestrator_stage_end(BOOT_STAGE_WIFI_CONNECT, ESP_OK);
+    
+    // Piggy-back the link quality of this reporting window
+    if (LINK_TELEMETRY_UPLOAD) {
+        wifi_link_summary_t link_summary;
+        if (wifi_manager_get_link_summary(&link_summary, true) == ESP_OK) {
+            http_client_attach_link_summary(&link_summary);
+        }
     }
     
-    ESP_LOGI(TAG, "Sensor data - Temperature: %.1f°C, Uptime: %s", 
-             sensor_data.cpu_temp, sensor_data.uptime);
+    // Piggy-back the task profile of the last profiler window
+    if (TASK_PROFILE_UPLOAD) {
+        task_profile_t profile;
+        if (task_profiler_get_profile(&profile) == ESP_OK) {
+            http_client_attach_task_profile(&profile);
+        }
+    }
     
-    // Send data to API
-    ret = http_client_post_sensor_data(&sensor_data);
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "Data transmission completed successfully");
+    // Every Nth upload carries a health report; its baseline moves on delivery
+    static uint32_t uploads_since_health = 0;
+    bool health_attached = false;
+    if (HEALTH_UPLOAD_ENABLED && uploads_since_health + 1 >= HEALTH_UPLOAD_INTERVAL) {
+        health_report_t health;
+        if (health_report_collect(&health) == ESP_OK &&
+            http_client_attach_health(&health) == ESP_OK) {
+            health_attached = true;
+        }
+    }
+    
+    // Boot timings go out with the upload after the first successful one,
+    // so the first_upload stage is complete when it is reported
+    static bool boot_timings_reported = false;
+    bool boot_timings_attached = false;
+    boot_orchestrator_stage_begin(BOOT_STAGE_FIRST_UPLOAD);
+    if (!boot_timings_reported) {
+        boot_timings_t boot_timings;
+        if (boot_orchestrator_get_timings(&boot_timings) == ESP_OK &&
+            boot_timings.stages[BOOT_STAGE_FIRST_UPLOAD].end_us != 0 &&
+            boot_timings.stages[BOOT_STAGE_FIRST_UPLOAD].result == ESP_OK &&
+            http_client_attach_boot_timings(&boot_timings) == ESP_OK) {
+            boot_timings_attached = true;
+        }
+    }
+    
+    esp_err_t ret = ESP_OK;
+    for (int batch = 0; batch < OFFLINE_FLUSH_MAX_BATCHES && sample_buffer_count() > 0; batch++) {
+        sensor_batch_t upload;
+        size_t count = sample_buffer_peek_batch(&upload, UPLOAD_BATCH_SIZE);
+    
+        // Send data to API, encoded straight from the buffer columns
+        wifi_manager_radio_burst_begin();
+        ret = http_client_post_sample_batch(&upload);
+        wifi_manager_radio_burst_end();
+        boot_orchestrator_stage_end(BOOT_STAGE_FIRST_UPLOAD, ret);
+        
+        if (ret != ESP_OK) {
+            break;
+        }
+        
+        sample_buffer_consume(count);
+        energy_model_add_delivered(count);
+        if (boot_timings_attached) {
+            boot_timings_reported = true;
+            boot_timings_attached = false;
+        }
+        if (health_attached) {
+            health_report_commit();
+            health_attached = false;
+            uploads_since_health = 0;
+        } else {
+            uploads_since_health++;
+        }
+        DLOG_I(TAG, "Data transmission completed successfully (%u samples)", (unsigned)count);
         
         // Get HTTP response details
         http_response_t response;
         if (http_client_get_last_response(&response) == ESP_OK) {
-            ESP_LOGI(TAG, "HTTP Response - Status: %d, Content-Length: %d", 
-                     response.status_code, response.content_length);
+            DLOG_I(TAG, "HTTP Response - Status: %d, Content-Length: %d", 
+                   response.status_code, response.content_length);
         }
-    } else {
-        ESP_LOGW(TAG, "Data transmission failed: %s", esp_err_to_name(ret));
+    }
+    
+    if (ret != ESP_OK) {
+        DLOG_W(TAG, "Data transmission failed: %s, %u samples kept", 
+               esp_err_to_name(ret), (unsigned)sample_buffer_count());
         
         // Log HTTP statistics for debugging
         http_client_stats_t stats;
         if (http_client_get_stats(&stats) == ESP_OK) {
-            ESP_LOGI(TAG, "HTTP Stats - Total: %lu, Success: %lu, Failed: %lu", 
-                     stats.total_requests, stats.successful_requests, stats.failed_requests);
+            DLOG_I(TAG, "HTTP Stats - Total: %lu, Success: %lu, Failed: %lu", 
+                   (unsigned long)stats.total_requests, (unsigned long)stats.successful_requests,
+                   (unsigned long)stats.failed_requests);
         }
+    } else if (sample_buffer_count() > 0) {
+        DLOG_I(TAG, "Backlog: %u samples left for next cycle", (unsigned)sample_buffer_count());
     }
     
     return ret;
 }
 
+// Set once the background sampler is running (SAMPLER_RATE_HZ > 0)
+static bool s_sampler_started = false;
+
+/*
+ * Acquire Samples
+ * 
+ * Reads the sensors directly, or, when the background sampler is running,
+ * drains all records it produced since the last cycle in bulk. With
+ * aggregation enabled every reading is fed to the aggregator. The newest
+ * reading is returned for logging and raw uploads.
+ */
+static esp_err_t acquire_samples(sensor_data_t *sensor_data)
+{
+    if (!s_sampler_started) {
+        esp_err_t ret = sensor_service_read(sensor_data);
+        if (ret == ESP_OK && AGGREGATION_ENABLED) {
+            aggregator_add(sensor_data->timestamp_us, sensor_data->values, sensor_data->valid_mask);
+        }
+        return ret;
+    }
+    
+    static sensor_record_t records[SAMPLER_DRAIN_CHUNK];
+    static uint8_t columns[SENSOR_BATCH_STORAGE_SIZE(SAMPLER_DRAIN_CHUNK, false)] SENSOR_BATCH_ALIGN;
+    sensor_batch_t batch;
+    sensor_record_t latest;
+    size_t total = 0;
+    size_t count;
+    
+    sensor_batch_init(&batch, columns, SAMPLER_DRAIN_CHUNK, false);
+    while ((count = sensor_service_drain(records, SAMPLER_DRAIN_CHUNK)) > 0) {
+        if (AGGREGATION_ENABLED) {
+            // Aggregated column-wise, one sensor at a time
+            sensor_batch_clear(&batch);
+            sensor_batch_append_records(&batch, records, count);
+            aggregator_add_batch(&batch);
+        }
+        latest = records[count - 1];
+        total += count;
+    }
+    
+    if (total == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    DLOG_I(TAG, "Drained %u sampler records", (unsigned)total);
+    sensor_service_record_to_data(&latest, sensor_data);
+    return sensor_data->data_valid ? ESP_OK : ESP_FAIL;
+}
+
+/*
+ * Queue Sample for Upload
+ * 
+ * Adds a sample to the offline buffer unless the report filter finds it
+ * unchanged since the last reported sample.
+ */
+static void queue_for_upload(const sensor_data_t *sample)
+{
+    if (REPORT_FILTER_ENABLED && !report_filter_accept(sample)) {
+        DLOG_I(TAG, "Sample within deadband, not reported");
+        return;
+    }
+    
+    sample_buffer_push(sample);
+}
+
+/*
+ * Perform Data Transmission Cycle
+ * 
+ * Collects sensor data into the offline sample buffer (raw readings, or
+ * one summary per closed window when aggregation is enabled). The buffer
+ * is sent to the API endpoint once UPLOAD_BATCH_SIZE samples are pending
+ * and the network is available; otherwise samples accumulate until it
+ * returns.
+ */
+static esp_err_t perform_data_transmission(void)
+{
+    DLOG_I(TAG, "--- Starting data transmission cycle ---");
+    
+    // Read sensor data
+    sensor_data_t sensor_data;
+    boot_orchestrator_stage_begin(BOOT_STAGE_FIRST_SAMPLE);
+    esp_err_t ret = acquire_samples(&sensor_data);
+    boot_orchestrator_stage_end(BOOT_STAGE_FIRST_SAMPLE, ret);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to read sensor data: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    DLOG_I(TAG, "Sensor data - Temperature: %.1f°C, Uptime: %s", 
+           sensor_data.cpu_temp, sensor_data.uptime);
+    
+    if (AGGREGATION_ENABLED) {
+        // Only closed windows are uploaded
+        sensor_data_t summary;
+        while (aggregator_pop(&summary)) {
+            queue_for_upload(&summary);
+        }
+    } else {
+        queue_for_upload(&sensor_data);
+    }
+    
+    if (sample_buffer_count() < UPLOAD_BATCH_SIZE) {
+        DLOG_I(TAG, "Sample queued (%u/%d)", (unsigned)sample_buffer_count(), UPLOAD_BATCH_SIZE);
+        return ESP_OK;
+    }
+    
+    return flush_sample_buffer();
+}
+
+/*
+ * Flush Duty-Cycle Buffer
+ * 
+ * Brings up NVS, WiFi and HTTP and uploads the samples stored in RTC
+ * memory in chunks of UPLOAD_BATCH_SIZE. Samples that could not be sent
+ * stay in the buffer for the next flush wake. Only the HTTP client and
+ * the WiFi link are required; other degraded stages do not block the upload.
+ */
+static void flush_duty_cycle_buffer(void)
+{
+    boot_timings_t timings;
+    
+    boot_orchestrator_run();
+    boot_orchestrator_get_timings(&timings);
+    if (timings.stages[BOOT_STAGE_HTTP_INIT].result != ESP_OK || connect_to_wifi() != ESP_OK) {
+        ESP_LOGW(TAG, "Network unavailable, keeping %u samples for next flush",
+                 (unsigned)duty_cycle_pending());
+        duty_cycle_flush_done(false);
+        return;
+    }
+    
+    while (duty_cycle_pending() > 0) {
+        size_t count = 0;
+        duty_cycle_peek(s_upload_batch, UPLOAD_BATCH_SIZE, &count);
+        
+        wifi_manager_radio_burst_begin();
+        esp_err_t ret = http_client_post_sensor_batch(s_upload_batch, count);
+        wifi_manager_radio_burst_end();
+        
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Upload failed: %s, %u samples kept", 
+                     esp_err_to_name(ret), (unsigned)duty_cycle_pending());
+            duty_cycle_flush_done(false);
+            return;
+        }
+        duty_cycle_consume(count);
+        energy_model_add_delivered(count);
+    }
+    
+    duty_cycle_flush_done(true);
+    ESP_LOGI(TAG, "RTC sample buffer flushed");
+}
+
+/*
+ * Run One Duty-Cycle Wake
+ * 
+ * Takes one sample into RTC memory and goes back to deep sleep. Sample-only
+ * wakes skip NVS, WiFi and HTTP initialization entirely; only every
+ * DUTY_CYCLE_WAKES_PER_FLUSH-th wake brings up the network to upload.
+ */
+static void run_duty_cycle_wake(void)
+{
+    bool flush_due = duty_cycle_begin_wake();
+    
+    // Only the sensor service is needed to take a sample
+    if (sensor_service_init() == ESP_OK) {
+        sensor_data_t sensor_data;
+        if (sensor_service_read(&sensor_data) == ESP_OK) {
+            duty_cycle_append(&sensor_data);
+        }
+    }
+    
+    if (flush_due) {
+        flush_duty_cycle_buffer();
+    }
+    
+    energy_model_enter_deep_sleep((uint64_t)POST_INTERVAL_MS * 1000);
+    duty_cycle_sleep();
+}
+
 /*
  * Display Application Status
  * 
@@ -216,19 +436,203 @@ static void display_application_status(void)
         sensor_status_t sensor_status;
         if (sensor_service_get_status(&sensor_status) == ESP_OK) {
             ESP_LOGI(TAG, "Sensor Status - Reads: %lu, Errors: %lu", 
-                     sensor_status.read_count, sensor_status.error_count);
+                     (unsigned long)sensor_status.read_count,
+                     (unsigned long)sensor_status.error_count);
+            for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+                const sensor_driver_t *driver = sensor_service_get_driver(type);
+                if (driver && sensor_status.driver_reads[type] > 0) {
+                    ESP_LOGI(TAG, "Driver %s - Reads: %lu, Avg cost: %lu ns", driver->name,
+                             (unsigned long)sensor_status.driver_reads[type],
+                             (unsigned long)sensor_status.driver_read_ns[type]);
+                }
+            }
+            if (CHIP_TEMP_SENSOR_ENABLED) {
+                chip_temp_stats_t chip_stats;
+                chip_temp_get_stats(&chip_stats);
+                ESP_LOGI(TAG, "Chip temperature sensor - Reads: %lu, Errors: %lu, Power-ups: %lu",
+                         (unsigned long)chip_stats.reads, (unsigned long)chip_stats.errors,
+                         (unsigned long)chip_stats.power_ups);
+            }
+            if (sensor_status.sampler_running) {
+                ESP_LOGI(TAG, "Sampler - Rate: %lu Hz, Records: %lu, Overflows: %lu, Ring high water: %lu",
+                         (unsigned long)sensor_status.sampler_rate_hz,
+                         (unsigned long)sensor_status.sampler_records,
+                         (unsigned long)sensor_status.sampler_overflows,
+                         (unsigned long)sensor_status.sampler_high_water);
+            }
+        }
+        
+        // ADC pipeline status
+        if (ADC_PIPELINE_ENABLED) {
+            adc_pipeline_stats_t adc_stats;
+            adc_pipeline_get_stats(&adc_stats);
+            ESP_LOGI(TAG, "ADC pipeline - Blocks: %lu, Samples: %lu, Decimated: %lu, Overruns: %lu",
+                     (unsigned long)adc_stats.blocks, (unsigned long)adc_stats.samples,
+                     (unsigned long)adc_stats.decimated, (unsigned long)adc_stats.overruns);
+            ESP_LOGI(TAG, "ADC last block - Mean: %.1f mV, RMS: %.1f mV, Peak: %.1f mV",
+                     adc_stats.block_mean_mv, adc_stats.block_rms_mv, adc_stats.block_peak_mv);
+        }
+        
+        // Aggregation status
+        if (AGGREGATION_ENABLED) {
+            aggregator_stats_t agg_stats;
+            aggregator_get_stats(&agg_stats);
+            ESP_LOGI(TAG, "Aggregator - Readings: %lu, Windows: %lu, Late: %lu, Dropped windows: %lu",
+                     (unsigned long)agg_stats.samples, (unsigned long)agg_stats.windows,
+                     (unsigned long)agg_stats.late_samples,
+                     (unsigned long)agg_stats.dropped_windows);
+        }
+        
+        // Report filter status
+        if (REPORT_FILTER_ENABLED) {
+            report_filter_stats_t filter_stats;
+            report_filter_get_stats(&filter_stats);
+            ESP_LOGI(TAG, "Report filter - Samples: %lu, Reported: %lu, Suppressed: %lu, Heartbeats: %lu",
+                     (unsigned long)filter_stats.samples, (unsigned long)filter_stats.passed,
+                     (unsigned long)filter_stats.suppressed,
+                     (unsigned long)filter_stats.heartbeats);
         }
         
         // HTTP client status
         http_client_stats_t http_stats;
         if (http_client_get_stats(&http_stats) == ESP_OK) {
             ESP_LOGI(TAG, "HTTP Status - Total: %lu, Success: %lu, Failed: %lu, Timeouts: %lu", 
-                     http_stats.total_requests, http_stats.successful_requests, 
-                     http_stats.failed_requests, http_stats.timeout_count);
+                     (unsigned long)http_stats.total_requests,
+                     (unsigned long)http_stats.successful_requests,
+                     (unsigned long)http_stats.failed_requests,
+                     (unsigned long)http_stats.timeout_count);
+            ESP_LOGI(TAG, "Request arena - High water: %lu/%lu bytes, Allocs: %lu, Overflows: %lu",
+                     (unsigned long)http_stats.arena.high_water,
+                     (unsigned long)http_stats.arena.size, (unsigned long)http_stats.arena.allocs,
+                     (unsigned long)http_stats.arena.overflows);
+        }
+        
+        // Link quality (uploads own the reporting window when attached to them)
+        wifi_link_summary_t link_summary;
+        if (wifi_manager_get_link_summary(&link_summary, !LINK_TELEMETRY_UPLOAD) == ESP_OK &&
+            link_summary.samples > 0) {
+            ESP_LOGI(TAG, "Link - RSSI min/mean/max: %d/%.1f/%d dBm, Ch: %u, PHY: %u Mbps, "
+                     "Disconnects: %u, Retries: %u, Last reason: %u",
+                     link_summary.rssi_min, link_summary.rssi_mean, link_summary.rssi_max,
+                     link_summary.channel, link_summary.phy_rate_mbps,
+                     link_summary.disconnects, link_summary.retries,
+                     link_summary.last_disconnect_reason);
+        }
+        
+        // Offline buffer and background reconnection
+        sample_buffer_stats_t buffer_stats;
+        sample_buffer_get_stats(&buffer_stats);
+        ESP_LOGI(TAG, "Buffer - Pending: %lu/%lu (%lu B/sample), High water: %lu, Dropped: %lu, "
+                 "Reconnects: %lu",
+                 (unsigned long)buffer_stats.count, (unsigned long)buffer_stats.capacity,
+                 (unsigned long)buffer_stats.bytes_per_sample,
+                 (unsigned long)buffer_stats.high_water, (unsigned long)buffer_stats.dropped,
+                 (unsigned long)wifi_manager_get_reconnect_attempts());
+        
+        // Persistent boot counters
+        boot_guard_counters_t boot_counters;
+        if (boot_guard_get_counters(&boot_counters) == ESP_OK) {
+            ESP_LOGI(TAG, "Boot - Count: %lu, Unstable: %lu, Loops: %lu, Degraded: %lu, "
+                     "Panic: %lu, WDT: %lu, Brownout: %lu",
+                     (unsigned long)boot_counters.boot_count,
+                     (unsigned long)boot_counters.unstable_boots,
+                     (unsigned long)boot_counters.loop_detections,
+                     (unsigned long)boot_counters.degraded_boots,
+                     (unsigned long)boot_counters.panic_resets,
+                     (unsigned long)boot_counters.watchdog_resets,
+                     (unsigned long)boot_counters.brownout_resets);
+        }
+        
+        // Radio activity estimate
+        wifi_radio_stats_t radio_stats;
+        if (wifi_manager_get_radio_stats(&radio_stats) == ESP_OK) {
+            ESP_LOGI(TAG, "Radio - Power save: %d, Bursts: %lu, Est. radio-on: %lu ms/hour",
+                     radio_stats.policy.mode, (unsigned long)radio_stats.tx_bursts,
+                     (unsigned long)radio_stats.radio_on_ms_per_hour);
+        }
+        
+        // Energy estimate
+        if (ENERGY_MODEL_ENABLED) {
+            energy_report_t energy;
+            if (energy_model_get_report(&energy) == ESP_OK) {
+                ESP_LOGI(TAG, "Energy - %.3f mJ/sample over %lu samples, Total: %.1f mJ, Avg: %.2f mA",
+                         energy.mj_per_sample, (unsigned long)energy.delivered_samples,
+                         energy.total_mj,
+                         energy.average_ma);
+                for (int state = 0; state < ENERGY_STATE_MAX; state++) {
+                    ESP_LOGI(TAG, "Energy %-12s Time: %8llu ms, Energy: %9.2f mJ",
+                             energy_model_state_name(state),
+                             (unsigned long long)(energy.time_us[state] / 1000),
+                             energy.energy_mj[state]);
+                }
+            }
         }
         
         // Memory status
-        ESP_LOGI(TAG, "Free heap memory: %lu bytes", esp_get_free_heap_size());
+        mem_stats_snapshot_t mem;
+        mem_stats_get_snapshot(&mem);
+        ESP_LOGI(TAG, "Heap - Free: %lu, Min free: %lu, Largest block: %lu (min %lu), Fragmentation: %u%%",
+                 (unsigned long)mem.heap_free, (unsigned long)mem.heap_min_free,
+                 (unsigned long)mem.heap_largest_block,
+                 (unsigned long)mem.heap_min_largest_block, mem.fragmentation_pct);
+        for (int module = 0; module < MEM_MODULE_MAX; module++) {
+            const mem_module_stats_t *m = &mem.modules[module];
+            ESP_LOGI(TAG, "Heap %s - In use: %lu (%lu estimated), Peak: %lu, Allocs: %lu, Frees: %lu, Failed: %lu",
+                     m->name, (unsigned long)m->bytes_in_use, (unsigned long)m->estimated_bytes,
+                     (unsigned long)m->peak_bytes, (unsigned long)m->alloc_calls,
+                     (unsigned long)m->free_calls, (unsigned long)m->failed_calls);
+        }
+        
+        // CPU share and stack headroom per task
+        task_profile_t profile;
+        if (task_profiler_get_profile(&profile) == ESP_OK) {
+            ESP_LOGI(TAG, "Tasks - CPU load: %u.%u%% over %lu ms, Tasks: %u",
+                     profile.cpu_load_permille / 10, profile.cpu_load_permille % 10,
+                     (unsigned long)profile.window_ms, profile.task_count);
+            for (int i = 0; i < profile.task_count; i++) {
+                const task_profile_entry_t *task = &profile.tasks[i];
+                ESP_LOGI(TAG, "Task %-16s CPU: %2u.%u%%, Min free stack: %5lu B, Priority: %u",
+                         task->name, task->cpu_permille / 10, task->cpu_permille % 10,
+                         (unsigned long)task->stack_free_min, task->priority);
+            }
+        }
+        
+        // Deferred logging
+        if (DEFERRED_LOG_ENABLED) {
+            deferred_log_stats_t log_stats;
+            deferred_log_get_stats(&log_stats);
+            ESP_LOGI(TAG, "Log - Deferred: %lu, Immediate: %lu, Dropped: %lu, Queue high water: %lu/%lu",
+                     (unsigned long)log_stats.deferred, (unsigned long)log_stats.immediate,
+                     (unsigned long)log_stats.dropped,
+                     (unsigned long)log_stats.high_water, (unsigned long)log_stats.queue_len);
+        }
+        
+        // Prometheus endpoint
+        if (METRICS_SERVER_ENABLED) {
+            metrics_server_stats_t metrics_stats;
+            metrics_server_get_stats(&metrics_stats);
+            ESP_LOGI(TAG, "Metrics - Scrapes: %lu, Errors: %lu, Last: %lu bytes in %lu us",
+                     (unsigned long)metrics_stats.scrapes, (unsigned long)metrics_stats.errors,
+                     (unsigned long)metrics_stats.last_bytes,
+                     (unsigned long)metrics_stats.last_render_us);
+        }
+        
+        // Export new trace events (decode with tools/trace_decode.py)
+        if (TRACE_ENABLED) {
+            trace_stats_t trace_stats;
+            trace_get_stats(&trace_stats);
+            ESP_LOGI(TAG, "Trace - Recorded: %lu, Unread: %lu/%lu, Lost: %lu",
+                     (unsigned long)trace_stats.recorded, (unsigned long)trace_stats.unread,
+                     (unsigned long)trace_stats.capacity, (unsigned long)trace_stats.lost);
+            if (TRACE_DUMP_SERIAL) {
+                trace_dump();
+            } else if (TRACE_UPLOAD_ENABLED && wifi_manager_is_connected()) {
+                esp_err_t ret = http_client_post_trace(TRACE_UPLOAD_URL);
+                if (ret != ESP_OK) {
+                    ESP_LOGW(TAG, "Trace upload failed: %s", esp_err_to_name(ret));
+                }
+            }
+        }
         
         ESP_LOGI(TAG, "=== End Status Report ===");
     }
@@ -242,24 +646,91 @@ static void display_application_status(void)
  */
 void app_main(void)
 {
+#if DUTY_CYCLE_ENABLED
+    // Every deep-sleep wake starts here; only returns on the linux target
+    while (1) {
+        run_duty_cycle_wake();
+    }
+#endif
+    
+    // Per-cycle logging is written by a low-priority task from here on
+    if (deferred_log_start() != ESP_OK) {
+        ESP_LOGW(TAG, "Deferred logging unavailable, logging synchronously");
+    }
+    
     ESP_LOGI(TAG, "=== ESP32 TCP Client - Modular Architecture ===");
     ESP_LOGI(TAG, "Application: %s v%s", APP_NAME, APP_VERSION);
     ESP_LOGI(TAG, "Compiled: %s %s", __DATE__, __TIME__);
     ESP_LOGI(TAG, "ESP-IDF Version: %s", esp_get_idf_version());
     
-    // Step 1: Initialize NVS Flash
-    ESP_ERROR_CHECK(init_nvs_flash());
+    // Step 1: Initialize NVS and services while WiFi association runs. A
+    // failing stage leaves the application running degraded.
+    esp_err_t boot_ret = boot_orchestrator_run();
+    if (boot_ret != ESP_OK) {
+        ESP_LOGW(TAG, "Boot incomplete (%s), continuing degraded", esp_err_to_name(boot_ret));
+    }
     
-    // Step 2: Initialize all application services
-    ESP_ERROR_CHECK(init_application_services());
+    // Step 2: Wait for the WiFi connection started during boot. Without a
+    // connection the application runs degraded: samples are buffered and
+    // the connection is retried in the background.
+    wifi_manager_set_auto_reconnect(true);
+    if (boot_guard_loop_detected() || connect_to_wifi() != ESP_OK) {
+        ESP_LOGW(TAG, "Starting in degraded mode, connection will be retried in background");
+        boot_guard_mark_degraded();
+    }
     
-    // Step 3: Connect to WiFi
-    ESP_ERROR_CHECK(connect_to_wifi());
+    // Step 3: Decouple sampling from network I/O if configured
+    if (AGGREGATION_ENABLED) {
+        aggregator_init();
+    }
+    if (REPORT_FILTER_ENABLED) {
+        report_filter_init();
+    }
+    if (SIM_BENCHMARK_ENABLED) {
+        const sim_signal_config_t bench_config = {
+            .waveform = SIM_WAVE_SINE,
+            .offset = TEMP_SIMULATION_BASE,
+            .amplitude = TEMP_SIMULATION_VARIATION,
+            .period_ms = (uint32_t)(TEMP_SIMULATION_PERIOD * 1000)
+        };
+        sim_signal_bench_t bench;
+        sim_signal_benchmark(&bench_config, SIM_BENCHMARK_ITERATIONS, &bench);
+    }
+    if (DSP_SELF_CHECK_ENABLED && dsp_self_check(NULL) != ESP_OK) {
+        ESP_LOGW(TAG, "DSP kernels (%s) deviate from reference", dsp_backend_name());
+    }
+    if (ADC_PIPELINE_ENABLED) {
+        esp_err_t ret = adc_pipeline_start();
+        if (ret == ESP_OK) {
+            sensor_service_register_driver(adc_pipeline_get_driver());
+        } else {
+            ESP_LOGW(TAG, "ADC pipeline unavailable: %s", esp_err_to_name(ret));
+        }
+    }
+    if (SAMPLER_RATE_HZ > 0) {
+        esp_err_t ret = sensor_service_start_sampler(SAMPLER_RATE_HZ);
+        if (ret == ESP_OK) {
+            s_sampler_started = true;
+        } else {
+            ESP_LOGW(TAG, "Background sampler unavailable: %s", esp_err_to_name(ret));
+        }
+    }
+    if (TASK_PROFILER_ENABLED) {
+        esp_err_t ret = task_profiler_start(TASK_PROFILER_INTERVAL_MS);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Task profiler unavailable: %s", esp_err_to_name(ret));
+        }
+    }
+    if (METRICS_SERVER_ENABLED && metrics_server_start(METRICS_SERVER_PORT) != ESP_OK) {
+        ESP_LOGW(TAG, "Metrics endpoint unavailable");
+    }
     
     // Step 4: Display configuration information
     ESP_LOGI(TAG, "=== Configuration ===");
     ESP_LOGI(TAG, "API Endpoint: %s", API_ENDPOINT);
     ESP_LOGI(TAG, "Transmission Interval: %d seconds", POST_INTERVAL_SEC);
+    ESP_LOGI(TAG, "Upload Batch Size: %d samples", UPLOAD_BATCH_SIZE);
+    ESP_LOGI(TAG, "Offline Buffer Size: %d samples", OFFLINE_BUFFER_SIZE);
     ESP_LOGI(TAG, "WiFi SSID: %s", WIFI_SSID);
     ESP_LOGI(TAG, "=== Starting Data Transmission Loop ===");
     
@@ -267,16 +738,19 @@ void app_main(void)
     uint32_t cycle_count = 0;
     while (1) {
         cycle_count++;
-        ESP_LOGI(TAG, "=== Cycle %lu ===", cycle_count);
+        DLOG_I(TAG, "=== Cycle %lu ===", (unsigned long)cycle_count);
         
         // Perform data transmission
         esp_err_t transmission_result = perform_data_transmission();
         
+        // A boot that survives long enough no longer counts towards a reboot loop
+        boot_guard_mark_stable();
+        
         // Display status information periodically
         display_application_status();
         
         // Log next transmission time
-        ESP_LOGI(TAG, "Next transmission in %d seconds...", POST_INTERVAL_SEC);
+        DLOG_I(TAG, "Next transmission in %d seconds...", POST_INTERVAL_SEC);
         
         // Wait for the configured interval
         vTaskDelay(MS_TO_TICKS(POST_INTERVAL_MS));
@@ -286,6 +760,7 @@ void app_main(void)
     ESP_LOGI(TAG, "Application shutting down...");
     
     // Cleanup services in reverse order
+    metrics_server_stop();
     http_client_cleanup();
     sensor_service_cleanup();
     wifi_manager_cleanup();
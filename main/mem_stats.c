@@ -0,0 +1,194 @@
+/*
+ * Memory Statistics Implementation
+ * 
+ * Each accounted allocation carries a small header holding its size, so
+ * frees can be accounted without a lookup table. The header is 8 bytes
+ * to keep the returned pointer 8-byte aligned.
+ */
+
+#include "mem_stats.h"
+#include "config.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_heap_caps.h"
+#endif
+
+// Size header in front of every accounted allocation
+typedef union {
+    size_t size;
+    uint64_t align;
+} mem_header_t;
+
+// Module state management
+typedef struct {
+    mem_module_stats_t modules[MEM_MODULE_MAX];
+    uint32_t min_largest_block;
+} mem_stats_context_t;
+
+// Global module context
+static mem_stats_context_t s_context = {
+    .modules = {
+        [MEM_MODULE_HTTP_CLIENT] = { .name = "http" },
+        [MEM_MODULE_SENSOR_SERVICE] = { .name = "sensor" },
+        [MEM_MODULE_JSON] = { .name = "json" },
+    },
+    .min_largest_block = UINT32_MAX,
+};
+
+// Counters are updated from several tasks
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ * Internal function to count an allocation (or a failed one)
+ * 
+ * 'estimated' marks allocations reported by mem_stats_note_alloc(); they
+ * are also added to estimated_bytes in the same critical section.
+ */
+static void count_alloc(mem_module_t module, size_t bytes, bool ok, bool estimated)
+{
+    mem_module_stats_t *stats = &s_context.modules[module];
+    
+    portENTER_CRITICAL(&s_lock);
+    if (ok) {
+        stats->alloc_calls++;
+        stats->bytes_in_use += bytes;
+        if (stats->bytes_in_use > stats->peak_bytes) {
+            stats->peak_bytes = stats->bytes_in_use;
+        }
+        if (estimated) {
+            stats->estimated_bytes += bytes;
+        }
+    } else {
+        stats->failed_calls++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Internal function to count a free
+ */
+static void count_free(mem_module_t module, size_t bytes, bool estimated)
+{
+    mem_module_stats_t *stats = &s_context.modules[module];
+    
+    portENTER_CRITICAL(&s_lock);
+    stats->free_calls++;
+    stats->bytes_in_use = (stats->bytes_in_use > bytes) ? stats->bytes_in_use - bytes : 0;
+    if (estimated) {
+        stats->estimated_bytes = (stats->estimated_bytes > bytes) ? stats->estimated_bytes - bytes : 0;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Allocate Memory for a Module
+ */
+void *mem_stats_malloc(mem_module_t module, size_t size)
+{
+    if (module >= MEM_MODULE_MAX) {
+        return NULL;
+    }
+    
+    mem_header_t *header = malloc(sizeof(mem_header_t) + size);
+    count_alloc(module, size, header != NULL, false);
+    if (!header) {
+        return NULL;
+    }
+    
+    header->size = size;
+    return header + 1;
+}
+
+/*
+ * Allocate Zeroed Memory for a Module
+ */
+void *mem_stats_calloc(mem_module_t module, size_t count, size_t size)
+{
+    if (module >= MEM_MODULE_MAX) {
+        return NULL;
+    }
+    
+    if (size != 0 && count > SIZE_MAX / size) {
+        // Unsatisfiable request: counted like any other failed allocation
+        count_alloc(module, 0, false, false);
+        return NULL;
+    }
+    
+    void *ptr = mem_stats_malloc(module, count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    
+    return ptr;
+}
+
+/*
+ * Free Module Memory
+ */
+void mem_stats_free(mem_module_t module, void *ptr)
+{
+    if (!ptr || module >= MEM_MODULE_MAX) {
+        return;
+    }
+    
+    mem_header_t *header = (mem_header_t *)ptr - 1;
+    count_free(module, header->size, false);
+    free(header);
+}
+
+/*
+ * Account Allocations Made Elsewhere
+ */
+void mem_stats_note_alloc(mem_module_t module, size_t bytes)
+{
+    if (module < MEM_MODULE_MAX) {
+        count_alloc(module, bytes, true, true);
+    }
+}
+
+void mem_stats_note_free(mem_module_t module, size_t bytes)
+{
+    if (module < MEM_MODULE_MAX) {
+        count_free(module, bytes, true);
+    }
+}
+
+/*
+ * Get Memory Snapshot
+ */
+void mem_stats_get_snapshot(mem_stats_snapshot_t *snapshot)
+{
+    if (!snapshot) {
+        return;
+    }
+
+#if CONFIG_IDF_TARGET_LINUX
+    // The host heap is not fragmentation-limited in a meaningful way
+    uint32_t free_bytes = esp_get_free_heap_size();
+    uint32_t largest = free_bytes;
+    uint32_t min_free = esp_get_minimum_free_heap_size();
+#else
+    uint32_t free_bytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint32_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    uint32_t min_free = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+#endif
+    
+    portENTER_CRITICAL(&s_lock);
+    if (largest < s_context.min_largest_block) {
+        s_context.min_largest_block = largest;
+    }
+    memcpy(snapshot->modules, s_context.modules, sizeof(snapshot->modules));
+    snapshot->heap_min_largest_block = s_context.min_largest_block;
+    portEXIT_CRITICAL(&s_lock);
+    
+    snapshot->heap_free = free_bytes;
+    snapshot->heap_min_free = min_free;
+    snapshot->heap_largest_block = largest;
+    snapshot->fragmentation_pct = (free_bytes > 0 && largest <= free_bytes) ?
+                                  (uint8_t)(100 - (uint64_t)largest * 100 / free_bytes) : 0;
+}
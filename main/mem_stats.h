@@ -0,0 +1,141 @@
+/*
+ * Memory Statistics Module
+ * 
+ * Per-module heap accounting and heap health tracking. Modules allocate
+ * through mem_stats_malloc()/mem_stats_free() with their module id, which
+ * keeps allocation and free calls, bytes in use, peak bytes and failed
+ * allocations per module. Allocations made inside ESP-IDF components
+ * (HTTP client buffers, task stacks) are attributed with
+ * mem_stats_note_alloc()/mem_stats_note_free() using the sizes the module
+ * requested. The component's own bookkeeping is not included, so that
+ * part is an estimate and is also reported separately (estimated_bytes).
+ * 
+ * Alongside the counters, the snapshot reports the free heap, the
+ * minimum free heap since boot, the largest free block and the smallest
+ * largest block seen, which together show whether the heap is
+ * fragmenting long before an allocation fails.
+ * 
+ * Features:
+ * - Allocation calls, bytes in use, peak and failures per module
+ * - Free / minimum-ever free / largest block / fragmentation tracking
+ * - Lock-protected counters usable from any task
+ * 
+ * Usage:
+ *   char *buffer = mem_stats_malloc(MEM_MODULE_HTTP_CLIENT, 512);
+ *   ...
+ *   mem_stats_free(MEM_MODULE_HTTP_CLIENT, buffer);
+ * 
+ *   mem_stats_snapshot_t snapshot;
+ *   mem_stats_get_snapshot(&snapshot);
+ */
+
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Accounted Modules
+ */
+typedef enum {
+    MEM_MODULE_HTTP_CLIENT = 0,          // HTTP client buffers and esp_http_client handles
+    MEM_MODULE_SENSOR_SERVICE,           // Sensor service (background sampler)
+    MEM_MODULE_JSON,                     // cJSON trees and printed payloads
+    MEM_MODULE_MAX
+} mem_module_t;
+
+/*
+ * Counters of One Module
+ */
+typedef struct {
+    const char *name;                    // Short module name for logs
+    uint32_t alloc_calls;                // Successful allocations
+    uint32_t free_calls;                 // Frees
+    uint32_t failed_calls;               // Allocations that returned NULL
+    uint32_t bytes_in_use;               // Bytes currently allocated
+    uint32_t peak_bytes;                 // Largest bytes_in_use seen
+    uint32_t estimated_bytes;            // Part of bytes_in_use noted by size (estimate)
+} mem_module_stats_t;
+
+/*
+ * Memory Snapshot
+ */
+typedef struct {
+    mem_module_stats_t modules[MEM_MODULE_MAX];
+    uint32_t heap_free;                  // Free heap now
+    uint32_t heap_min_free;              // Lowest free heap since boot
+    uint32_t heap_largest_block;         // Largest allocatable block now
+    uint32_t heap_min_largest_block;     // Smallest largest block seen by snapshots
+    uint8_t fragmentation_pct;           // 100 - largest block / free heap, in percent
+} mem_stats_snapshot_t;
+
+/*
+ * Allocate Memory for a Module
+ * 
+ * Parameters:
+ *   module: Module the memory is accounted to
+ *   size: Bytes to allocate
+ * 
+ * Returns:
+ *   Pointer to the memory, or NULL (counted as a failed allocation).
+ *   Must be released with mem_stats_free() and the same module.
+ */
+void *mem_stats_malloc(mem_module_t module, size_t size);
+
+/*
+ * Allocate Zeroed Memory for a Module
+ * 
+ * Parameters:
+ *   module: Module the memory is accounted to
+ *   count: Number of elements
+ *   size: Element size
+ * 
+ * Returns:
+ *   Pointer to the memory, or NULL
+ */
+void *mem_stats_calloc(mem_module_t module, size_t count, size_t size);
+
+/*
+ * Free Module Memory
+ * 
+ * Parameters:
+ *   module: Module the memory was allocated for
+ *   ptr: Memory from mem_stats_malloc()/mem_stats_calloc() (NULL is ignored)
+ */
+void mem_stats_free(mem_module_t module, void *ptr);
+
+/*
+ * Account Allocations Made Elsewhere
+ * 
+ * For memory a module causes to be allocated inside another component,
+ * given as the size the module requested (buffer size, stack size).
+ * Counted in bytes_in_use and in estimated_bytes. Do not pass free-heap
+ * deltas: other tasks allocate at the same time.
+ * 
+ * Parameters:
+ *   module: Module the memory is accounted to
+ *   bytes: Bytes allocated or released
+ */
+void mem_stats_note_alloc(mem_module_t module, size_t bytes);
+void mem_stats_note_free(mem_module_t module, size_t bytes);
+
+/*
+ * Get Memory Snapshot
+ * 
+ * Samples the heap and copies the module counters.
+ * 
+ * Parameters:
+ *   snapshot: Pointer to mem_stats_snapshot_t structure to populate
+ */
+void mem_stats_get_snapshot(mem_stats_snapshot_t *snapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEM_STATS_H
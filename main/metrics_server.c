@@ -0,0 +1,408 @@
+/*
+ * Metrics Server Implementation
+ * 
+ * Scrapes run in the HTTP server task. Every metric line is formatted
+ * straight into s_chunk; a line that does not fit flushes the chunk to
+ * the socket first. The server handles one request at a time, so the
+ * single chunk buffer is never shared.
+ */
+
+#include "metrics_server.h"
+#include "config.h"
+#include "energy_model.h"
+#include "http_client.h"
+#include "sensor_service.h"
+#include "stats_block.h"
+#include "wifi_manager.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_http_server.h"
+
+static const char *TAG = "METRICS";
+
+// Every metric name starts with this prefix
+#define METRICS_PREFIX             "tcp_client_"
+
+// Prometheus text exposition format
+#define METRICS_CONTENT_TYPE       "text/plain; version=0.0.4; charset=utf-8"
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    METRICS_STAT_SCRAPES = 0,
+    METRICS_STAT_ERRORS,
+    METRICS_STAT_TRUNCATED_LINES,
+    METRICS_STAT_LAST_BYTES,
+    METRICS_STAT_LAST_RENDER_US,
+    METRICS_STAT_COUNT
+} metrics_stat_t;
+
+// Updated by the HTTP server task, read by the main task
+STATS_BLOCK_DEFINE(s_stats, METRICS_STAT_COUNT);
+
+// Module state management
+typedef struct {
+    httpd_handle_t server;
+    uint16_t port;
+} metrics_server_context_t;
+
+// Global module context
+static metrics_server_context_t s_context;
+
+// Response chunk being rendered
+static char s_chunk[METRICS_CHUNK_SIZE];
+
+// Latency histogram bucket bounds (see http_client.h)
+static const uint32_t s_latency_bounds_ms[HTTP_LATENCY_BUCKETS - 1] = HTTP_LATENCY_BOUNDS_MS;
+
+// Rendering state of one scrape
+typedef struct {
+    httpd_req_t *req;
+    size_t used;                         // Bytes of s_chunk filled
+    size_t total;                        // Bytes sent so far
+    esp_err_t err;                       // First send error
+} metrics_writer_t;
+
+/*
+ * Internal function to send the filled part of the chunk
+ */
+static void writer_flush(metrics_writer_t *w)
+{
+    if (w->used > 0 && w->err == ESP_OK) {
+        w->err = httpd_resp_send_chunk(w->req, s_chunk, (ssize_t)w->used);
+        w->total += w->used;
+    }
+    w->used = 0;
+}
+
+/*
+ * Internal function to append one formatted line
+ */
+static void __attribute__((format(printf, 2, 3)))
+writer_printf(metrics_writer_t *w, const char *format, ...)
+{
+    // Second attempt after flushing the chunk the line did not fit into
+    for (int attempt = 0; attempt < 2 && w->err == ESP_OK; attempt++) {
+        size_t room = sizeof(s_chunk) - w->used;
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(s_chunk + w->used, room, format, args);
+        va_end(args);
+        
+        if (len < 0) {
+            return;
+        }
+        if ((size_t)len < room) {
+            w->used += (size_t)len;
+            return;
+        }
+        if (w->used == 0) {
+            stats_inc(&s_stats, METRICS_STAT_TRUNCATED_LINES);  // Longer than the whole chunk, dropped
+            return;
+        }
+        writer_flush(w);
+    }
+}
+
+/*
+ * Internal function to write the HELP and TYPE lines of a metric family
+ */
+static void write_family(metrics_writer_t *w, const char *name, const char *type, const char *help)
+{
+    writer_printf(w, "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s %s\n",
+                  name, help, name, type);
+}
+
+/*
+ * Internal function to write an unlabelled integer metric with its family
+ */
+static void write_int(metrics_writer_t *w, const char *name, const char *type,
+                      const char *help, unsigned long long value)
+{
+    write_family(w, name, type, help);
+    writer_printf(w, METRICS_PREFIX "%s %llu\n", name, value);
+}
+
+/*
+ * Internal function to write system metrics
+ */
+static void render_system(metrics_writer_t *w)
+{
+    write_family(w, "uptime_seconds", "gauge", "Time since boot.");
+    writer_printf(w, METRICS_PREFIX "uptime_seconds %.3f\n", esp_timer_get_time() / 1e6);
+    write_int(w, "heap_free_bytes", "gauge", "Free heap.",
+              esp_get_free_heap_size());
+    write_int(w, "heap_min_free_bytes", "gauge", "Lowest free heap since boot.",
+              esp_get_minimum_free_heap_size());
+}
+
+/*
+ * Internal function to write HTTP client metrics
+ */
+static void render_http(metrics_writer_t *w)
+{
+    http_client_stats_t stats;
+    if (http_client_get_stats(&stats) != ESP_OK) {
+        return;
+    }
+    
+    write_family(w, "http_requests_total", "counter", "Upload requests by result.");
+    writer_printf(w, METRICS_PREFIX "http_requests_total{result=\"success\"} %lu\n",
+                  (unsigned long)stats.successful_requests);
+    writer_printf(w, METRICS_PREFIX "http_requests_total{result=\"failure\"} %lu\n",
+                  (unsigned long)stats.failed_requests);
+    write_int(w, "http_timeouts_total", "counter", "Requests that timed out.",
+              stats.timeout_count);
+    write_int(w, "http_network_errors_total", "counter", "Transport errors.",
+              stats.network_errors);
+    write_int(w, "http_request_bytes_total", "counter", "Request body bytes sent.",
+              stats.bytes_sent);
+    write_int(w, "http_last_status_code", "gauge", "HTTP status of the last response.",
+              (unsigned long long)(stats.last_status_code > 0 ? stats.last_status_code : 0));
+    
+    // Buckets are stored per range; Prometheus expects cumulative counts
+    write_family(w, "http_request_duration_seconds", "histogram", "Upload request duration.");
+    uint32_t cumulative = 0;
+    for (int i = 0; i < HTTP_LATENCY_BUCKETS - 1; i++) {
+        cumulative += stats.latency_buckets[i];
+        writer_printf(w, METRICS_PREFIX "http_request_duration_seconds_bucket{le=\"%g\"} %lu\n",
+                      s_latency_bounds_ms[i] / 1000.0, (unsigned long)cumulative);
+    }
+    cumulative += stats.latency_buckets[HTTP_LATENCY_BUCKETS - 1];
+    writer_printf(w, METRICS_PREFIX "http_request_duration_seconds_bucket{le=\"+Inf\"} %lu\n",
+                  (unsigned long)cumulative);
+    writer_printf(w, METRICS_PREFIX "http_request_duration_seconds_sum %.6f\n",
+                  stats.latency_sum_us / 1e6);
+    writer_printf(w, METRICS_PREFIX "http_request_duration_seconds_count %lu\n",
+                  (unsigned long)cumulative);
+}
+
+/*
+ * Internal function to write sensor service metrics
+ */
+static void render_sensors(metrics_writer_t *w)
+{
+    sensor_status_t status;
+    if (sensor_service_get_status(&status) != ESP_OK) {
+        return;
+    }
+    
+    write_int(w, "sensor_reads_total", "counter", "Successful sensor service reads.",
+              status.read_count);
+    write_int(w, "sensor_read_errors_total", "counter", "Failed sensor service reads.",
+              status.error_count);
+    
+    write_family(w, "sensor_driver_reads_total", "counter", "Driver read calls per sensor.");
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const sensor_driver_t *driver = sensor_service_get_driver(type);
+        if (driver) {
+            writer_printf(w, METRICS_PREFIX "sensor_driver_reads_total{sensor=\"%s\"} %lu\n",
+                          driver->name, (unsigned long)status.driver_reads[type]);
+        }
+    }
+    write_family(w, "sensor_driver_read_avg_seconds", "gauge", "Average cost of one driver read.");
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const sensor_driver_t *driver = sensor_service_get_driver(type);
+        if (driver) {
+            writer_printf(w, METRICS_PREFIX "sensor_driver_read_avg_seconds{sensor=\"%s\"} %.9f\n",
+                          driver->name, status.driver_read_ns[type] / 1e9);
+        }
+    }
+    
+    if (status.sampler_running) {
+        write_int(w, "sampler_records_total", "counter", "Records produced by the sampler.",
+                  status.sampler_records);
+        write_int(w, "sampler_overflows_total", "counter", "Records dropped on a full ring.",
+                  status.sampler_overflows);
+        write_int(w, "sampler_pending_records", "gauge", "Records waiting to be drained.",
+                  status.sampler_pending);
+        write_int(w, "sampler_high_water_records", "gauge", "Largest ring fill level seen.",
+                  status.sampler_high_water);
+    }
+}
+
+/*
+ * Internal function to write WiFi manager metrics
+ */
+static void render_wifi(metrics_writer_t *w)
+{
+    bool connected = wifi_manager_is_connected();
+    write_int(w, "wifi_connected", "gauge", "1 while associated with an IP address.", connected);
+    
+    int8_t rssi;
+    if (connected && wifi_manager_get_rssi(&rssi) == ESP_OK) {
+        write_family(w, "wifi_rssi_dbm", "gauge", "Signal strength.");
+        writer_printf(w, METRICS_PREFIX "wifi_rssi_dbm %d\n", rssi);
+    }
+    
+    // Read without resetting the window (uploads own it)
+    wifi_link_summary_t link;
+    if (wifi_manager_get_link_summary(&link, false) == ESP_OK) {
+        write_int(w, "wifi_channel", "gauge", "Primary channel.", link.channel);
+        write_int(w, "wifi_disconnects_total", "counter", "Disconnect events.",
+                  link.total_disconnects);
+        write_int(w, "wifi_retries_total", "counter", "Connection retries.",
+                  link.total_retries);
+    }
+    
+    wifi_radio_stats_t radio;
+    if (wifi_manager_get_radio_stats(&radio) == ESP_OK) {
+        write_int(w, "wifi_tx_bursts_total", "counter", "Transmit bursts.", radio.tx_bursts);
+        write_int(w, "wifi_radio_on_ms_per_hour", "gauge", "Estimated radio-on time per hour.",
+                  radio.radio_on_ms_per_hour);
+    }
+}
+
+/*
+ * Internal function to write energy model metrics
+ */
+static void render_energy(metrics_writer_t *w)
+{
+    energy_report_t energy;
+    if (!ENERGY_MODEL_ENABLED || energy_model_get_report(&energy) != ESP_OK) {
+        return;
+    }
+    
+    write_family(w, "energy_state_seconds_total", "counter", "Time spent in each power state.");
+    for (int state = 0; state < ENERGY_STATE_MAX; state++) {
+        writer_printf(w, METRICS_PREFIX "energy_state_seconds_total{state=\"%s\"} %.3f\n",
+                      energy_model_state_name(state), energy.time_us[state] / 1e6);
+    }
+    write_family(w, "energy_millijoules_total", "counter", "Estimated energy per power state.");
+    for (int state = 0; state < ENERGY_STATE_MAX; state++) {
+        writer_printf(w, METRICS_PREFIX "energy_millijoules_total{state=\"%s\"} %.3f\n",
+                      energy_model_state_name(state), energy.energy_mj[state]);
+    }
+    write_int(w, "energy_delivered_samples_total", "counter", "Samples accepted by the backend.",
+              energy.delivered_samples);
+    write_family(w, "energy_per_sample_millijoules", "gauge", "Estimated energy per delivered sample.");
+    writer_printf(w, METRICS_PREFIX "energy_per_sample_millijoules %.4f\n", energy.mj_per_sample);
+}
+
+/*
+ * Internal function to render all metrics
+ */
+static void render_metrics(metrics_writer_t *w)
+{
+    render_system(w);
+    render_http(w);
+    render_sensors(w);
+    render_wifi(w);
+    render_energy(w);
+    write_int(w, "metrics_scrapes_total", "counter", "Completed scrapes of this endpoint.",
+              stats_get(&s_stats, METRICS_STAT_SCRAPES));
+}
+
+/*
+ * GET /metrics handler
+ */
+static esp_err_t metrics_get_handler(httpd_req_t *req)
+{
+    int64_t start_us = esp_timer_get_time();
+    metrics_writer_t writer = {
+        .req = req,
+        .err = ESP_OK,
+    };
+    
+    httpd_resp_set_type(req, METRICS_CONTENT_TYPE);
+    render_metrics(&writer);
+    writer_flush(&writer);
+    if (writer.err == ESP_OK) {
+        writer.err = httpd_resp_send_chunk(req, NULL, 0);
+    }
+    
+    if (writer.err != ESP_OK) {
+        // Returning an error makes the server close the socket
+        stats_inc(&s_stats, METRICS_STAT_ERRORS);
+        ESP_LOGW(TAG, "Scrape aborted: %s", esp_err_to_name(writer.err));
+        return ESP_FAIL;
+    }
+    
+    stats_update_begin(&s_stats);
+    stats_inc(&s_stats, METRICS_STAT_SCRAPES);
+    stats_set(&s_stats, METRICS_STAT_LAST_BYTES, (uint32_t)writer.total);
+    stats_set(&s_stats, METRICS_STAT_LAST_RENDER_US, (uint32_t)(esp_timer_get_time() - start_us));
+    stats_update_end(&s_stats);
+    return ESP_OK;
+}
+
+/*
+ * Start Metrics Server
+ */
+esp_err_t metrics_server_start(uint16_t port)
+{
+    if (s_context.server != NULL) {
+        return ESP_OK;
+    }
+    
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = port;
+    config.task_priority = METRICS_SERVER_TASK_PRIORITY;
+    config.stack_size = TASK_STACK_SIZE;
+    config.max_open_sockets = METRICS_SERVER_MAX_SOCKETS;
+    config.lru_purge_enable = true;
+    
+    esp_err_t ret = httpd_start(&s_context.server, &config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start HTTP server on port %u: %s", port, esp_err_to_name(ret));
+        s_context.server = NULL;
+        return ESP_FAIL;
+    }
+    
+    const httpd_uri_t metrics_uri = {
+        .uri = METRICS_SERVER_PATH,
+        .method = HTTP_GET,
+        .handler = metrics_get_handler,
+        .user_ctx = NULL,
+    };
+    ret = httpd_register_uri_handler(s_context.server, &metrics_uri);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register %s: %s", METRICS_SERVER_PATH, esp_err_to_name(ret));
+        httpd_stop(s_context.server);
+        s_context.server = NULL;
+        return ESP_FAIL;
+    }
+    
+    s_context.port = port;
+    ESP_LOGI(TAG, "Serving Prometheus metrics on port %u%s", port, METRICS_SERVER_PATH);
+    return ESP_OK;
+}
+
+/*
+ * Stop Metrics Server
+ */
+esp_err_t metrics_server_stop(void)
+{
+    if (s_context.server == NULL) {
+        return ESP_OK;
+    }
+    
+    httpd_stop(s_context.server);
+    s_context.server = NULL;
+    return ESP_OK;
+}
+
+/*
+ * Get Metrics Server Statistics
+ */
+void metrics_server_get_stats(metrics_server_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    uint32_t values[METRICS_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    stats->running = (s_context.server != NULL);
+    stats->port = s_context.port;
+    stats->scrapes = values[METRICS_STAT_SCRAPES];
+    stats->errors = values[METRICS_STAT_ERRORS];
+    stats->truncated_lines = values[METRICS_STAT_TRUNCATED_LINES];
+    stats->last_bytes = values[METRICS_STAT_LAST_BYTES];
+    stats->last_render_us = values[METRICS_STAT_LAST_RENDER_US];
+}
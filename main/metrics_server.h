@@ -0,0 +1,105 @@
+/*
+ * Metrics Server Module
+ * 
+ * Serves the device's counters, gauges and histograms on an embedded HTTP
+ * server in the Prometheus text exposition format, so a monitoring stack
+ * can scrape every device directly instead of reading serial logs or
+ * waiting for uploads.
+ * 
+ * Each scrape renders the metrics of http_client, sensor_service and
+ * wifi_manager (plus heap and uptime) line by line into one fixed chunk
+ * buffer. Full chunks are sent with chunked transfer encoding as they
+ * fill, so the response can be larger than the buffer and a scrape
+ * allocates nothing.
+ * 
+ * Exposed metrics (prefix tcp_client_):
+ * - uptime_seconds, heap_free_bytes, heap_min_free_bytes
+ * - http_requests_total{result}, http_timeouts_total,
+ *   http_network_errors_total, http_request_bytes_total,
+ *   http_last_status_code, http_request_duration_seconds (histogram)
+ * - sensor_reads_total, sensor_read_errors_total,
+ *   sensor_driver_reads_total{sensor}, sensor_driver_read_avg_seconds{sensor},
+ *   sampler_records_total, sampler_overflows_total,
+ *   sampler_pending_records, sampler_high_water_records
+ * - wifi_connected, wifi_rssi_dbm, wifi_channel, wifi_tx_bursts_total,
+ *   wifi_radio_on_ms_per_hour, wifi_disconnects_total, wifi_retries_total
+ * - metrics_scrapes_total
+ * 
+ * Features:
+ * - Prometheus text format 0.0.4 on GET /metrics
+ * - Incremental rendering into a fixed buffer (no heap per scrape)
+ * - Scrape count, size and render time statistics
+ * 
+ * Usage:
+ *   metrics_server_start(9100);
+ * 
+ *   # prometheus.yml
+ *   - job_name: esp32
+ *     static_configs:
+ *       - targets: ['192.168.1.50:9100']
+ */
+
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Path the metrics are served on
+#define METRICS_SERVER_PATH        "/metrics"
+
+/*
+ * Metrics Server Statistics
+ */
+typedef struct {
+    bool running;                        // Server listening
+    uint16_t port;                       // TCP port
+    uint32_t scrapes;                    // Completed scrapes
+    uint32_t errors;                     // Scrapes aborted by a send error
+    uint32_t truncated_lines;            // Lines longer than the chunk buffer
+    uint32_t last_bytes;                 // Size of the last response
+    uint32_t last_render_us;             // Time taken by the last scrape
+} metrics_server_stats_t;
+
+/*
+ * Start Metrics Server
+ * 
+ * Starts the HTTP server and registers GET /metrics. The network stack
+ * must be initialized (wifi_manager_init()); the server keeps listening
+ * across WiFi reconnects.
+ * 
+ * Parameters:
+ *   port: TCP port to listen on
+ * 
+ * Returns:
+ *   ESP_OK: Server started (or already running)
+ *   ESP_FAIL: Server could not be started
+ */
+esp_err_t metrics_server_start(uint16_t port);
+
+/*
+ * Stop Metrics Server
+ * 
+ * Returns:
+ *   ESP_OK: Server stopped (or not running)
+ */
+esp_err_t metrics_server_stop(void);
+
+/*
+ * Get Metrics Server Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to metrics_server_stats_t structure to populate
+ */
+void metrics_server_get_stats(metrics_server_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // METRICS_SERVER_H
@@ -0,0 +1,211 @@
+/*
+ * Report Filter Implementation
+ * 
+ * Keeps the last reported value and report time of every sensor and
+ * compares new samples against them.
+ */
+
+#include "report_filter.h"
+#include "config.h"
+#include "stats_block.h"
+
+#include <math.h>
+#include <string.h>
+#include "esp_log.h"
+
+// Module logging tag
+static const char *TAG = "REPORT_FILTER";
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    FILTER_STAT_SAMPLES = 0,
+    FILTER_STAT_PASSED,
+    FILTER_STAT_SUPPRESSED,
+    FILTER_STAT_HEARTBEATS,
+    FILTER_STAT_TRIGGERS,                // Per type
+    FILTER_STAT_COUNT = FILTER_STAT_TRIGGERS + SENSOR_TYPE_MAX
+} filter_stat_t;
+
+// Updated by the filtering task, read by status and metrics
+STATS_BLOCK_DEFINE(s_stats, FILTER_STAT_COUNT);
+
+// Reference state of one sensor
+typedef struct {
+    report_filter_config_t config;
+    bool has_reference;
+    float reference;                     // Last reported value
+    int64_t reported_us;                 // Time of the last report
+} filter_sensor_t;
+
+// Module state management
+typedef struct {
+    filter_sensor_t sensors[SENSOR_TYPE_MAX];
+} report_filter_context_t;
+
+// Global module context
+static report_filter_context_t s_context;
+
+/*
+ * Internal function to read a numeric sensor value as float
+ * 
+ * Returns false for sensors that do not take part in filtering.
+ */
+static bool numeric_value(sensor_type_t type, const sensor_value_t *value, float *out)
+{
+    const sensor_driver_t *driver = sensor_service_get_driver(type);
+    if (!driver || driver->encoding != SENSOR_ENCODING_NUMBER) {
+        return false;
+    }
+    
+    switch (driver->value_type) {
+        case SENSOR_VALUE_FLOAT:
+            *out = value->f;
+            return true;
+        case SENSOR_VALUE_INT:
+            *out = (float)value->i;
+            return true;
+        case SENSOR_VALUE_UINT:
+            *out = (float)value->u;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+ * Initialize Report Filter
+ */
+esp_err_t report_filter_init(void)
+{
+    memset(&s_context, 0, sizeof(s_context));
+    stats_reset(&s_stats);
+    
+    const report_filter_config_t defaults = {
+        .abs_deadband = REPORT_DEADBAND_ABS,
+        .rel_deadband = REPORT_DEADBAND_REL,
+        .heartbeat_ms = REPORT_HEARTBEAT_SEC * 1000
+    };
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        s_context.sensors[type].config = defaults;
+    }
+    
+    ESP_LOGI(TAG, "Report filter: deadband %.3f / %.1f%%, heartbeat %d s",
+             defaults.abs_deadband, defaults.rel_deadband * 100.0f, REPORT_HEARTBEAT_SEC);
+    return ESP_OK;
+}
+
+/*
+ * Configure Sensor Filter
+ */
+esp_err_t report_filter_configure(sensor_type_t sensor_type, const report_filter_config_t *config)
+{
+    if (sensor_type >= SENSOR_TYPE_MAX || !config) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    s_context.sensors[sensor_type].config = *config;
+    return ESP_OK;
+}
+
+/*
+ * Internal function to count a filtered sample
+ * 
+ * The sample, its outcome and its triggers are counted in one group, so
+ * a snapshot always has samples == passed + suppressed.
+ */
+static void record_outcome(filter_stat_t outcome, bool heartbeat, uint32_t trigger_mask)
+{
+    stats_update_begin(&s_stats);
+    stats_inc(&s_stats, FILTER_STAT_SAMPLES);
+    stats_inc(&s_stats, outcome);
+    if (heartbeat) {
+        stats_inc(&s_stats, FILTER_STAT_HEARTBEATS);
+    }
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (trigger_mask & (1u << type)) {
+            stats_inc(&s_stats, FILTER_STAT_TRIGGERS + type);
+        }
+    }
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Filter Sample
+ */
+bool report_filter_accept(const sensor_data_t *data)
+{
+    if (!data) {
+        return false;
+    }
+    
+    int64_t now = (int64_t)data->timestamp_us;
+    bool report = false;
+    bool heartbeat = false;
+    float values[SENSOR_TYPE_MAX];
+    uint32_t numeric_mask = 0;
+    uint32_t trigger_mask = 0;
+    
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (!(data->valid_mask & (1u << type)) || !numeric_value(type, &data->values[type], &values[type])) {
+            continue;
+        }
+        numeric_mask |= 1u << type;
+        
+        const filter_sensor_t *sensor = &s_context.sensors[type];
+        if (!sensor->has_reference) {
+            report = true;
+            continue;
+        }
+        
+        float band = fmaxf(sensor->config.abs_deadband, sensor->config.rel_deadband * fabsf(sensor->reference));
+        if (fabsf(values[type] - sensor->reference) > band) {
+            trigger_mask |= 1u << type;
+            report = true;
+        } else if (sensor->config.heartbeat_ms != 0 &&
+                   now - sensor->reported_us >= (int64_t)sensor->config.heartbeat_ms * 1000) {
+            heartbeat = true;
+        }
+    }
+    
+    // Samples without numeric sensors are never filtered
+    if (numeric_mask == 0) {
+        report = true;
+    }
+    
+    if (!report && !heartbeat) {
+        record_outcome(FILTER_STAT_SUPPRESSED, false, trigger_mask);
+        return false;
+    }
+    
+    // The reported sample becomes the reference of every sensor it carries
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (numeric_mask & (1u << type)) {
+            filter_sensor_t *sensor = &s_context.sensors[type];
+            sensor->has_reference = true;
+            sensor->reference = values[type];
+            sensor->reported_us = now;
+        }
+    }
+    
+    record_outcome(FILTER_STAT_PASSED, !report, trigger_mask);
+    return true;
+}
+
+/*
+ * Get Filter Statistics
+ */
+void report_filter_get_stats(report_filter_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    uint32_t values[FILTER_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    stats->samples = values[FILTER_STAT_SAMPLES];
+    stats->passed = values[FILTER_STAT_PASSED];
+    stats->suppressed = values[FILTER_STAT_SUPPRESSED];
+    stats->heartbeats = values[FILTER_STAT_HEARTBEATS];
+    memcpy(stats->triggers, &values[FILTER_STAT_TRIGGERS], sizeof(stats->triggers));
+}
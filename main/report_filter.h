@@ -0,0 +1,113 @@
+/*
+ * Report Filter Module
+ * 
+ * Report-by-exception for samples entering the upload path. A sample is
+ * only passed on when at least one numeric sensor moved outside its
+ * deadband around the last reported value, or when no sample has been
+ * reported for the sensor's heartbeat interval. Slowly varying signals
+ * such as cpu_temp then cost an upload only when they actually change.
+ * 
+ * The band of a sensor is max(absolute, relative * |last reported value|).
+ * Non-numeric sensors (durations, booleans) never trigger a report; they
+ * are sent along with samples that pass.
+ * 
+ * Features:
+ * - Per-sensor absolute and relative deadbands
+ * - Per-sensor maximum silence (heartbeat)
+ * - Pass/suppress counters overall and per sensor
+ * 
+ * Usage:
+ *   report_filter_init();
+ *   report_filter_config_t cfg = { .abs_deadband = 0.5f, .heartbeat_ms = 600000 };
+ *   report_filter_configure(SENSOR_TYPE_CPU_TEMP, &cfg);
+ * 
+ *   if (report_filter_accept(&data)) {
+ *       sample_buffer_push(&data);
+ *   }
+ */
+
+#ifndef REPORT_FILTER_H
+#define REPORT_FILTER_H
+
+#include "esp_err.h"
+#include "sensor_service.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Filter Settings of One Sensor
+ */
+typedef struct {
+    float abs_deadband;                  // Change needed to report, in sensor units (0 = off)
+    float rel_deadband;                  // Change needed relative to the last value, e.g. 0.02 = 2% (0 = off)
+    uint32_t heartbeat_ms;               // Report at least this often (0 = no heartbeat)
+} report_filter_config_t;
+
+/*
+ * Filter Statistics
+ */
+typedef struct {
+    uint32_t samples;                    // Samples offered to the filter
+    uint32_t passed;                     // Samples passed on
+    uint32_t suppressed;                 // Samples dropped as unchanged
+    uint32_t heartbeats;                 // Samples passed only because a heartbeat expired
+    uint32_t triggers[SENSOR_TYPE_MAX];  // Reports caused by each sensor leaving its band
+} report_filter_stats_t;
+
+/*
+ * Initialize Report Filter
+ * 
+ * Applies the default deadbands (REPORT_DEADBAND_ABS, REPORT_DEADBAND_REL)
+ * and heartbeat (REPORT_HEARTBEAT_SEC) to every sensor and forgets the
+ * last reported values, so the next sample always passes.
+ * 
+ * Returns:
+ *   ESP_OK: Filter ready
+ */
+esp_err_t report_filter_init(void);
+
+/*
+ * Configure Sensor Filter
+ * 
+ * Parameters:
+ *   sensor_type: Sensor to configure
+ *   config: Deadbands and heartbeat for the sensor
+ * 
+ * Returns:
+ *   ESP_OK: Settings applied
+ *   ESP_ERR_INVALID_ARG: Invalid sensor type or config pointer
+ */
+esp_err_t report_filter_configure(sensor_type_t sensor_type, const report_filter_config_t *config);
+
+/*
+ * Filter Sample
+ * 
+ * Decides whether a sample should be reported and, if so, remembers its
+ * values as the new reference.
+ * 
+ * Parameters:
+ *   data: Sample to check
+ * 
+ * Returns:
+ *   true: Report the sample
+ *   false: Sample is within all deadbands and no heartbeat expired
+ */
+bool report_filter_accept(const sensor_data_t *data);
+
+/*
+ * Get Filter Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to report_filter_stats_t structure to populate
+ */
+void report_filter_get_stats(report_filter_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REPORT_FILTER_H
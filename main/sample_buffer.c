@@ -0,0 +1,145 @@
+/*
+ * Offline Sample Buffer Implementation
+ * 
+ * Column batch of sensor samples used while the device is offline. The
+ * batch is kept oldest first (consumed rows are moved out of the front),
+ * so the oldest samples are always one contiguous slice that can be
+ * handed to encoders without copying. The buffer is only accessed from
+ * the main task; its counters are kept in a statistics block so other
+ * tasks can read them.
+ */
+
+#include "sample_buffer.h"
+#include "config.h"
+#include "stats_block.h"
+
+// Statistics columns are only needed for window summaries
+#define SAMPLE_BUFFER_STATS        AGGREGATION_ENABLED
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    BUFFER_STAT_HIGH_WATER = 0,
+    BUFFER_STAT_PUSHED,
+    BUFFER_STAT_DROPPED,
+    BUFFER_STAT_COUNT
+} buffer_stat_t;
+
+STATS_BLOCK_DEFINE(s_stats, BUFFER_STAT_COUNT);
+
+// Module state management
+typedef struct {
+    bool initialized;
+    sensor_batch_t batch;                // Buffered samples, oldest first
+} sample_buffer_context_t;
+
+// Global module context
+static sample_buffer_context_t s_context;
+
+// Column storage
+static uint8_t s_storage[SENSOR_BATCH_STORAGE_SIZE(OFFLINE_BUFFER_SIZE, SAMPLE_BUFFER_STATS)] SENSOR_BATCH_ALIGN;
+
+/*
+ * Internal function to lay out the columns on first use
+ */
+static void ensure_initialized(void)
+{
+    if (!s_context.initialized) {
+        sensor_batch_init(&s_context.batch, s_storage, OFFLINE_BUFFER_SIZE, SAMPLE_BUFFER_STATS);
+        s_context.initialized = true;
+    }
+}
+
+/*
+ * Add Sample
+ */
+void sample_buffer_push(const sensor_data_t *data)
+{
+    if (!data) {
+        return;
+    }
+    
+    ensure_initialized();
+    
+    stats_update_begin(&s_stats);
+    if (s_context.batch.count == OFFLINE_BUFFER_SIZE) {
+        // Full: drop the oldest sample
+        sensor_batch_drop_front(&s_context.batch, 1);
+        stats_inc(&s_stats, BUFFER_STAT_DROPPED);
+    }
+    
+    sensor_batch_append(&s_context.batch, data);
+    stats_inc(&s_stats, BUFFER_STAT_PUSHED);
+    
+    if (s_context.batch.count > stats_get(&s_stats, BUFFER_STAT_HIGH_WATER)) {
+        stats_set(&s_stats, BUFFER_STAT_HIGH_WATER, (uint32_t)s_context.batch.count);
+    }
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Get Buffered Sample Count
+ */
+size_t sample_buffer_count(void)
+{
+    return s_context.batch.count;
+}
+
+/*
+ * Copy Oldest Samples
+ */
+size_t sample_buffer_peek(sensor_data_t *out, size_t max_count)
+{
+    if (!out) {
+        return 0;
+    }
+    
+    size_t count = (max_count < s_context.batch.count) ? max_count : s_context.batch.count;
+    for (size_t i = 0; i < count; i++) {
+        sensor_batch_get_row(&s_context.batch, i, &out[i]);
+    }
+    
+    return count;
+}
+
+/*
+ * Get Oldest Samples as Batch
+ */
+size_t sample_buffer_peek_batch(sensor_batch_t *batch, size_t max_count)
+{
+    if (!batch) {
+        return 0;
+    }
+    
+    ensure_initialized();
+    
+    sensor_batch_slice(&s_context.batch, 0, max_count, batch);
+    return batch->count;
+}
+
+/*
+ * Remove Oldest Samples
+ */
+void sample_buffer_consume(size_t count)
+{
+    sensor_batch_drop_front(&s_context.batch, count);
+}
+
+/*
+ * Get Buffer Statistics
+ */
+void sample_buffer_get_stats(sample_buffer_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    uint32_t values[BUFFER_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    stats->count = s_context.batch.count;
+    stats->capacity = OFFLINE_BUFFER_SIZE;
+    stats->high_water = values[BUFFER_STAT_HIGH_WATER];
+    stats->pushed = values[BUFFER_STAT_PUSHED];
+    stats->dropped = values[BUFFER_STAT_DROPPED];
+    stats->bytes_per_sample = SENSOR_BATCH_ROW_BYTES(SAMPLE_BUFFER_STATS);
+}
@@ -0,0 +1,120 @@
+/*
+ * Offline Sample Buffer Module
+ * 
+ * Holds sensor samples in RAM while the network or backend is unavailable
+ * so they can be uploaded once connectivity returns. Samples are stored
+ * column-wise in a sensor_batch of OFFLINE_BUFFER_SIZE rows, oldest
+ * first; when it is full the oldest sample is removed and counted as
+ * dropped. Window statistics columns are only reserved when aggregation
+ * is enabled, so a raw sample costs SENSOR_BATCH_ROW_BYTES(false) bytes
+ * instead of a full sensor_data_t.
+ * 
+ * Features:
+ * - Column storage in a static block, no dynamic allocation
+ * - Oldest-first peek/consume so samples are only removed once uploaded
+ * - Zero-copy batch view of the oldest samples for encoders
+ * - Drop and high-water mark statistics
+ * 
+ * Usage:
+ *   sample_buffer_push(&data);
+ * 
+ *   sensor_batch_t batch;
+ *   size_t count = sample_buffer_peek_batch(&batch, UPLOAD_BATCH_SIZE);
+ *   if (http_client_post_sample_batch(&batch) == ESP_OK) {
+ *       sample_buffer_consume(count);
+ *   }
+ */
+
+#ifndef SAMPLE_BUFFER_H
+#define SAMPLE_BUFFER_H
+
+#include "sensor_batch.h"
+#include "sensor_service.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sample Buffer Statistics
+ */
+typedef struct {
+    uint32_t count;                      // Samples currently buffered
+    uint32_t capacity;                   // Buffer capacity in samples
+    uint32_t high_water;                 // Largest number of samples buffered at once
+    uint32_t pushed;                     // Total samples added
+    uint32_t dropped;                    // Samples removed before upload
+    uint32_t bytes_per_sample;           // Storage used per buffered sample
+} sample_buffer_stats_t;
+
+/*
+ * Add Sample
+ * 
+ * Appends a sample, removing the oldest one if the buffer is full.
+ * 
+ * Parameters:
+ *   data: Sample to store
+ */
+void sample_buffer_push(const sensor_data_t *data);
+
+/*
+ * Get Buffered Sample Count
+ * 
+ * Returns:
+ *   size_t: Number of samples waiting for upload
+ */
+size_t sample_buffer_count(void);
+
+/*
+ * Copy Oldest Samples
+ * 
+ * Copies up to max_count of the oldest samples without removing them.
+ * 
+ * Parameters:
+ *   out: Destination array
+ *   max_count: Capacity of the destination array
+ * 
+ * Returns:
+ *   size_t: Number of samples copied
+ */
+size_t sample_buffer_peek(sensor_data_t *out, size_t max_count);
+
+/*
+ * Get Oldest Samples as Batch
+ * 
+ * Fills batch with a view of up to max_count of the oldest samples,
+ * without copying or removing them. The view stays valid until the next
+ * push or consume.
+ * 
+ * Parameters:
+ *   batch: Destination batch descriptor
+ *   max_count: Largest number of samples in the view
+ * 
+ * Returns:
+ *   size_t: Number of samples in the view
+ */
+size_t sample_buffer_peek_batch(sensor_batch_t *batch, size_t max_count);
+
+/*
+ * Remove Oldest Samples
+ * 
+ * Parameters:
+ *   count: Number of samples to remove (clamped to the buffered count)
+ */
+void sample_buffer_consume(size_t count);
+
+/*
+ * Get Buffer Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to sample_buffer_stats_t structure to populate
+ */
+void sample_buffer_get_stats(sample_buffer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_BUFFER_H
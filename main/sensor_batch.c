@@ -0,0 +1,226 @@
+/*
+ * Sensor Batch Implementation
+ * 
+ * Columns are carved out of the storage block in order of decreasing
+ * alignment (timestamps first), so every column is naturally aligned as
+ * long as the block is 8-byte aligned.
+ */
+
+#include "sensor_batch.h"
+
+#include <string.h>
+
+/*
+ * Internal function to point every column at row 'first' of src
+ */
+static void point_columns(sensor_batch_t *dst, const sensor_batch_t *src, size_t first)
+{
+    dst->timestamp_us = src->timestamp_us + first;
+    dst->valid_mask = src->valid_mask + first;
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        dst->values[type] = src->values[type] + first;
+    }
+    
+    if (src->stats_mask) {
+        dst->stats_mask = src->stats_mask + first;
+        dst->window_ms = src->window_ms + first;
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            dst->stats[type] = src->stats[type] + first;
+        }
+    } else {
+        dst->stats_mask = NULL;
+        dst->window_ms = NULL;
+        memset(dst->stats, 0, sizeof(dst->stats));
+    }
+}
+
+/*
+ * Initialize Batch
+ */
+esp_err_t sensor_batch_init(sensor_batch_t *batch, void *storage, size_t capacity, bool with_stats)
+{
+    if (!batch || !storage || capacity == 0 || ((uintptr_t)storage % sizeof(int64_t)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memset(batch, 0, sizeof(*batch));
+    batch->capacity = capacity;
+    
+    uint8_t *next = storage;
+    batch->timestamp_us = (int64_t *)next;
+    next += capacity * sizeof(int64_t);
+    batch->valid_mask = (uint32_t *)next;
+    next += capacity * sizeof(uint32_t);
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        batch->values[type] = (sensor_value_t *)next;
+        next += capacity * sizeof(sensor_value_t);
+    }
+    
+    if (with_stats) {
+        batch->stats_mask = (uint32_t *)next;
+        next += capacity * sizeof(uint32_t);
+        batch->window_ms = (uint32_t *)next;
+        next += capacity * sizeof(uint32_t);
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            batch->stats[type] = (sensor_stats_t *)next;
+            next += capacity * sizeof(sensor_stats_t);
+        }
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Remove All Rows
+ */
+void sensor_batch_clear(sensor_batch_t *batch)
+{
+    if (batch) {
+        batch->count = 0;
+    }
+}
+
+/*
+ * Append Sample
+ */
+esp_err_t sensor_batch_append(sensor_batch_t *batch, const sensor_data_t *data)
+{
+    if (!batch || !data) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (batch->count == batch->capacity) {
+        return ESP_ERR_NO_MEM;
+    }
+    
+    size_t row = batch->count++;
+    batch->timestamp_us[row] = (int64_t)data->timestamp_us;
+    batch->valid_mask[row] = data->valid_mask;
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        batch->values[type][row] = data->values[type];
+    }
+    
+    if (batch->stats_mask) {
+        batch->stats_mask[row] = data->stats_mask;
+        batch->window_ms[row] = data->window_ms;
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            batch->stats[type][row] = data->stats[type];
+        }
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Append Sampler Records
+ */
+size_t sensor_batch_append_records(sensor_batch_t *batch, const sensor_record_t *records, size_t count)
+{
+    if (!batch || !records) {
+        return 0;
+    }
+    
+    size_t space = batch->capacity - batch->count;
+    if (count > space) {
+        count = space;
+    }
+    
+    size_t first = batch->count;
+    for (size_t i = 0; i < count; i++) {
+        batch->timestamp_us[first + i] = records[i].timestamp_us;
+        batch->valid_mask[first + i] = records[i].valid_mask;
+    }
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        sensor_value_t *column = batch->values[type] + first;
+        for (size_t i = 0; i < count; i++) {
+            column[i] = records[i].values[type];
+        }
+    }
+    
+    if (batch->stats_mask) {
+        memset(batch->stats_mask + first, 0, count * sizeof(uint32_t));
+        memset(batch->window_ms + first, 0, count * sizeof(uint32_t));
+    }
+    
+    batch->count += count;
+    return count;
+}
+
+/*
+ * Get Row as Sample
+ */
+esp_err_t sensor_batch_get_row(const sensor_batch_t *batch, size_t index, sensor_data_t *data)
+{
+    if (!batch || !data || index >= batch->count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    sensor_record_t record;
+    record.timestamp_us = batch->timestamp_us[index];
+    record.valid_mask = batch->valid_mask[index];
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        record.values[type] = batch->values[type][index];
+    }
+    sensor_service_record_to_data(&record, data);
+    
+    if (batch->stats_mask) {
+        data->stats_mask = batch->stats_mask[index];
+        data->window_ms = batch->window_ms[index];
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            data->stats[type] = batch->stats[type][index];
+        }
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Remove Oldest Rows
+ */
+void sensor_batch_drop_front(sensor_batch_t *batch, size_t count)
+{
+    if (!batch) {
+        return;
+    }
+    
+    if (count >= batch->count) {
+        batch->count = 0;
+        return;
+    }
+    
+    size_t keep = batch->count - count;
+    memmove(batch->timestamp_us, batch->timestamp_us + count, keep * sizeof(int64_t));
+    memmove(batch->valid_mask, batch->valid_mask + count, keep * sizeof(uint32_t));
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        memmove(batch->values[type], batch->values[type] + count, keep * sizeof(sensor_value_t));
+    }
+    
+    if (batch->stats_mask) {
+        memmove(batch->stats_mask, batch->stats_mask + count, keep * sizeof(uint32_t));
+        memmove(batch->window_ms, batch->window_ms + count, keep * sizeof(uint32_t));
+        for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+            memmove(batch->stats[type], batch->stats[type] + count, keep * sizeof(sensor_stats_t));
+        }
+    }
+    
+    batch->count = keep;
+}
+
+/*
+ * Get Slice of Rows
+ */
+esp_err_t sensor_batch_slice(const sensor_batch_t *batch, size_t first, size_t count, sensor_batch_t *view)
+{
+    if (!batch || !view || first > batch->count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (count > batch->count - first) {
+        count = batch->count - first;
+    }
+    
+    point_columns(view, batch, first);
+    view->capacity = count;
+    view->count = count;
+    return ESP_OK;
+}
@@ -0,0 +1,190 @@
+/*
+ * Sensor Batch Module
+ * 
+ * Column-wise (structure-of-arrays) container for a batch of sensor
+ * samples. Instead of one sensor_data_t per sample, a batch keeps one
+ * array per field: timestamps, per-sample validity bits and one value
+ * column per sensor type. Window summaries additionally carry their
+ * statistics columns. All columns live in a single caller-provided
+ * storage block sized with SENSOR_BATCH_STORAGE_SIZE(), so a batch never
+ * allocates.
+ * 
+ * A raw sample takes SENSOR_BATCH_ROW_BYTES(false) bytes (no formatted
+ * uptime string, float copy or padding), and encoders and the aggregator
+ * walk one sensor's values as a contiguous array with the driver looked
+ * up once per column instead of once per sample.
+ * 
+ * Features:
+ * - Fixed capacity, storage provided by the caller
+ * - Append from sensor_data_t or sampler records
+ * - Zero-copy slices of consecutive rows
+ * - Row reconstruction as sensor_data_t for existing consumers
+ * 
+ * Usage:
+ *   static uint8_t storage[SENSOR_BATCH_STORAGE_SIZE(64, false)] SENSOR_BATCH_ALIGN;
+ *   sensor_batch_t batch;
+ *   sensor_batch_init(&batch, storage, 64, false);
+ * 
+ *   sensor_batch_append(&batch, &data);
+ *   for (size_t i = 0; i < batch.count; i++) {
+ *       if (batch.valid_mask[i] & (1u << SENSOR_TYPE_CPU_TEMP)) {
+ *           sum += batch.values[SENSOR_TYPE_CPU_TEMP][i].f;
+ *       }
+ *   }
+ */
+
+#ifndef SENSOR_BATCH_H
+#define SENSOR_BATCH_H
+
+#include "esp_err.h"
+#include "sensor_service.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment required for batch storage blocks
+#define SENSOR_BATCH_ALIGN         __attribute__((aligned(8)))
+
+// Bytes per row: timestamp, validity bits, one value per sensor and,
+// for summaries, stats mask, window length and per-sensor statistics
+#define SENSOR_BATCH_ROW_BYTES(with_stats) \
+    (sizeof(int64_t) + sizeof(uint32_t) + SENSOR_TYPE_MAX * sizeof(sensor_value_t) + \
+     ((with_stats) ? 2 * sizeof(uint32_t) + SENSOR_TYPE_MAX * sizeof(sensor_stats_t) : 0))
+
+// Storage block size for a batch of capacity rows
+#define SENSOR_BATCH_STORAGE_SIZE(capacity, with_stats) \
+    ((size_t)(capacity) * SENSOR_BATCH_ROW_BYTES(with_stats))
+
+/*
+ * Sensor Batch
+ * 
+ * Row i of the batch is timestamp_us[i], valid_mask[i] and
+ * values[type][i]; values[type][i] only holds a reading when bit
+ * (1 << type) of valid_mask[i] is set. The stats columns are NULL for
+ * batches created without statistics.
+ */
+typedef struct {
+    size_t capacity;                     // Rows the storage can hold
+    size_t count;                        // Rows in use
+    int64_t *timestamp_us;               // Sample times (microseconds since boot)
+    uint32_t *valid_mask;                // Bit (1 << type) set for each valid reading
+    sensor_value_t *values[SENSOR_TYPE_MAX]; // One column per sensor type
+    
+    // Window summaries only
+    uint32_t *stats_mask;                // Bit (1 << type) set for each entry in stats
+    uint32_t *window_ms;                 // Window length covered by the statistics
+    sensor_stats_t *stats[SENSOR_TYPE_MAX];
+} sensor_batch_t;
+
+/*
+ * Initialize Batch
+ * 
+ * Lays the columns out in the storage block and empties the batch.
+ * 
+ * Parameters:
+ *   batch: Batch to initialize
+ *   storage: SENSOR_BATCH_STORAGE_SIZE(capacity, with_stats) bytes,
+ *            8-byte aligned, valid while the batch is used
+ *   capacity: Number of rows
+ *   with_stats: Reserve statistics columns for window summaries
+ * 
+ * Returns:
+ *   ESP_OK: Batch ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, zero capacity or misaligned storage
+ */
+esp_err_t sensor_batch_init(sensor_batch_t *batch, void *storage, size_t capacity, bool with_stats);
+
+/*
+ * Remove All Rows
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ */
+void sensor_batch_clear(sensor_batch_t *batch);
+
+/*
+ * Append Sample
+ * 
+ * Statistics of a summary are kept only if the batch has statistics
+ * columns.
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ *   data: Sample or window summary to append
+ * 
+ * Returns:
+ *   ESP_OK: Row appended
+ *   ESP_ERR_INVALID_ARG: Invalid pointer
+ *   ESP_ERR_NO_MEM: Batch full
+ */
+esp_err_t sensor_batch_append(sensor_batch_t *batch, const sensor_data_t *data);
+
+/*
+ * Append Sampler Records
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ *   records: Records from sensor_service_drain(), oldest first
+ *   count: Number of records
+ * 
+ * Returns:
+ *   size_t: Number of records appended (less than count if the batch filled up)
+ */
+size_t sensor_batch_append_records(sensor_batch_t *batch, const sensor_record_t *records, size_t count);
+
+/*
+ * Get Row as Sample
+ * 
+ * Rebuilds a sensor_data_t, including the derived cpu_temp, uptime and
+ * data_valid fields.
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ *   index: Row index (< count)
+ *   data: Destination sample
+ * 
+ * Returns:
+ *   ESP_OK: Row copied
+ *   ESP_ERR_INVALID_ARG: Invalid pointer or index out of range
+ */
+esp_err_t sensor_batch_get_row(const sensor_batch_t *batch, size_t index, sensor_data_t *data);
+
+/*
+ * Remove Oldest Rows
+ * 
+ * Moves the remaining rows to the front of every column.
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ *   count: Number of rows to remove (clamped to the row count)
+ */
+void sensor_batch_drop_front(sensor_batch_t *batch, size_t count);
+
+/*
+ * Get Slice of Rows
+ * 
+ * Fills view with column pointers into batch, without copying. The view
+ * is full (capacity == count) and stays valid until rows of batch are
+ * dropped or the batch is cleared.
+ * 
+ * Parameters:
+ *   batch: Initialized batch
+ *   first: First row of the slice
+ *   count: Number of rows (clamped to the rows available)
+ *   view: Destination batch descriptor
+ * 
+ * Returns:
+ *   ESP_OK: View filled (possibly empty)
+ *   ESP_ERR_INVALID_ARG: Invalid pointer or first beyond the row count
+ */
+esp_err_t sensor_batch_slice(const sensor_batch_t *batch, size_t first, size_t count, sensor_batch_t *view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SENSOR_BATCH_H
@@ -1,8 +1,8 @@
 /*
  * Sensor Service Implementation
  * 
- * Implements data collection services including CPU temperature simulation
- * and system uptime tracking. Designed for extensibility with GPIO sensors.
+ * Implements the sensor driver registry and the built-in drivers for CPU
+ * temperature simulation and system uptime tracking.
  */
 
 #include "sensor_service.h"
@@ -10,34 +10,93 @@
 
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "spsc_ring.h"
+#include "sim_signal.h"
+#include "chip_temp.h"
+#include "mem_stats.h"
+#include "trace.h"
+#include "stats_block.h"
 
 // Module logging tag
 static const char *TAG = "SENSOR_SVC";
 
+// Entry of the active driver table (kept small and contiguous for the read loop)
+typedef struct {
+    esp_err_t (*read)(sensor_value_t *value);
+    int64_t interval_us;                 // Minimum time between reads
+    int64_t last_read_us;                // Time of last driver read
+    sensor_value_t last_value;           // Value reused until the interval elapses
+    uint8_t type;                        // sensor_type_t
+} sensor_slot_t;
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    SENSOR_STAT_READS = 0,
+    SENSOR_STAT_ERRORS,
+    SENSOR_STAT_SAMPLER_RECORDS,
+    SENSOR_STAT_LAST_READ_TIME,          // 64-bit (two slots)
+    SENSOR_STAT_DRIVER_READS = SENSOR_STAT_LAST_READ_TIME + 2,             // Per type
+    SENSOR_STAT_DRIVER_TIME = SENSOR_STAT_DRIVER_READS + SENSOR_TYPE_MAX,  // Per type, 64-bit
+    SENSOR_STAT_COUNT = SENSOR_STAT_DRIVER_TIME + 2 * SENSOR_TYPE_MAX
+} sensor_stat_t;
+
+// Updated from the sampler task and the callers of the read functions
+STATS_BLOCK_DEFINE(s_stats, SENSOR_STAT_COUNT);
+
 // Module state management
 typedef struct {
     bool initialized;
     bool enabled[SENSOR_TYPE_MAX];
-    uint32_t read_count;
-    uint32_t error_count;
-    int64_t last_read_time;
     int64_t start_time;                  // Application start time for uptime calculation
+    const sensor_driver_t *drivers[SENSOR_TYPE_MAX];
+    sensor_slot_t active[SENSOR_TYPE_MAX];
+    size_t active_count;
+    int8_t active_index[SENSOR_TYPE_MAX];      // Slot in active[] per type, -1 if not read
+    
+    // Background sampler (task is the ring producer)
+    volatile bool sampler_running;
+    volatile bool sampler_stop;
+    uint32_t sampler_rate_hz;
+    TaskHandle_t sampler_task;
+    esp_timer_handle_t sampler_timer;
+    spsc_ring_t sampler_ring;
+    size_t sampler_heap_bytes;           // Task sizes accounted for the sampler
 } sensor_context_t;
 
+// Sampler ring storage
+static sensor_record_t s_sampler_storage[SAMPLER_RING_CAPACITY];
+
 // Global module context
 static sensor_context_t s_context = {
     .initialized = false,
     .enabled = {false},
-    .read_count = 0,
-    .error_count = 0,
-    .last_read_time = 0,
-    .start_time = 0
+    .start_time = 0,
+    .active_count = 0,
+    .sampler_running = false,
+    .sampler_task = NULL,
+    .sampler_timer = NULL
+};
+
+// Simulated CPU temperature waveform
+static const sim_signal_config_t s_temp_signal_config = {
+    .waveform = SIM_WAVE_SINE,
+    .offset = TEMP_SIMULATION_BASE,
+    .amplitude = TEMP_SIMULATION_VARIATION,
+    .period_ms = (uint32_t)(TEMP_SIMULATION_PERIOD * 1000),
+    .noise = SIM_NOISE_UNIFORM,
+    .noise_amplitude = TEMP_SIMULATION_NOISE,
+    .min = TEMP_MIN_LIMIT,
+    .max = TEMP_MAX_LIMIT
 };
 
+static sim_signal_t s_temp_signal;
+static bool s_temp_signal_ready = false;
+
 /*
  * Internal function to read CPU temperature simulation
  */
@@ -47,59 +106,274 @@ static esp_err_t read_cpu_temperature(float *temp)
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Get time since boot in seconds for temperature variation
-    int64_t time_us = esp_timer_get_time();
-    int64_t time_seconds = time_us / 1000000;
+    // Set up lazily so the standalone function works without sensor_service_init()
+    if (!s_temp_signal_ready) {
+        esp_err_t ret = sim_signal_init(&s_temp_signal, &s_temp_signal_config);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        s_temp_signal_ready = true;
+    }
     
-    // Create a slowly varying temperature using sine wave
-    // Uses constants from config.h
-    float base_temp = TEMP_SIMULATION_BASE;
-    float variation = TEMP_SIMULATION_VARIATION * 
-                     sin(time_seconds * 2.0 * 3.14159 / TEMP_SIMULATION_PERIOD);
+    // Slowly varying sine with small noise, clamped to realistic bounds
+    float temperature = sim_signal_sample(&s_temp_signal, esp_timer_get_time());
+    *temp = temperature;
     
-    // Add small random-like variation based on time
-    float micro_variation = (time_seconds % 17) * 0.1 - 0.8; // Small noise
+    ESP_LOGD(TAG, "CPU temperature: %.1f°C", temperature);
+    return ESP_OK;
+}
+
+/*
+ * Built-in driver: simulated CPU temperature
+ */
+static esp_err_t cpu_temp_driver_read(sensor_value_t *value)
+{
+    return read_cpu_temperature(&value->f);
+}
+
+/*
+ * Built-in driver: seconds since the sensor service was initialized
+ */
+static esp_err_t uptime_driver_read(sensor_value_t *value)
+{
+    value->u = (uint32_t)((esp_timer_get_time() - s_context.start_time) / 1000000);
+    return ESP_OK;
+}
+
+static const sensor_driver_t s_builtin_drivers[] = {
+    {
+        .type = SENSOR_TYPE_CPU_TEMP,
+        .name = "CPU_TEMP",
+        .json_field = JSON_FIELD_CPU_TEMP,
+        .value_type = SENSOR_VALUE_FLOAT,
+        .encoding = SENSOR_ENCODING_NUMBER,
+        .decimals = 2,
+        .read = cpu_temp_driver_read,
+    },
+    {
+        .type = SENSOR_TYPE_UPTIME,
+        .name = "UPTIME",
+        .json_field = JSON_FIELD_UPTIME,
+        .value_type = SENSOR_VALUE_UINT,
+        .encoding = SENSOR_ENCODING_DURATION,
+        .read = uptime_driver_read,
+    },
+};
+
+/*
+ * Internal function to rebuild the table of enabled drivers
+ * 
+ * Called whenever a driver is registered or enabled/disabled, so the
+ * read path only walks drivers that will actually be read.
+ */
+static void rebuild_active_table(void)
+{
+    size_t count = 0;
     
-    float temperature = base_temp + variation + micro_variation;
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const sensor_driver_t *driver = s_context.drivers[type];
+        s_context.active_index[type] = -1;
+        if (!driver || !s_context.enabled[type]) {
+            continue;
+        }
+        
+        s_context.active_index[type] = (int8_t)count;
+        sensor_slot_t *slot = &s_context.active[count++];
+        memset(slot, 0, sizeof(*slot));
+        slot->read = driver->read;
+        slot->interval_us = (int64_t)driver->sample_interval_ms * 1000;
+        slot->type = type;
+    }
     
-    // Ensure temperature is within realistic bounds
-    if (temperature < TEMP_MIN_LIMIT) temperature = TEMP_MIN_LIMIT;
-    if (temperature > TEMP_MAX_LIMIT) temperature = TEMP_MAX_LIMIT;
+    s_context.active_count = count;
+}
+
+/*
+ * Internal function to clear the read counters (sampler counters are kept)
+ */
+static void reset_read_stats(void)
+{
+    stats_update_begin(&s_stats);
+    stats_set(&s_stats, SENSOR_STAT_READS, 0);
+    stats_set(&s_stats, SENSOR_STAT_ERRORS, 0);
+    stats_set64(&s_stats, SENSOR_STAT_LAST_READ_TIME, 0);
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        stats_set(&s_stats, SENSOR_STAT_DRIVER_READS + type, 0);
+        stats_set64(&s_stats, SENSOR_STAT_DRIVER_TIME + 2 * type, 0);
+    }
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Internal function to install a driver and run its init hook
+ */
+static esp_err_t install_driver(const sensor_driver_t *driver)
+{
+    const sensor_driver_t *previous = s_context.drivers[driver->type];
+    if (previous && previous != driver && s_context.initialized && previous->deinit) {
+        previous->deinit();
+    }
     
-    *temp = temperature;
+    s_context.drivers[driver->type] = driver;
+    s_context.enabled[driver->type] = true;
+    stats_update_begin(&s_stats);
+    stats_set(&s_stats, SENSOR_STAT_DRIVER_READS + driver->type, 0);
+    stats_set64(&s_stats, SENSOR_STAT_DRIVER_TIME + 2 * driver->type, 0);
+    stats_update_end(&s_stats);
+    
+    esp_err_t ret = ESP_OK;
+    if (s_context.initialized && driver->init) {
+        ret = driver->init();
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Driver %s init failed: %s, disabled", driver->name, esp_err_to_name(ret));
+            s_context.enabled[driver->type] = false;
+        }
+    }
     
-    ESP_LOGD(TAG, "CPU temperature: %.1f°C", temperature);
-    return ESP_OK;
+    return ret;
 }
 
 /*
- * Internal function to calculate system uptime
+ * Internal function to read one driver, honouring its sample interval
  */
-static esp_err_t read_system_uptime(char *uptime_str, size_t max_len)
+static inline esp_err_t read_slot(sensor_slot_t *slot, int64_t now, sensor_value_t *value)
 {
-    if (!uptime_str || max_len < UPTIME_STRING_MAX_LEN) {
-        return ESP_ERR_INVALID_ARG;
+    if (slot->last_read_us != 0 && now - slot->last_read_us < slot->interval_us) {
+        *value = slot->last_value;
+        return ESP_OK;
     }
     
-    // Get current time in microseconds since boot
-    int64_t current_time = esp_timer_get_time();
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = slot->read(value);
+    int64_t elapsed = esp_timer_get_time() - start;
+    stats_update_begin(&s_stats);
+    stats_inc(&s_stats, SENSOR_STAT_DRIVER_READS + slot->type);
+    stats_add64(&s_stats, SENSOR_STAT_DRIVER_TIME + 2 * slot->type, (uint64_t)elapsed);
+    stats_update_end(&s_stats);
+    if (ret == ESP_OK) {
+        slot->last_value = *value;
+        slot->last_read_us = now;
+    }
     
-    // Calculate uptime in seconds
-    int64_t uptime_seconds = (current_time - s_context.start_time) / 1000000;
+    return ret;
+}
+
+/*
+ * Internal function to read every enabled driver
+ * 
+ * Shared by sensor_service_read() and the sampler task; only one of them
+ * runs at a time.
+ */
+static esp_err_t read_active_drivers(int64_t now, sensor_value_t *values, uint32_t *valid_mask)
+{
+    esp_err_t overall_result = ESP_OK;
+    uint32_t mask = 0;
     
-    // Break down into hours, minutes, and seconds
-    int hours = uptime_seconds / 3600;
-    int minutes = (uptime_seconds % 3600) / 60;
-    int seconds = uptime_seconds % 60;
+    for (size_t i = 0; i < s_context.active_count; i++) {
+        sensor_slot_t *slot = &s_context.active[i];
+        if (read_slot(slot, now, &values[slot->type]) == ESP_OK) {
+            mask |= 1u << slot->type;
+        } else {
+            overall_result = ESP_FAIL;
+            stats_inc(&s_stats, SENSOR_STAT_ERRORS);
+            ESP_LOGW(TAG, "Failed to read sensor %s", s_context.drivers[slot->type]->name);
+        }
+    }
+    
+    if (overall_result == ESP_OK) {
+        stats_update_begin(&s_stats);
+        stats_inc(&s_stats, SENSOR_STAT_READS);
+        stats_set64(&s_stats, SENSOR_STAT_LAST_READ_TIME, (uint64_t)now);
+        stats_update_end(&s_stats);
+    }
+    
+    *valid_mask = mask;
+    return overall_result;
+}
+
+/*
+ * Internal function to mirror the built-in sensor types into the legacy fields
+ */
+static void fill_legacy_fields(sensor_data_t *data)
+{
+    const sensor_driver_t *temp_driver = s_context.drivers[SENSOR_TYPE_CPU_TEMP];
+    const sensor_driver_t *uptime_driver = s_context.drivers[SENSOR_TYPE_UPTIME];
+    
+    data->data_valid = true;
+    for (size_t i = 0; i < s_context.active_count; i++) {
+        if (!(data->valid_mask & (1u << s_context.active[i].type))) {
+            data->data_valid = false;
+        }
+    }
+    
+    if ((data->valid_mask & (1u << SENSOR_TYPE_CPU_TEMP)) && temp_driver && temp_driver->value_type == SENSOR_VALUE_FLOAT) {
+        data->cpu_temp = data->values[SENSOR_TYPE_CPU_TEMP].f;
+    }
+    if ((data->valid_mask & (1u << SENSOR_TYPE_UPTIME)) && uptime_driver && uptime_driver->encoding == SENSOR_ENCODING_DURATION) {
+        sensor_service_format_duration(data->values[SENSOR_TYPE_UPTIME].u, data->uptime, sizeof(data->uptime));
+    } else {
+        strncpy(data->uptime, s_context.enabled[SENSOR_TYPE_UPTIME] ? "ERROR" : "DISABLED",
+                sizeof(data->uptime) - 1);
+    }
+}
+
+/*
+ * Sampler Timer Callback
+ * 
+ * Runs in the esp_timer task and only wakes the sampler task, so a slow
+ * driver never delays other timers.
+ */
+static void sampler_timer_cb(void *arg)
+{
+    xTaskNotifyGive(s_context.sampler_task);
+}
+
+/*
+ * Sampler Task
+ * 
+ * Producer side of the sampler ring: one record per timer tick.
+ */
+static void sampler_task(void *arg)
+{
+    sensor_record_t record;
+    
+    while (!s_context.sampler_stop) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (s_context.sampler_stop) {
+            break;
+        }
+        
+        TRACE_BEGIN(TRACE_EV_SAMPLE, 0, 0);
+        record.timestamp_us = esp_timer_get_time();
+        read_active_drivers(record.timestamp_us, record.values, &record.valid_mask);
+        spsc_ring_push(&s_context.sampler_ring, &record);
+        TRACE_END(TRACE_EV_SAMPLE, record.valid_mask, 0);
+        stats_inc(&s_stats, SENSOR_STAT_SAMPLER_RECORDS);
+    }
+    
+    s_context.sampler_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/*
+ * Format Duration
+ */
+esp_err_t sensor_service_format_duration(uint32_t seconds, char *buffer, size_t max_len)
+{
+    if (!buffer) {
+        return ESP_ERR_INVALID_ARG;
+    }
     
-    // Format as string
-    int written = snprintf(uptime_str, max_len, "%dh %dm %ds", hours, minutes, seconds);
+    // Break down into hours, minutes, and seconds
+    int written = snprintf(buffer, max_len, "%luh %lum %lus",
+                           (unsigned long)(seconds / 3600),
+                           (unsigned long)((seconds % 3600) / 60),
+                           (unsigned long)(seconds % 60));
     if (written < 0 || written >= max_len) {
-        ESP_LOGE(TAG, "Uptime string formatting failed or truncated");
+        ESP_LOGE(TAG, "Duration string formatting failed or truncated");
         return ESP_ERR_INVALID_SIZE;
     }
     
-    ESP_LOGD(TAG, "System uptime: %s", uptime_str);
     return ESP_OK;
 }
 
@@ -118,21 +392,51 @@ esp_err_t sensor_service_init(void)
     // Record initialization time for uptime calculation
     s_context.start_time = esp_timer_get_time();
     
-    // Enable all available sensors by default
-    s_context.enabled[SENSOR_TYPE_CPU_TEMP] = true;
-    s_context.enabled[SENSOR_TYPE_UPTIME] = true;
+    // The on-chip sensor replaces the simulated temperature where available
+    const sensor_driver_t *chip_driver = chip_temp_get_driver();
+    if (chip_driver && !s_context.drivers[SENSOR_TYPE_CPU_TEMP]) {
+        install_driver(chip_driver);
+    }
+    
+    // Built-in drivers fill the types nobody registered a driver for
+    for (size_t i = 0; i < ARRAY_SIZE(s_builtin_drivers); i++) {
+        if (!s_context.drivers[s_builtin_drivers[i].type]) {
+            install_driver(&s_builtin_drivers[i]);
+        }
+    }
     
     // Reset statistics
-    s_context.read_count = 0;
-    s_context.error_count = 0;
-    s_context.last_read_time = 0;
+    reset_read_stats();
     
     s_context.initialized = true;
     
+    // Bring up driver hardware; a failing driver is disabled, not fatal
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        const sensor_driver_t *driver = s_context.drivers[type];
+        if (driver && driver->init) {
+            esp_err_t ret = driver->init();
+            if (ret != ESP_OK) {
+                ESP_LOGW(TAG, "Driver %s init failed: %s, disabled", driver->name, esp_err_to_name(ret));
+                s_context.enabled[type] = false;
+                
+                // Keep reporting a (simulated) temperature if the peripheral is unusable
+                if (driver == chip_driver) {
+                    ESP_LOGW(TAG, "Falling back to simulated CPU temperature");
+                    install_driver(&s_builtin_drivers[0]);
+                }
+            }
+        }
+    }
+    
+    rebuild_active_table();
+    
     ESP_LOGI(TAG, "Sensor service initialized successfully");
-    ESP_LOGI(TAG, "Enabled sensors: CPU_TEMP=%s, UPTIME=%s",
-             s_context.enabled[SENSOR_TYPE_CPU_TEMP] ? "YES" : "NO",
-             s_context.enabled[SENSOR_TYPE_UPTIME] ? "YES" : "NO");
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        if (s_context.drivers[type]) {
+            ESP_LOGI(TAG, "Sensor %s: %s", s_context.drivers[type]->name,
+                     s_context.enabled[type] ? "enabled" : "disabled");
+        }
+    }
     
     return ESP_OK;
 }
@@ -151,55 +455,111 @@ esp_err_t sensor_service_read(sensor_data_t *data)
         return ESP_ERR_INVALID_STATE;
     }
     
+    if (s_context.sampler_running) {
+        // The sampler task owns the drivers
+        return ESP_ERR_INVALID_STATE;
+    }
+    
     ESP_LOGD(TAG, "Reading all sensor data...");
     
     // Initialize data structure
     memset(data, 0, sizeof(sensor_data_t));
-    data->timestamp_us = esp_timer_get_time();
-    data->data_valid = true;
+    int64_t now = esp_timer_get_time();
+    data->timestamp_us = now;
     
-    esp_err_t overall_result = ESP_OK;
+    esp_err_t overall_result = read_active_drivers(now, data->values, &data->valid_mask);
+    fill_legacy_fields(data);
     
-    // Read CPU temperature if enabled
-    if (s_context.enabled[SENSOR_TYPE_CPU_TEMP]) {
-        esp_err_t temp_result = read_cpu_temperature(&data->cpu_temp);
-        if (temp_result != ESP_OK) {
-            ESP_LOGW(TAG, "Failed to read CPU temperature: %s", esp_err_to_name(temp_result));
-            data->data_valid = false;
-            overall_result = ESP_FAIL;
-            s_context.error_count++;
-        }
+    // Update statistics
+    if (overall_result == ESP_OK) {
+        ESP_LOGD(TAG, "Sensor read successful - Temp: %.1f°C, Uptime: %s", 
+                 data->cpu_temp, data->uptime);
     } else {
-        data->cpu_temp = 0.0f;  // Set default value for disabled sensor
+        ESP_LOGW(TAG, "Sensor read completed with errors");
     }
     
-    // Read system uptime if enabled
-    if (s_context.enabled[SENSOR_TYPE_UPTIME]) {
-        esp_err_t uptime_result = read_system_uptime(data->uptime, sizeof(data->uptime));
-        if (uptime_result != ESP_OK) {
-            ESP_LOGW(TAG, "Failed to read system uptime: %s", esp_err_to_name(uptime_result));
-            data->data_valid = false;
+    return overall_result;
+}
+
+/*
+ * Internal function to read one sensor type into a tagged reading
+ */
+static esp_err_t read_type(int64_t now, sensor_reading_t *reading)
+{
+    if ((unsigned)reading->type >= SENSOR_TYPE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    const sensor_driver_t *driver = s_context.drivers[reading->type];
+    if (!driver) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    
+    int index = s_context.active_index[reading->type];
+    if (index < 0) {
+        // Disabled, or its init failed
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    reading->value_type = driver->value_type;
+    return read_slot(&s_context.active[index], now, &reading->value);
+}
+
+/*
+ * Read Several Sensors
+ */
+esp_err_t sensor_service_read_many(sensor_reading_t *readings, size_t count, int64_t *timestamp_us)
+{
+    if (!readings || count == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!s_context.initialized || s_context.sampler_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    // One timestamp for the whole set
+    int64_t now = esp_timer_get_time();
+    esp_err_t overall_result = ESP_OK;
+    
+    for (size_t i = 0; i < count; i++) {
+        readings[i].status = read_type(now, &readings[i]);
+        if (readings[i].status != ESP_OK) {
             overall_result = ESP_FAIL;
-            s_context.error_count++;
-            strncpy(data->uptime, "ERROR", sizeof(data->uptime) - 1);
+            stats_inc(&s_stats, SENSOR_STAT_ERRORS);
         }
-    } else {
-        strncpy(data->uptime, "DISABLED", sizeof(data->uptime) - 1);
     }
     
-    // Update statistics
     if (overall_result == ESP_OK) {
-        s_context.read_count++;
-        s_context.last_read_time = data->timestamp_us;
-        ESP_LOGD(TAG, "Sensor read successful - Temp: %.1f°C, Uptime: %s", 
-                 data->cpu_temp, data->uptime);
-    } else {
-        ESP_LOGW(TAG, "Sensor read completed with errors");
+        stats_update_begin(&s_stats);
+        stats_inc(&s_stats, SENSOR_STAT_READS);
+        stats_set64(&s_stats, SENSOR_STAT_LAST_READ_TIME, (uint64_t)now);
+        stats_update_end(&s_stats);
+    }
+    
+    if (timestamp_us) {
+        *timestamp_us = now;
     }
     
     return overall_result;
 }
 
+/*
+ * Read One Sensor
+ */
+esp_err_t sensor_service_read_value(sensor_type_t sensor_type, sensor_reading_t *reading)
+{
+    if (!reading) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    reading->type = sensor_type;
+    esp_err_t ret = sensor_service_read_many(reading, 1, NULL);
+    
+    // Report the sensor's own error rather than the aggregate ESP_FAIL
+    return (ret == ESP_FAIL) ? reading->status : ret;
+}
+
 /*
  * Read Specific Sensor
  */
@@ -209,32 +569,178 @@ esp_err_t sensor_service_read_single(sensor_type_t sensor_type, void *value)
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (!s_context.initialized) {
+    sensor_reading_t reading;
+    esp_err_t ret = sensor_service_read_value(sensor_type, &reading);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+            
+    if (s_context.drivers[sensor_type]->encoding == SENSOR_ENCODING_DURATION) {
+        // Durations are returned formatted, in a char[UPTIME_STRING_MAX_LEN] buffer
+        return sensor_service_format_duration(reading.value.u, (char *)value, UPTIME_STRING_MAX_LEN);
+    }
+            
+    switch (reading.value_type) {
+        case SENSOR_VALUE_FLOAT:
+            *(float *)value = reading.value.f;
+            break;
+        case SENSOR_VALUE_INT:
+            *(int32_t *)value = reading.value.i;
+            break;
+        case SENSOR_VALUE_UINT:
+            *(uint32_t *)value = reading.value.u;
+            break;
+        case SENSOR_VALUE_BOOL:
+            *(bool *)value = reading.value.b;
+            break;
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Register Sensor Driver
+ */
+esp_err_t sensor_service_register_driver(const sensor_driver_t *driver)
+{
+    if (!driver || !driver->read || !driver->name || driver->type >= SENSOR_TYPE_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (s_context.sampler_running) {
         return ESP_ERR_INVALID_STATE;
     }
     
+    esp_err_t ret = install_driver(driver);
+    rebuild_active_table();
+    
+    ESP_LOGI(TAG, "Registered sensor driver %s (type %d)", driver->name, driver->type);
+    return ret;
+}
+
+/*
+ * Get Registered Driver
+ */
+const sensor_driver_t *sensor_service_get_driver(sensor_type_t sensor_type)
+{
     if (sensor_type >= SENSOR_TYPE_MAX) {
+        return NULL;
+    }
+    
+    return s_context.drivers[sensor_type];
+}
+
+/*
+ * Start Background Sampler
+ */
+esp_err_t sensor_service_start_sampler(uint32_t rate_hz)
+{
+    if (rate_hz == 0 || rate_hz > SAMPLER_MAX_RATE_HZ) {
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (!s_context.enabled[sensor_type]) {
+    if (!s_context.initialized || s_context.sampler_running) {
         return ESP_ERR_INVALID_STATE;
     }
     
-    ESP_LOGD(TAG, "Reading sensor type: %d", sensor_type);
+    esp_err_t ret = spsc_ring_init(&s_context.sampler_ring, s_sampler_storage,
+                                   sizeof(sensor_record_t), SAMPLER_RING_CAPACITY);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    const esp_timer_create_args_t timer_args = {
+        .callback = &sampler_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "sensor_sampler",
+        .skip_unhandled_events = true
+    };
+    ret = esp_timer_create(&timer_args, &s_context.sampler_timer);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create sampler timer: %s", esp_err_to_name(ret));
+        return ESP_ERR_NO_MEM;
+    }
     
-    switch (sensor_type) {
-        case SENSOR_TYPE_CPU_TEMP:
-            return read_cpu_temperature((float*)value);
-            
-        case SENSOR_TYPE_UPTIME:
-            // For uptime, we expect a char[32] buffer
-            return read_system_uptime((char*)value, UPTIME_STRING_MAX_LEN);
-            
-        default:
-            ESP_LOGE(TAG, "Sensor type %d not implemented", sensor_type);
-            return ESP_ERR_NOT_SUPPORTED;
+    s_context.sampler_stop = false;
+    stats_set(&s_stats, SENSOR_STAT_SAMPLER_RECORDS, 0);
+    s_context.sampler_rate_hz = rate_hz;
+    s_context.sampler_running = true;
+    
+    if (xTaskCreate(sampler_task, "sensor_sampler", TASK_STACK_SIZE, NULL,
+                    SAMPLER_TASK_PRIORITY, &s_context.sampler_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create sampler task");
+        s_context.sampler_running = false;
+        esp_timer_delete(s_context.sampler_timer);
+        s_context.sampler_timer = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // Task stack and control block; the timer handle is not counted
+    s_context.sampler_heap_bytes = TASK_STACK_SIZE + sizeof(StaticTask_t);
+    mem_stats_note_alloc(MEM_MODULE_SENSOR_SERVICE, s_context.sampler_heap_bytes);
+    
+    esp_timer_start_periodic(s_context.sampler_timer, 1000000 / rate_hz);
+    
+    ESP_LOGI(TAG, "Sampler started at %lu Hz, ring of %d records", (unsigned long)rate_hz,
+             SAMPLER_RING_CAPACITY);
+    return ESP_OK;
+}
+
+/*
+ * Stop Background Sampler
+ */
+esp_err_t sensor_service_stop_sampler(void)
+{
+    if (!s_context.sampler_running) {
+        return ESP_OK;
+    }
+    
+    esp_timer_stop(s_context.sampler_timer);
+    esp_timer_delete(s_context.sampler_timer);
+    s_context.sampler_timer = NULL;
+    
+    // Wake the task so it sees the stop request, then wait for it to exit
+    s_context.sampler_stop = true;
+    while (s_context.sampler_task != NULL) {
+        xTaskNotifyGive(s_context.sampler_task);
+        vTaskDelay(1);
+    }
+    
+    s_context.sampler_running = false;
+    mem_stats_note_free(MEM_MODULE_SENSOR_SERVICE, s_context.sampler_heap_bytes);
+    s_context.sampler_heap_bytes = 0;
+    ESP_LOGI(TAG, "Sampler stopped after %lu records",
+             (unsigned long)stats_get(&s_stats, SENSOR_STAT_SAMPLER_RECORDS));
+    return ESP_OK;
+}
+
+/*
+ * Drain Sampler Records
+ */
+size_t sensor_service_drain(sensor_record_t *records, size_t max_count)
+{
+    if (!records || !s_context.sampler_ring.storage) {
+        return 0;
+    }
+    
+    return spsc_ring_pop_bulk(&s_context.sampler_ring, records, max_count);
+}
+
+/*
+ * Convert Sampler Record
+ */
+void sensor_service_record_to_data(const sensor_record_t *record, sensor_data_t *data)
+{
+    if (!record || !data) {
+        return;
     }
+    
+    memset(data, 0, sizeof(*data));
+    memcpy(data->values, record->values, sizeof(data->values));
+    data->valid_mask = record->valid_mask;
+    data->timestamp_us = record->timestamp_us;
+    fill_legacy_fields(data);
 }
 
 /*
@@ -246,9 +752,13 @@ esp_err_t sensor_service_enable(sensor_type_t sensor_type, bool enable)
         return ESP_ERR_INVALID_ARG;
     }
     
-    // For now, all sensor types are supported
+    if (s_context.sampler_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
     ESP_LOGI(TAG, "Sensor type %d %s", sensor_type, enable ? "enabled" : "disabled");
     s_context.enabled[sensor_type] = enable;
+    rebuild_active_table();
     
     return ESP_OK;
 }
@@ -262,11 +772,28 @@ esp_err_t sensor_service_get_status(sensor_status_t *status)
         return ESP_ERR_INVALID_ARG;
     }
     
+    uint32_t values[SENSOR_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
     status->initialized = s_context.initialized;
     memcpy(status->enabled, s_context.enabled, sizeof(s_context.enabled));
-    status->read_count = s_context.read_count;
-    status->error_count = s_context.error_count;
-    status->last_read_time = s_context.last_read_time;
+    status->read_count = values[SENSOR_STAT_READS];
+    status->error_count = values[SENSOR_STAT_ERRORS];
+    status->last_read_time = (int64_t)stats_get64(values, SENSOR_STAT_LAST_READ_TIME);
+    
+    for (int type = 0; type < SENSOR_TYPE_MAX; type++) {
+        uint32_t reads = values[SENSOR_STAT_DRIVER_READS + type];
+        uint64_t time_us = stats_get64(values, SENSOR_STAT_DRIVER_TIME + 2 * type);
+        status->driver_reads[type] = reads;
+        status->driver_read_ns[type] = reads ? (uint32_t)(time_us * 1000 / reads) : 0;
+    }
+    
+    status->sampler_running = s_context.sampler_running;
+    status->sampler_rate_hz = s_context.sampler_rate_hz;
+    status->sampler_records = values[SENSOR_STAT_SAMPLER_RECORDS];
+    status->sampler_overflows = atomic_load(&s_context.sampler_ring.overflows);
+    status->sampler_pending = s_context.sampler_ring.storage ? spsc_ring_count(&s_context.sampler_ring) : 0;
+    status->sampler_high_water = atomic_load(&s_context.sampler_ring.high_water);
     
     return ESP_OK;
 }
@@ -281,9 +808,7 @@ esp_err_t sensor_service_reset_stats(void)
     }
     
     ESP_LOGI(TAG, "Resetting sensor statistics...");
-    s_context.read_count = 0;
-    s_context.error_count = 0;
-    s_context.last_read_time = 0;
+    reset_read_stats();
     
     return ESP_OK;
 }
@@ -299,12 +824,17 @@ esp_err_t sensor_service_cleanup(void)
     
     ESP_LOGI(TAG, "Cleaning up sensor service...");
     
-    // Disable all sensors
+    sensor_service_stop_sampler();
+    
+    // Disable all sensors and release driver hardware
     for (int i = 0; i < SENSOR_TYPE_MAX; i++) {
         s_context.enabled[i] = false;
+        if (s_context.drivers[i] && s_context.drivers[i]->deinit) {
+            s_context.drivers[i]->deinit();
+        }
     }
     
-    // Reset context
+    // Reset context (drivers must be registered again)
     memset(&s_context, 0, sizeof(s_context));
     
     ESP_LOGI(TAG, "Sensor service cleanup completed");
@@ -349,14 +879,5 @@ esp_err_t sensor_get_system_uptime(char *uptime_str, size_t max_len)
     int64_t current_time = esp_timer_get_time();
     int64_t uptime_seconds = (current_time - boot_time) / 1000000;
     
-    int hours = uptime_seconds / 3600;
-    int minutes = (uptime_seconds % 3600) / 60;
-    int seconds = uptime_seconds % 60;
-    
-    int written = snprintf(uptime_str, max_len, "%dh %dm %ds", hours, minutes, seconds);
-    if (written < 0 || written >= max_len) {
-        return ESP_ERR_INVALID_SIZE;
-    }
-    
-    return ESP_OK;
+    return sensor_service_format_duration((uint32_t)uptime_seconds, uptime_str, max_len);
 } 
\ No newline at end of file
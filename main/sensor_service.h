@@ -2,25 +2,37 @@
  * Sensor Service Module
  * 
  * Provides data collection services for system monitoring and sensor readings.
- * Currently implements CPU temperature simulation and system uptime tracking.
- * Designed to be extensible for GPIO-based sensors and additional data sources.
+ * Sensors are provided by drivers registered in a table indexed by
+ * sensor_type_t; the built-in drivers implement CPU temperature simulation
+ * and system uptime tracking. New sensors (GPIO, ADC, ...) only need a
+ * driver descriptor, the read loop and encoders pick them up unchanged.
  * 
  * Features:
+ * - Driver registry with per-driver sample interval and encoder hints
+ * - Compact table of enabled drivers iterated on every read
+ * - Optional high-rate background sampler feeding a lock-free ring
+ * - Typed single and multi-sensor reads sharing one timestamp
  * - CPU temperature simulation with realistic variations
  * - System uptime tracking and formatting
- * - Extensible sensor data structure
  * - Proper ESP-IDF error handling
- * - Ready for GPIO sensor integration
  * 
  * Usage:
  *   esp_err_t ret = sensor_service_init();
  *   ESP_ERROR_CHECK(ret);
- *   
+ * 
+ *   sensor_service_register_driver(&my_gpio_driver);   // optional, before or after init
+ * 
  *   sensor_data_t data;
  *   ret = sensor_service_read(&data);
  *   if (ret == ESP_OK) {
  *       printf("Temperature: %.1f°C, Uptime: %s\n", data.cpu_temp, data.uptime);
  *   }
+ * 
+ *   sensor_reading_t readings[] = {
+ *       { .type = SENSOR_TYPE_CPU_TEMP },
+ *       { .type = SENSOR_TYPE_ANALOG_1 },
+ *   };
+ *   sensor_service_read_many(readings, 2, NULL);
  */
 
 #ifndef SENSOR_SERVICE_H
@@ -28,27 +40,117 @@
 
 #include "esp_err.h"
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * Sensor Types Enumeration
+ * 
+ * Defines available sensor types for individual sensor operations.
+ * Each type is backed by at most one registered driver and indexes the
+ * value array in sensor_data_t.
+ */
+typedef enum {
+    SENSOR_TYPE_CPU_TEMP = 0,            // CPU temperature sensor
+    SENSOR_TYPE_UPTIME,                  // System uptime tracker
+    SENSOR_TYPE_ANALOG_1,                // Analog input (ADC pipeline, decimated)
+    // SENSOR_TYPE_GPIO_DIGITAL_1,       // Future: GPIO digital sensor 1
+    SENSOR_TYPE_MAX                      // Total number of sensor types
+} sensor_type_t;
+
+/*
+ * Sensor Value
+ * 
+ * A single reading. The active member is given by the driver's value_type.
+ */
+typedef union {
+    float f;                             // SENSOR_VALUE_FLOAT
+    int32_t i;                           // SENSOR_VALUE_INT
+    uint32_t u;                          // SENSOR_VALUE_UINT
+    bool b;                              // SENSOR_VALUE_BOOL
+} sensor_value_t;
+
+typedef enum {
+    SENSOR_VALUE_FLOAT = 0,
+    SENSOR_VALUE_INT,
+    SENSOR_VALUE_UINT,
+    SENSOR_VALUE_BOOL
+} sensor_value_type_t;
+
+/*
+ * Value Encoding Hint
+ * 
+ * Tells encoders how to present a value.
+ */
+typedef enum {
+    SENSOR_ENCODING_NUMBER = 0,          // Plain number (rounded to 'decimals')
+    SENSOR_ENCODING_DURATION,            // Seconds, formatted as "Xh Ym Zs"
+    SENSOR_ENCODING_BOOL                 // true/false
+} sensor_encoding_t;
+
+/*
+ * Sensor Driver Descriptor
+ * 
+ * Registered once per sensor type with sensor_service_register_driver().
+ * Descriptors must stay valid while registered (typically static const).
+ * init and deinit are optional; read is required.
+ */
+typedef struct {
+    sensor_type_t type;                  // Slot this driver provides
+    const char *name;                    // Short name for logs
+    const char *json_field;              // Field name used by encoders
+    sensor_value_type_t value_type;      // Member of sensor_value_t produced by read
+    sensor_encoding_t encoding;          // Encoder presentation hint
+    uint8_t decimals;                    // Decimal places kept by encoders (numbers)
+    uint32_t sample_interval_ms;         // Minimum time between reads, 0 = every read
+    esp_err_t (*init)(void);             // Prepare hardware (optional)
+    esp_err_t (*read)(sensor_value_t *value);
+    void (*deinit)(void);                // Release hardware (optional)
+} sensor_driver_t;
+
+/*
+ * Window Statistics of One Sensor
+ * 
+ * Filled in summaries produced by the aggregator.
+ */
+typedef struct {
+    uint32_t count;                      // Readings in the window
+    float min;
+    float max;
+    float mean;
+    float stddev;                        // Sample standard deviation
+    float p50;                           // Approximate percentiles
+    float p90;
+    float p99;
+} sensor_stats_t;
+
 /*
  * Sensor Data Structure
  * 
- * Contains all sensor readings and system data.
- * Designed to be extensible for additional sensors.
+ * Contains all sensor readings and system data. values[] is indexed by
+ * sensor_type_t and only entries with their bit set in valid_mask hold
+ * a reading. cpu_temp and uptime mirror the built-in sensors for
+ * existing users of the structure. Window summaries additionally carry
+ * per-sensor statistics in stats[] (stats_mask), with values[] holding
+ * the window means.
  */
 typedef struct {
+    // Registered sensors
+    sensor_value_t values[SENSOR_TYPE_MAX]; // Readings indexed by sensor_type_t
+    uint32_t valid_mask;                 // Bit (1 << type) set for each valid reading
+    
     // System sensors
     float cpu_temp;                      // Simulated CPU temperature in Celsius
     char uptime[32];                     // Formatted system uptime string
     
-    // Future expansion ready
-    // float gpio_sensor_1;              // GPIO-based sensor 1
-    // float gpio_sensor_2;              // GPIO-based sensor 2
-    // bool digital_input_1;             // Digital input state
-    // uint32_t counter_value;           // Event counter
+    // Window statistics (aggregated summaries only)
+    uint32_t stats_mask;                 // Bit (1 << type) set for each entry in stats[]
+    uint32_t window_ms;                  // Window length covered by stats[]
+    sensor_stats_t stats[SENSOR_TYPE_MAX];
     
     // Metadata
     uint64_t timestamp_us;               // Timestamp when data was collected (microseconds)
@@ -56,18 +158,29 @@ typedef struct {
 } sensor_data_t;
 
 /*
- * Sensor Types Enumeration
+ * Sampler Record
  * 
- * Defines available sensor types for individual sensor operations.
- * Useful for enabling/disabling specific sensors or error handling.
+ * Fixed-size record produced by the background sampler for every tick.
  */
-typedef enum {
-    SENSOR_TYPE_CPU_TEMP = 0,            // CPU temperature sensor
-    SENSOR_TYPE_UPTIME,                  // System uptime tracker
-    // SENSOR_TYPE_GPIO_ANALOG_1,        // Future: GPIO analog sensor 1
-    // SENSOR_TYPE_GPIO_DIGITAL_1,       // Future: GPIO digital sensor 1
-    SENSOR_TYPE_MAX                      // Total number of sensor types
-} sensor_type_t;
+typedef struct {
+    int64_t timestamp_us;                // Time of the reading (microseconds since boot)
+    uint32_t valid_mask;                 // Bit (1 << type) set for each valid reading
+    sensor_value_t values[SENSOR_TYPE_MAX]; // Readings indexed by sensor_type_t
+} sensor_record_t;
+
+/*
+ * Tagged Sensor Reading
+ * 
+ * Request and result of sensor_service_read_value() and
+ * sensor_service_read_many(): the caller sets type, the service fills in
+ * the rest. value_type names the member of value that holds the reading.
+ */
+typedef struct {
+    sensor_type_t type;                  // Sensor to read (set by the caller)
+    esp_err_t status;                    // Result for this sensor
+    sensor_value_type_t value_type;      // Active member of value
+    sensor_value_t value;                // Reading, valid when status == ESP_OK
+} sensor_reading_t;
 
 /*
  * Sensor Status Information
@@ -78,6 +191,16 @@ typedef struct {
     uint32_t read_count;                 // Total number of successful reads
     uint32_t error_count;                // Total number of read errors
     int64_t last_read_time;              // Timestamp of last successful read
+    uint32_t driver_reads[SENSOR_TYPE_MAX];   // Driver read calls per sensor
+    uint32_t driver_read_ns[SENSOR_TYPE_MAX]; // Average acquisition cost per driver read
+    
+    // Background sampler
+    bool sampler_running;                // Sampler task active
+    uint32_t sampler_rate_hz;            // Sampling rate
+    uint32_t sampler_records;            // Records produced
+    uint32_t sampler_overflows;          // Records dropped because the ring was full
+    uint32_t sampler_pending;            // Records waiting to be drained
+    uint32_t sampler_high_water;         // Largest ring fill level seen
 } sensor_status_t;
 
 /*
@@ -121,11 +244,14 @@ esp_err_t sensor_service_read(sensor_data_t *data);
  * Read Specific Sensor
  * 
  * Reads data from a specific sensor type without affecting others.
- * Useful for selective monitoring or troubleshooting individual sensors.
+ * Kept for existing callers; sensor_service_read_value() returns the same
+ * reading with its type instead of writing through an untyped pointer.
  * 
  * Parameters:
  *   sensor_type: Type of sensor to read
- *   value: Pointer to store sensor value (format depends on sensor type)
+ *   value: Pointer to store sensor value (format depends on sensor type:
+ *          the driver's value type, or a char[UPTIME_STRING_MAX_LEN]
+ *          buffer for SENSOR_ENCODING_DURATION sensors)
  * 
  * Returns:
  *   ESP_OK: Sensor read successfully
@@ -136,6 +262,153 @@ esp_err_t sensor_service_read(sensor_data_t *data);
  */
 esp_err_t sensor_service_read_single(sensor_type_t sensor_type, void *value);
 
+/*
+ * Read One Sensor
+ * 
+ * Typed single-sensor read. Sensors with a sample interval return their
+ * cached value until the interval has elapsed, as in sensor_service_read().
+ * 
+ * Parameters:
+ *   sensor_type: Type of sensor to read
+ *   reading: Filled with the type, value type, value and status
+ * 
+ * Returns:
+ *   ESP_OK: Sensor read successfully
+ *   ESP_ERR_INVALID_ARG: Invalid pointer or sensor type
+ *   ESP_ERR_NOT_SUPPORTED: No driver registered for the type
+ *   ESP_ERR_INVALID_STATE: Service not initialized, sampler running or sensor disabled
+ *   ESP_ERR_*: Driver read error
+ */
+esp_err_t sensor_service_read_value(sensor_type_t sensor_type, sensor_reading_t *reading);
+
+/*
+ * Read Several Sensors
+ * 
+ * Reads the sensors named in readings[i].type in one call: the service
+ * state is checked once and every reading shares one timestamp. Each
+ * entry gets its own status, so one failing sensor does not hide the
+ * others.
+ * 
+ * Parameters:
+ *   readings: Array of requests, filled in place
+ *   count: Number of entries
+ *   timestamp_us: Time of the readings (may be NULL)
+ * 
+ * Returns:
+ *   ESP_OK: All sensors read successfully
+ *   ESP_ERR_INVALID_ARG: Invalid pointer or empty array
+ *   ESP_ERR_INVALID_STATE: Service not initialized or sampler running
+ *   ESP_FAIL: One or more entries failed (see their status)
+ */
+esp_err_t sensor_service_read_many(sensor_reading_t *readings, size_t count, int64_t *timestamp_us);
+
+/*
+ * Register Sensor Driver
+ * 
+ * Installs a driver for its sensor type, replacing any driver already
+ * registered for that type (the built-in drivers are only installed for
+ * types without a driver, so registering before sensor_service_init()
+ * overrides them). When the service is already initialized, the driver
+ * is initialized immediately. Newly registered drivers are enabled.
+ * 
+ * Parameters:
+ *   driver: Driver descriptor (must remain valid while registered)
+ * 
+ * Returns:
+ *   ESP_OK: Driver registered
+ *   ESP_ERR_INVALID_ARG: Invalid descriptor
+ *   ESP_ERR_*: Driver init failed (driver stays registered but disabled)
+ */
+esp_err_t sensor_service_register_driver(const sensor_driver_t *driver);
+
+/*
+ * Get Registered Driver
+ * 
+ * Parameters:
+ *   sensor_type: Sensor type
+ * 
+ * Returns:
+ *   const sensor_driver_t*: Registered driver, or NULL if none
+ */
+const sensor_driver_t *sensor_service_get_driver(sensor_type_t sensor_type);
+
+/*
+ * Format Duration
+ * 
+ * Formats seconds in the "Xh Ym Zs" form used for uptime values.
+ * 
+ * Parameters:
+ *   seconds: Duration in seconds
+ *   buffer: Destination buffer
+ *   max_len: Size of the destination buffer
+ * 
+ * Returns:
+ *   ESP_OK: Duration formatted
+ *   ESP_ERR_INVALID_ARG: Invalid buffer
+ *   ESP_ERR_INVALID_SIZE: Buffer too small
+ */
+esp_err_t sensor_service_format_duration(uint32_t seconds, char *buffer, size_t max_len);
+
+/*
+ * Start Background Sampler
+ * 
+ * Starts a task that reads all enabled sensors at rate_hz into a lock-free
+ * single-producer/single-consumer ring of SAMPLER_RING_CAPACITY records.
+ * The ticks come from a periodic esp_timer, so rates above the FreeRTOS
+ * tick rate are possible. While the sampler runs it owns the drivers:
+ * sensor_service_read(), the single-sensor reads, driver registration
+ * and enable/disable return ESP_ERR_INVALID_STATE; use
+ * sensor_service_drain() from a single consumer task instead.
+ * 
+ * Parameters:
+ *   rate_hz: Sampling rate (1 - SAMPLER_MAX_RATE_HZ)
+ * 
+ * Returns:
+ *   ESP_OK: Sampler started
+ *   ESP_ERR_INVALID_ARG: Invalid rate
+ *   ESP_ERR_INVALID_STATE: Service not initialized or sampler already running
+ *   ESP_ERR_NO_MEM: Failed to create sampler task or timer
+ */
+esp_err_t sensor_service_start_sampler(uint32_t rate_hz);
+
+/*
+ * Stop Background Sampler
+ * 
+ * Stops the sampler and waits for its task to exit. Records still in the
+ * ring can be drained afterwards.
+ * 
+ * Returns:
+ *   ESP_OK: Sampler stopped (or was not running)
+ */
+esp_err_t sensor_service_stop_sampler(void);
+
+/*
+ * Drain Sampler Records
+ * 
+ * Removes up to max_count of the oldest records from the sampler ring.
+ * Must only be called from one task at a time.
+ * 
+ * Parameters:
+ *   records: Destination array
+ *   max_count: Capacity of the destination array
+ * 
+ * Returns:
+ *   size_t: Number of records drained
+ */
+size_t sensor_service_drain(sensor_record_t *records, size_t max_count);
+
+/*
+ * Convert Sampler Record
+ * 
+ * Fills a sensor_data_t (including the cpu_temp and uptime fields) from
+ * a sampler record.
+ * 
+ * Parameters:
+ *   record: Sampler record
+ *   data: Pointer to sensor_data_t structure to populate
+ */
+void sensor_service_record_to_data(const sensor_record_t *record, sensor_data_t *data);
+
 /*
  * Enable/Disable Specific Sensor
  * 
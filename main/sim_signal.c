@@ -0,0 +1,216 @@
+/*
+ * Simulated Signal Implementation
+ * 
+ * Phase is a 32-bit fraction of a period. The sine table holds one full
+ * period in SIM_SINE_TABLE_SIZE segments; the top bits of the phase select
+ * the segment and the next 16 bits interpolate linearly within it.
+ */
+
+#include "sim_signal.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+
+// Module logging tag
+static const char *TAG = "SIM_SIGNAL";
+
+#define SIM_SINE_TABLE_BITS   8
+#define SIM_SINE_TABLE_SIZE   (1 << SIM_SINE_TABLE_BITS)
+#define SIM_DEFAULT_SEED      0x2545F491u
+
+// Full period sine in Q15, one guard entry for interpolation
+static int16_t s_sine_table[SIM_SINE_TABLE_SIZE + 1];
+static bool s_sine_table_ready = false;
+
+/*
+ * Internal function to build the sine table (once)
+ */
+static void build_sine_table(void)
+{
+    if (s_sine_table_ready) {
+        return;
+    }
+    
+    for (int i = 0; i <= SIM_SINE_TABLE_SIZE; i++) {
+        s_sine_table[i] = (int16_t)lroundf(32767.0f * sinf(2.0f * (float)M_PI * i / SIM_SINE_TABLE_SIZE));
+    }
+    s_sine_table_ready = true;
+}
+
+/*
+ * Internal function to evaluate a waveform at a phase (Q15 result)
+ */
+static inline int32_t waveform_q15(uint8_t waveform, uint32_t phase)
+{
+    switch (waveform) {
+        case SIM_WAVE_SINE: {
+            uint32_t index = phase >> (32 - SIM_SINE_TABLE_BITS);
+            int32_t frac = (int32_t)((phase >> (16 - SIM_SINE_TABLE_BITS)) & 0xFFFF);
+            int32_t a = s_sine_table[index];
+            int32_t b = s_sine_table[index + 1];
+            return a + (((b - a) * frac) >> 16);
+        }
+        case SIM_WAVE_TRIANGLE: {
+            // Shifted by a quarter period so it starts at zero rising, like the sine
+            uint32_t u = phase + 0x40000000u;
+            uint32_t folded = (u & 0x80000000u) ? ~u : u;
+            return (int32_t)(folded >> 15) - 32768;
+        }
+        case SIM_WAVE_SQUARE:
+            return (phase & 0x80000000u) ? -32767 : 32767;
+        case SIM_WAVE_SAWTOOTH:
+            return (int32_t)(phase >> 16) - 32768;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Internal function to advance the xorshift32 generator
+ */
+static inline uint32_t next_random(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*
+ * Initialize Signal Generator
+ */
+esp_err_t sim_signal_init(sim_signal_t *signal, const sim_signal_config_t *config)
+{
+    if (!signal || !config ||
+        config->waveform > SIM_WAVE_CONSTANT || config->noise > SIM_NOISE_GAUSSIAN) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->waveform != SIM_WAVE_CONSTANT && config->period_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    build_sine_table();
+    
+    uint64_t period_us = (uint64_t)config->period_ms * 1000;
+    signal->phase_rate = period_us ? ((1ULL << 48) + period_us / 2) / period_us : 0;
+    signal->phase_offset = (uint32_t)(fmodf(config->phase, 1.0f) * 4294967296.0f);
+    signal->rng = config->seed ? config->seed : SIM_DEFAULT_SEED;
+    signal->offset = config->offset;
+    signal->wave_scale = config->amplitude / 32768.0f;
+    signal->min = config->min;
+    signal->max = config->max;
+    signal->waveform = (uint8_t)config->waveform;
+    signal->noise = (uint8_t)config->noise;
+    signal->clamp = config->min < config->max;
+    
+    // Gaussian noise sums four uniform draws (variance 4/3 in Q15 units)
+    if (config->noise == SIM_NOISE_GAUSSIAN) {
+        signal->noise_scale = config->noise_amplitude * 0.8660254f / 32768.0f;
+    } else {
+        signal->noise_scale = config->noise_amplitude / 32768.0f;
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Sample Signal
+ */
+float sim_signal_sample(sim_signal_t *signal, int64_t time_us)
+{
+    // Wraps modulo 2^64; bits 16..47 hold the fractional period
+    uint32_t phase = (uint32_t)(((uint64_t)time_us * signal->phase_rate) >> 16) + signal->phase_offset;
+    float value = signal->offset + (float)waveform_q15(signal->waveform, phase) * signal->wave_scale;
+    
+    if (signal->noise == SIM_NOISE_UNIFORM) {
+        int32_t u = (int32_t)(next_random(&signal->rng) >> 16) - 32768;
+        value += (float)u * signal->noise_scale;
+    } else if (signal->noise == SIM_NOISE_GAUSSIAN) {
+        uint32_t r1 = next_random(&signal->rng);
+        uint32_t r2 = next_random(&signal->rng);
+        int32_t sum = (int32_t)(r1 >> 16) + (int32_t)(r1 & 0xFFFF) +
+                      (int32_t)(r2 >> 16) + (int32_t)(r2 & 0xFFFF) - 4 * 32768;
+        value += (float)sum * signal->noise_scale;
+    }
+    
+    if (signal->clamp) {
+        if (value < signal->min) value = signal->min;
+        if (value > signal->max) value = signal->max;
+    }
+    
+    return value;
+}
+
+/*
+ * Internal function reproducing the previous simulation model
+ */
+static float reference_sample(const sim_signal_config_t *config, int64_t time_us)
+{
+    double time_seconds = time_us / 1000000.0;
+    return config->offset + config->amplitude *
+           sin(time_seconds * 2.0 * 3.14159 / (config->period_ms / 1000.0));
+}
+
+/*
+ * Benchmark Against Double Precision Model
+ */
+esp_err_t sim_signal_benchmark(const sim_signal_config_t *config, uint32_t iterations,
+                               sim_signal_bench_t *result)
+{
+    if (!config || !result || iterations == 0 || config->waveform != SIM_WAVE_SINE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    sim_signal_config_t clean = *config;
+    clean.noise = SIM_NOISE_NONE;
+    clean.phase = 0.0f;
+    clean.min = clean.max = 0.0f;
+    
+    sim_signal_t signal;
+    esp_err_t ret = sim_signal_init(&signal, &clean);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    // Timestamps step by a prime number of microseconds to cover all phases
+    const int64_t step_us = 7919;
+    volatile float sink = 0.0f;
+    
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink = reference_sample(&clean, (int64_t)i * step_us);
+    }
+    int64_t reference_us = esp_timer_get_time() - start;
+    
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink = sim_signal_sample(&signal, (int64_t)i * step_us);
+    }
+    int64_t table_us = esp_timer_get_time() - start;
+    (void)sink;
+    
+    // Accuracy against the exact sine (untimed)
+    double period_us = (double)clean.period_ms * 1000.0;
+    float max_error = 0.0f;
+    for (uint32_t i = 0; i < iterations; i++) {
+        int64_t t = (int64_t)i * step_us;
+        double exact = clean.offset + clean.amplitude * sin(2.0 * M_PI * fmod((double)t, period_us) / period_us);
+        float error = fabsf((float)(sim_signal_sample(&signal, t) - exact));
+        if (error > max_error) {
+            max_error = error;
+        }
+    }
+    
+    result->iterations = iterations;
+    result->reference_ns = reference_us * 1000.0f / iterations;
+    result->table_ns = table_us * 1000.0f / iterations;
+    result->max_error = max_error;
+    
+    ESP_LOGI(TAG, "Benchmark (%lu samples): sin() %.1f ns, table %.1f ns, max error %.4f",
+             (unsigned long)iterations, result->reference_ns, result->table_ns, max_error);
+    return ESP_OK;
+}
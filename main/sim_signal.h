@@ -0,0 +1,154 @@
+/*
+ * Simulated Signal Module
+ * 
+ * Cheap waveform and noise generators for simulated sensors. A signal is
+ * evaluated directly from a timestamp: a 64-bit multiply turns the time
+ * into a 32-bit phase, the waveform is looked up in a shared Q15 sine
+ * table (or computed from the phase for the other shapes) and scaled with
+ * a single float multiply. No double precision math or libm call is made
+ * per sample, so hundreds of virtual sensors can be sampled at high rates
+ * on the single-precision FPU of the ESP32-S3.
+ * 
+ * Features:
+ * - Sine (interpolated table), triangle, square, sawtooth and constant waveforms
+ * - Stateless phase: any number of readers can sample the same signal
+ * - Uniform or approximately Gaussian noise from a per-signal xorshift generator
+ * - Optional clamping to a realistic range
+ * - Micro-benchmark against the double precision sin() model
+ * 
+ * Usage:
+ *   static sim_signal_t s_signal;
+ *   sim_signal_config_t cfg = {
+ *       .waveform = SIM_WAVE_SINE, .offset = 28.0f, .amplitude = 5.0f,
+ *       .period_ms = 300000, .noise = SIM_NOISE_UNIFORM, .noise_amplitude = 0.8f
+ *   };
+ *   sim_signal_init(&s_signal, &cfg);
+ * 
+ *   float value = sim_signal_sample(&s_signal, esp_timer_get_time());
+ */
+
+#ifndef SIM_SIGNAL_H
+#define SIM_SIGNAL_H
+
+#include "esp_err.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Waveform Shapes
+ */
+typedef enum {
+    SIM_WAVE_SINE = 0,
+    SIM_WAVE_TRIANGLE,
+    SIM_WAVE_SQUARE,
+    SIM_WAVE_SAWTOOTH,
+    SIM_WAVE_CONSTANT
+} sim_waveform_t;
+
+/*
+ * Noise Generators
+ */
+typedef enum {
+    SIM_NOISE_NONE = 0,
+    SIM_NOISE_UNIFORM,                   // Uniform in [-noise_amplitude, noise_amplitude)
+    SIM_NOISE_GAUSSIAN                   // Approximately normal, noise_amplitude = standard deviation
+} sim_noise_t;
+
+/*
+ * Signal Configuration
+ */
+typedef struct {
+    sim_waveform_t waveform;
+    float offset;                        // Value at the waveform's zero crossing
+    float amplitude;                     // Peak deviation from offset
+    uint32_t period_ms;                  // Waveform period (ignored for SIM_WAVE_CONSTANT)
+    float phase;                         // Start phase as fraction of a period (0.0 - 1.0)
+    sim_noise_t noise;
+    float noise_amplitude;
+    uint32_t seed;                       // Noise seed (0 = default)
+    float min;                           // Clamp range, applied when min < max
+    float max;
+} sim_signal_config_t;
+
+/*
+ * Signal Generator State
+ * 
+ * Filled by sim_signal_init(); treat as opaque.
+ */
+typedef struct {
+    uint64_t phase_rate;                 // Phase advance per microsecond (2^-48 periods)
+    uint32_t phase_offset;               // Start phase (2^-32 periods)
+    uint32_t rng;                        // xorshift32 state
+    float offset;
+    float wave_scale;                    // amplitude / 32768
+    float noise_scale;
+    float min;
+    float max;
+    uint8_t waveform;                    // sim_waveform_t
+    uint8_t noise;                       // sim_noise_t
+    uint8_t clamp;
+} sim_signal_t;
+
+/*
+ * Benchmark Result
+ */
+typedef struct {
+    uint32_t iterations;
+    float reference_ns;                  // Per sample, double precision sin() model
+    float table_ns;                      // Per sample, sim_signal_sample()
+    float max_error;                     // Largest deviation from the exact waveform (sensor units)
+} sim_signal_bench_t;
+
+/*
+ * Initialize Signal Generator
+ * 
+ * Parameters:
+ *   signal: Generator state to initialize
+ *   config: Waveform, noise and range settings
+ * 
+ * Returns:
+ *   ESP_OK: Generator ready
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, waveform, noise type or zero period
+ */
+esp_err_t sim_signal_init(sim_signal_t *signal, const sim_signal_config_t *config);
+
+/*
+ * Sample Signal
+ * 
+ * Parameters:
+ *   signal: Initialized generator
+ *   time_us: Sample time (microseconds, usually esp_timer_get_time())
+ * 
+ * Returns:
+ *   Signal value at time_us including noise and clamping
+ */
+float sim_signal_sample(sim_signal_t *signal, int64_t time_us);
+
+/*
+ * Benchmark Against Double Precision Model
+ * 
+ * Times the previous simulation model (double precision sin() of the
+ * elapsed time) and sim_signal_sample() over the same timestamps, and
+ * measures the table error against the exact sine. Noise is disabled for
+ * the comparison.
+ * 
+ * Parameters:
+ *   config: Sine signal to benchmark
+ *   iterations: Samples per timed loop
+ *   result: Pointer to sim_signal_bench_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Benchmark completed
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, non-sine config or zero iterations
+ */
+esp_err_t sim_signal_benchmark(const sim_signal_config_t *config, uint32_t iterations,
+                               sim_signal_bench_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SIM_SIGNAL_H
@@ -0,0 +1,98 @@
+/*
+ * SPSC Ring Buffer Implementation
+ * 
+ * The producer publishes a record by storing it and then advancing tail
+ * with release ordering; the consumer reads tail with acquire ordering
+ * before touching the record, and hands the slot back by advancing head
+ * with release ordering. No other synchronization is needed for one
+ * producer and one consumer.
+ */
+
+#include "spsc_ring.h"
+
+#include <string.h>
+
+/*
+ * Initialize Ring
+ */
+esp_err_t spsc_ring_init(spsc_ring_t *ring, void *storage, size_t record_size, uint32_t capacity)
+{
+    if (!ring || !storage || record_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    ring->storage = (uint8_t *)storage;
+    ring->record_size = record_size;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->overflows, 0);
+    atomic_init(&ring->high_water, 0);
+    
+    return ESP_OK;
+}
+
+/*
+ * Push Record
+ */
+bool spsc_ring_push(spsc_ring_t *ring, const void *record)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint32_t used = tail - head;
+    
+    if (used > ring->mask) {
+        atomic_fetch_add_explicit(&ring->overflows, 1, memory_order_relaxed);
+        return false;
+    }
+    
+    memcpy(ring->storage + (size_t)(tail & ring->mask) * ring->record_size, record, ring->record_size);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    
+    if (used + 1 > atomic_load_explicit(&ring->high_water, memory_order_relaxed)) {
+        atomic_store_explicit(&ring->high_water, used + 1, memory_order_relaxed);
+    }
+    
+    return true;
+}
+
+/*
+ * Pop Records in Bulk
+ */
+size_t spsc_ring_pop_bulk(spsc_ring_t *ring, void *records, size_t max_count)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t count = tail - head;
+    
+    if (count > max_count) {
+        count = max_count;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    // Copy in at most two runs: up to the end of storage, then from the start
+    uint32_t capacity = ring->mask + 1;
+    uint32_t start = head & ring->mask;
+    size_t first = (count < capacity - start) ? count : capacity - start;
+    uint8_t *out = (uint8_t *)records;
+    
+    memcpy(out, ring->storage + (size_t)start * ring->record_size, first * ring->record_size);
+    if (count > first) {
+        memcpy(out + first * ring->record_size, ring->storage, (count - first) * ring->record_size);
+    }
+    
+    atomic_store_explicit(&ring->head, head + count, memory_order_release);
+    return count;
+}
+
+/*
+ * Get Fill Level
+ */
+uint32_t spsc_ring_count(const spsc_ring_t *ring)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return tail - head;
+}
@@ -0,0 +1,109 @@
+/*
+ * SPSC Ring Buffer Module
+ * 
+ * Lock-free single-producer/single-consumer ring of fixed-size records.
+ * One task pushes, another pops; neither blocks nor takes a lock, so the
+ * producer can run at a high rate without being held up by a consumer
+ * that is busy with slow work such as network I/O.
+ * 
+ * Features:
+ * - Fixed-size records in caller-provided storage (no allocation)
+ * - Power-of-two capacity, indices wrap with a mask
+ * - Bulk pop for the consumer
+ * - Overflow (dropped push) and high-water statistics
+ * 
+ * Usage:
+ *   static my_record_t storage[256];
+ *   static spsc_ring_t ring;
+ *   spsc_ring_init(&ring, storage, sizeof(my_record_t), 256);
+ * 
+ *   // Producer task
+ *   spsc_ring_push(&ring, &record);
+ * 
+ *   // Consumer task
+ *   size_t n = spsc_ring_pop_bulk(&ring, records, ARRAY_SIZE(records));
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include "esp_err.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Ring Buffer
+ * 
+ * head is only written by the consumer and tail only by the producer.
+ * Both are free-running counters; the slot index is counter & mask.
+ */
+typedef struct {
+    uint8_t *storage;                    // capacity * record_size bytes
+    size_t record_size;                  // Size of one record in bytes
+    uint32_t mask;                       // capacity - 1
+    _Atomic uint32_t head;               // Next record to pop (consumer)
+    _Atomic uint32_t tail;               // Next slot to push (producer)
+    _Atomic uint32_t overflows;          // Pushes dropped because the ring was full
+    _Atomic uint32_t high_water;         // Largest fill level seen by the producer
+} spsc_ring_t;
+
+/*
+ * Initialize Ring
+ * 
+ * Parameters:
+ *   ring: Ring to initialize
+ *   storage: Record storage of capacity * record_size bytes
+ *   record_size: Size of one record in bytes
+ *   capacity: Number of records (must be a power of two)
+ * 
+ * Returns:
+ *   ESP_OK: Ring initialized
+ *   ESP_ERR_INVALID_ARG: Invalid pointer, size or capacity
+ */
+esp_err_t spsc_ring_init(spsc_ring_t *ring, void *storage, size_t record_size, uint32_t capacity);
+
+/*
+ * Push Record (producer only)
+ * 
+ * Parameters:
+ *   ring: Ring buffer
+ *   record: Record to copy into the ring
+ * 
+ * Returns:
+ *   true: Record stored
+ *   false: Ring full, record dropped and counted as overflow
+ */
+bool spsc_ring_push(spsc_ring_t *ring, const void *record);
+
+/*
+ * Pop Records in Bulk (consumer only)
+ * 
+ * Parameters:
+ *   ring: Ring buffer
+ *   records: Destination array of at least max_count records
+ *   max_count: Maximum number of records to pop
+ * 
+ * Returns:
+ *   size_t: Number of records popped (oldest first)
+ */
+size_t spsc_ring_pop_bulk(spsc_ring_t *ring, void *records, size_t max_count);
+
+/*
+ * Get Fill Level
+ * 
+ * Returns:
+ *   uint32_t: Number of records currently in the ring
+ */
+uint32_t spsc_ring_count(const spsc_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPSC_RING_H
@@ -0,0 +1,99 @@
+/*
+ * Statistics Block Implementation
+ * 
+ * Writers announce a group by incrementing 'writers' and publish it by
+ * incrementing 'generation' before leaving. A reader accepts a copy only
+ * if no group was active when it started and the generation did not move
+ * while it copied, which is the seqlock rule extended to many writers.
+ * A release fence after announcing a group pairs with the reader's
+ * acquire fence after its copy: a reader that sees any counter written
+ * inside the group also sees 'writers' raised and rejects the copy. The
+ * read-modify-write on 'generation' releases the updates at group end.
+ */
+
+#include "stats_block.h"
+
+// Copies attempted before a snapshot gives up on consistency
+#define STATS_SNAPSHOT_ATTEMPTS    8
+
+/*
+ * Begin Update Group
+ */
+void stats_update_begin(stats_block_t *block)
+{
+    atomic_fetch_add(&block->writers, 1);
+    
+    // Keep the counter updates that follow from becoming visible first
+    atomic_thread_fence(memory_order_release);
+}
+
+/*
+ * End Update Group
+ */
+void stats_update_end(stats_block_t *block)
+{
+    atomic_fetch_add(&block->generation, 1);
+    atomic_fetch_sub(&block->writers, 1);
+}
+
+/*
+ * Add to 64-bit Counter
+ */
+void stats_add64(stats_block_t *block, size_t index, uint64_t value)
+{
+    uint32_t low = (uint32_t)value;
+    uint32_t high = (uint32_t)(value >> 32);
+    
+    // The returned old value tells each writer whether its own add carried
+    uint32_t old = atomic_fetch_add_explicit(&block->counters[index], low, memory_order_relaxed);
+    if ((uint32_t)(old + low) < old) {
+        high++;
+    }
+    if (high != 0) {
+        atomic_fetch_add_explicit(&block->counters[index + 1], high, memory_order_relaxed);
+    }
+}
+
+/*
+ * Set 64-bit Gauge
+ */
+void stats_set64(stats_block_t *block, size_t index, uint64_t value)
+{
+    atomic_store_explicit(&block->counters[index], (uint32_t)value, memory_order_relaxed);
+    atomic_store_explicit(&block->counters[index + 1], (uint32_t)(value >> 32), memory_order_relaxed);
+}
+
+/*
+ * Take Consistent Snapshot
+ */
+bool stats_snapshot(stats_block_t *block, uint32_t *out)
+{
+    for (int attempt = 0; attempt < STATS_SNAPSHOT_ATTEMPTS; attempt++) {
+        uint32_t generation = atomic_load(&block->generation);
+        bool quiet = (atomic_load(&block->writers) == 0);
+        
+        for (size_t i = 0; i < block->count; i++) {
+            out[i] = atomic_load_explicit(&block->counters[i], memory_order_relaxed);
+        }
+        atomic_thread_fence(memory_order_acquire);
+        
+        if (quiet && atomic_load(&block->writers) == 0 &&
+            atomic_load(&block->generation) == generation) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/*
+ * Reset All Counters
+ */
+void stats_reset(stats_block_t *block)
+{
+    stats_update_begin(block);
+    for (size_t i = 0; i < block->count; i++) {
+        atomic_store_explicit(&block->counters[i], 0, memory_order_relaxed);
+    }
+    stats_update_end(block);
+}
@@ -0,0 +1,191 @@
+/*
+ * Statistics Block Module
+ * 
+ * Lock-free statistics counters shared by all modules. A block is a
+ * fixed array of 32-bit atomic counters indexed by a module-defined enum.
+ * Any task or core may update it without a mutex: increments are single
+ * relaxed atomic additions, so hot paths never contend on a lock and no
+ * update is lost.
+ * 
+ * Updates that belong together (request counted and its outcome, a
+ * reading and its cost) are bracketed by stats_update_begin() and
+ * stats_update_end(). stats_snapshot() copies the block and retries while
+ * such a group is in flight, so a snapshot never shows half of a group
+ * (e.g. a request counted in total but in neither success nor failure).
+ * Writers never wait for readers.
+ * 
+ * 64-bit values (byte totals, timestamps) occupy two consecutive slots
+ * (low word first) and are combined with stats_get64() from a snapshot.
+ * They must be updated inside a group to be read consistently.
+ * 
+ * Features:
+ * - Lock-free multi-writer counters
+ * - Consistent multi-counter snapshots
+ * - 64-bit counters and gauges on 32-bit atomics
+ * 
+ * Usage:
+ *   enum { MY_STAT_TOTAL, MY_STAT_FAILED, MY_STAT_BYTES, MY_STAT_BYTES_HI, MY_STAT_COUNT };
+ *   STATS_BLOCK_DEFINE(s_stats, MY_STAT_COUNT);
+ * 
+ *   stats_update_begin(&s_stats);
+ *   stats_inc(&s_stats, MY_STAT_TOTAL);
+ *   stats_add64(&s_stats, MY_STAT_BYTES, len);
+ *   stats_update_end(&s_stats);
+ * 
+ *   uint32_t values[MY_STAT_COUNT];
+ *   stats_snapshot(&s_stats, values);
+ */
+
+#ifndef STATS_BLOCK_H
+#define STATS_BLOCK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Statistics Block
+ * 
+ * Define with STATS_BLOCK_DEFINE(); fields are private.
+ */
+typedef struct {
+    _Atomic uint32_t writers;            // Update groups in progress
+    _Atomic uint32_t generation;         // Update groups completed
+    _Atomic uint32_t *counters;          // Counter storage
+    size_t count;                        // Number of counters
+} stats_block_t;
+
+// Define a statically allocated block with 'size' counters
+#define STATS_BLOCK_DEFINE(name, size)                                    \
+    static _Atomic uint32_t name##_counters[(size)];                      \
+    static stats_block_t name = { .counters = name##_counters, .count = (size) }
+
+/*
+ * Add to Counter
+ * 
+ * Parameters:
+ *   block: Statistics block
+ *   index: Counter index
+ *   value: Amount to add (wraps at 2^32)
+ */
+static inline void stats_add(stats_block_t *block, size_t index, uint32_t value)
+{
+    atomic_fetch_add_explicit(&block->counters[index], value, memory_order_relaxed);
+}
+
+/*
+ * Increment Counter
+ */
+static inline void stats_inc(stats_block_t *block, size_t index)
+{
+    stats_add(block, index, 1);
+}
+
+/*
+ * Set Gauge
+ * 
+ * Parameters:
+ *   block: Statistics block
+ *   index: Counter index
+ *   value: New value
+ */
+static inline void stats_set(stats_block_t *block, size_t index, uint32_t value)
+{
+    atomic_store_explicit(&block->counters[index], value, memory_order_relaxed);
+}
+
+/*
+ * Read One Counter
+ * 
+ * For a single value; use stats_snapshot() to read related counters.
+ */
+static inline uint32_t stats_get(stats_block_t *block, size_t index)
+{
+    return atomic_load_explicit(&block->counters[index], memory_order_relaxed);
+}
+
+/*
+ * Get 64-bit Value from a Snapshot
+ * 
+ * Parameters:
+ *   snapshot: Values filled by stats_snapshot()
+ *   index: Index of the low word
+ */
+static inline uint64_t stats_get64(const uint32_t *snapshot, size_t index)
+{
+    return ((uint64_t)snapshot[index + 1] << 32) | snapshot[index];
+}
+
+/*
+ * Begin Update Group
+ * 
+ * Snapshots taken until the matching stats_update_end() retry. Groups
+ * may run concurrently on several tasks; keep them short and never block
+ * inside one.
+ */
+void stats_update_begin(stats_block_t *block);
+
+/*
+ * End Update Group
+ */
+void stats_update_end(stats_block_t *block);
+
+/*
+ * Add to 64-bit Counter
+ * 
+ * Call inside an update group.
+ * 
+ * Parameters:
+ *   block: Statistics block
+ *   index: Index of the low word (the high word follows it)
+ *   value: Amount to add
+ */
+void stats_add64(stats_block_t *block, size_t index, uint64_t value);
+
+/*
+ * Set 64-bit Gauge
+ * 
+ * Call inside an update group.
+ * 
+ * Parameters:
+ *   block: Statistics block
+ *   index: Index of the low word (the high word follows it)
+ *   value: New value
+ */
+void stats_set64(stats_block_t *block, size_t index, uint64_t value);
+
+/*
+ * Take Consistent Snapshot
+ * 
+ * Copies all counters. Retries while an update group is in progress; if
+ * groups keep overlapping (e.g. a writer preempted by the reader on the
+ * same core), the last copy is returned, in which every counter is still
+ * individually correct.
+ * 
+ * Parameters:
+ *   block: Statistics block
+ *   out: Array of block->count values to fill
+ * 
+ * Returns:
+ *   true if the snapshot is consistent across update groups
+ */
+bool stats_snapshot(stats_block_t *block, uint32_t *out);
+
+/*
+ * Reset All Counters
+ * 
+ * Parameters:
+ *   block: Statistics block
+ */
+void stats_reset(stats_block_t *block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STATS_BLOCK_H
@@ -0,0 +1,260 @@
+/*
+ * Task Profiler Implementation
+ * 
+ * The sample timer runs in the esp_timer task. It keeps the run-time
+ * counter of every task from the previous sample, keyed by task number,
+ * and turns the differences into shares of the window. Tasks deleted
+ * during a window are not listed, so the CPU load is derived from the
+ * idle tasks rather than summed over the listed ones.
+ */
+
+#include "task_profiler.h"
+#include "config.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "TASK_PROFILER";
+
+#if defined(CONFIG_FREERTOS_USE_TRACE_FACILITY) && defined(CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+#define TASK_PROFILER_SUPPORTED    1
+#else
+#define TASK_PROFILER_SUPPORTED    0
+#endif
+
+#ifndef configRUN_TIME_COUNTER_TYPE
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
+// Run-time counter of one task at the previous sample
+typedef struct {
+    UBaseType_t task_number;
+    configRUN_TIME_COUNTER_TYPE run_time;
+} task_counter_t;
+
+// Module state management
+typedef struct {
+    bool running;
+    bool primed;                         // A previous sample exists
+    esp_timer_handle_t timer;
+    int64_t last_sample_us;
+    configRUN_TIME_COUNTER_TYPE last_total;
+    task_counter_t last[TASK_PROFILER_MAX_TASKS];
+    UBaseType_t last_count;
+    uint32_t windows;
+    uint32_t skipped_samples;
+    bool profile_valid;
+    task_profile_t profile;              // Last completed window (under s_lock)
+} task_profiler_context_t;
+
+// Global module context
+static task_profiler_context_t s_context;
+
+// The profile is written by the timer task and read by the main task
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if TASK_PROFILER_SUPPORTED
+// Sample scratch (kept off the esp_timer task stack)
+static TaskStatus_t s_status[TASK_PROFILER_MAX_TASKS];
+static task_profile_t s_window;
+
+/*
+ * Internal function to find a task's counter in the previous sample
+ */
+static bool find_last_run_time(UBaseType_t task_number, configRUN_TIME_COUNTER_TYPE *run_time)
+{
+    for (UBaseType_t i = 0; i < s_context.last_count; i++) {
+        if (s_context.last[i].task_number == task_number) {
+            *run_time = s_context.last[i].run_time;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/*
+ * Internal function to fill one profile entry
+ */
+static void fill_entry(task_profile_entry_t *entry, const TaskStatus_t *status, uint64_t capacity)
+{
+    configRUN_TIME_COUNTER_TYPE last = 0;
+    find_last_run_time(status->xTaskNumber, &last);  // New tasks ran only within the window
+    uint64_t delta = (configRUN_TIME_COUNTER_TYPE)(status->ulRunTimeCounter - last);
+    uint64_t permille = (delta * 1000 + capacity / 2) / capacity;
+    
+    strncpy(entry->name, status->pcTaskName, TASK_PROFILER_NAME_LEN - 1);
+    entry->name[TASK_PROFILER_NAME_LEN - 1] = '\0';
+    entry->priority = (uint8_t)status->uxCurrentPriority;
+    entry->idle = status->uxCurrentPriority == tskIDLE_PRIORITY &&
+                  strncmp(status->pcTaskName, "IDLE", 4) == 0;
+    entry->cpu_permille = (uint16_t)((permille > 1000) ? 1000 : permille);
+    entry->stack_free_min = (uint32_t)status->usStackHighWaterMark;
+}
+
+/*
+ * Internal function to close the window ending at this sample
+ */
+static void build_profile(UBaseType_t count, configRUN_TIME_COUNTER_TYPE total, int64_t now_us)
+{
+    // Run-time counters advance on every core
+    uint64_t capacity = (uint64_t)(configRUN_TIME_COUNTER_TYPE)(total - s_context.last_total) *
+                        portNUM_PROCESSORS;
+    if (capacity == 0) {
+        return;
+    }
+    
+    memset(&s_window, 0, sizeof(s_window));
+    uint32_t idle_permille = 0;
+    
+    for (UBaseType_t i = 0; i < count; i++) {
+        task_profile_entry_t entry;
+        fill_entry(&entry, &s_status[i], capacity);
+        if (entry.idle) {
+            idle_permille += entry.cpu_permille;
+        }
+        
+        // Insert sorted by CPU share, busiest first
+        int pos = s_window.task_count;
+        while (pos > 0 && s_window.tasks[pos - 1].cpu_permille < entry.cpu_permille) {
+            s_window.tasks[pos] = s_window.tasks[pos - 1];
+            pos--;
+        }
+        s_window.tasks[pos] = entry;
+        s_window.task_count++;
+    }
+    
+    s_window.window_ms = (uint32_t)((now_us - s_context.last_sample_us) / 1000);
+    s_window.cpu_load_permille = (uint16_t)((idle_permille < 1000) ? 1000 - idle_permille : 0);
+    s_window.windows = ++s_context.windows;
+    s_window.skipped_samples = s_context.skipped_samples;
+    
+    portENTER_CRITICAL(&s_lock);
+    s_context.profile = s_window;
+    s_context.profile_valid = true;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/*
+ * Internal function to take one sample
+ */
+static void take_sample(void)
+{
+    configRUN_TIME_COUNTER_TYPE total = 0;
+    UBaseType_t count = uxTaskGetSystemState(s_status, TASK_PROFILER_MAX_TASKS, &total);
+    int64_t now_us = esp_timer_get_time();
+    
+    if (count == 0) {
+        // More tasks than slots; the next sample closes a longer window
+        if (s_context.skipped_samples++ == 0) {
+            ESP_LOGW(TAG, "More than %d tasks, raise TASK_PROFILER_MAX_TASKS",
+                     TASK_PROFILER_MAX_TASKS);
+        }
+        return;
+    }
+    
+    if (s_context.primed) {
+        build_profile(count, total, now_us);
+    }
+    
+    for (UBaseType_t i = 0; i < count; i++) {
+        s_context.last[i].task_number = s_status[i].xTaskNumber;
+        s_context.last[i].run_time = s_status[i].ulRunTimeCounter;
+    }
+    s_context.last_count = count;
+    s_context.last_total = total;
+    s_context.last_sample_us = now_us;
+    s_context.primed = true;
+}
+
+/*
+ * Sample timer callback (esp_timer task context)
+ */
+static void sample_timer_cb(void *arg)
+{
+    take_sample();
+}
+#endif // TASK_PROFILER_SUPPORTED
+
+/*
+ * Start Task Profiler
+ */
+esp_err_t task_profiler_start(uint32_t interval_ms)
+{
+#if !TASK_PROFILER_SUPPORTED
+    ESP_LOGW(TAG, "Enable FREERTOS_USE_TRACE_FACILITY and FREERTOS_GENERATE_RUN_TIME_STATS");
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (interval_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (s_context.running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (s_context.timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = &sample_timer_cb,
+            .arg = NULL,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "task_profiler",
+            .skip_unhandled_events = true
+        };
+        esp_err_t ret = esp_timer_create(&timer_args, &s_context.timer);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to create sample timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    
+    s_context.primed = false;
+    take_sample();
+    
+    esp_err_t ret = esp_timer_start_periodic(s_context.timer, (uint64_t)interval_ms * 1000);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start sample timer: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    s_context.running = true;
+    ESP_LOGI(TAG, "Task profiler started (%lu ms window)", (unsigned long)interval_ms);
+    return ESP_OK;
+#endif
+}
+
+/*
+ * Stop Task Profiler
+ */
+void task_profiler_stop(void)
+{
+    if (!s_context.running) {
+        return;
+    }
+    
+    esp_timer_stop(s_context.timer);
+    s_context.running = false;
+}
+
+/*
+ * Get Task Profile
+ */
+esp_err_t task_profiler_get_profile(task_profile_t *profile)
+{
+    if (!profile) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    esp_err_t ret = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_lock);
+    if (s_context.profile_valid) {
+        *profile = s_context.profile;
+        ret = ESP_OK;
+    }
+    portEXIT_CRITICAL(&s_lock);
+    
+    return ret;
+}
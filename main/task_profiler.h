@@ -0,0 +1,115 @@
+/*
+ * Task Profiler Module
+ * 
+ * Periodically samples the FreeRTOS run-time counters and stack high-water
+ * marks of every task. Each sample is compared with the previous one, so
+ * the profile describes the CPU share of every task over the last window
+ * rather than since boot, which is what shows whether a new feature (or
+ * an upload) fits the CPU budget. Stack high-water marks are the lowest
+ * free stack a task ever had and tell how far TASK_STACK_SIZE and the
+ * other stack sizes can be reduced.
+ * 
+ * Requires CONFIG_FREERTOS_USE_TRACE_FACILITY and
+ * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS (set in sdkconfig.defaults).
+ * Without them task_profiler_start() returns ESP_ERR_NOT_SUPPORTED.
+ * 
+ * Features:
+ * - Per-task CPU share over a sliding window (per mille of all cores)
+ * - Total CPU load (everything except the idle tasks)
+ * - Minimum free stack per task since it was created
+ * - Sampling on an esp_timer, no task of its own
+ * 
+ * Usage:
+ *   task_profiler_start(10000);
+ *   ...
+ *   task_profile_t profile;
+ *   if (task_profiler_get_profile(&profile) == ESP_OK) {
+ *       for (int i = 0; i < profile.task_count; i++) {
+ *           // profile.tasks[i].cpu_permille, profile.tasks[i].stack_free_min
+ *       }
+ *   }
+ */
+
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tasks tracked per sample (with more tasks, samples are skipped)
+#define TASK_PROFILER_MAX_TASKS    24
+
+// Task name length including terminator (configMAX_TASK_NAME_LEN default)
+#define TASK_PROFILER_NAME_LEN     16
+
+/*
+ * Profile of One Task
+ */
+typedef struct {
+    char name[TASK_PROFILER_NAME_LEN];   // Task name
+    uint8_t priority;                    // Current priority
+    bool idle;                           // One of the idle tasks
+    uint16_t cpu_permille;               // Share of all cores' time in the window
+    uint32_t stack_free_min;             // Lowest free stack since creation (bytes)
+} task_profile_entry_t;
+
+/*
+ * Task Profile of the Last Window
+ */
+typedef struct {
+    uint32_t window_ms;                  // Length of the window
+    uint16_t cpu_load_permille;          // Time not spent in idle tasks
+    uint8_t task_count;                  // Valid entries in tasks[]
+    uint32_t windows;                    // Windows completed since start
+    uint32_t skipped_samples;            // Samples lost to more than TASK_PROFILER_MAX_TASKS tasks
+    task_profile_entry_t tasks[TASK_PROFILER_MAX_TASKS];
+} task_profile_t;
+
+/*
+ * Start Task Profiler
+ * 
+ * Takes the first sample immediately; the first profile is available one
+ * interval later.
+ * 
+ * Parameters:
+ *   interval_ms: Window length in milliseconds
+ * 
+ * Returns:
+ *   ESP_OK: Profiler running
+ *   ESP_ERR_INVALID_ARG: Zero interval
+ *   ESP_ERR_INVALID_STATE: Already running
+ *   ESP_ERR_NOT_SUPPORTED: FreeRTOS run-time statistics not enabled
+ *   Other: Timer creation failed
+ */
+esp_err_t task_profiler_start(uint32_t interval_ms);
+
+/*
+ * Stop Task Profiler
+ * 
+ * The last profile stays available.
+ */
+void task_profiler_stop(void);
+
+/*
+ * Get Task Profile
+ * 
+ * Parameters:
+ *   profile: Pointer to task_profile_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Profile of the last completed window copied
+ *   ESP_ERR_INVALID_ARG: Invalid profile pointer
+ *   ESP_ERR_NOT_FOUND: No window completed yet
+ */
+esp_err_t task_profiler_get_profile(task_profile_t *profile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_PROFILER_H
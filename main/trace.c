@@ -0,0 +1,275 @@
+/*
+ * Trace Implementation
+ * 
+ * Positions count events since boot; the slot of a position is its low
+ * bits. A producer claims a position with a relaxed increment of head,
+ * clears the slot's tag, writes the record and publishes the tag derived
+ * from the position. A reader accepts a slot only if the tag matches the
+ * position before and after copying it (a seqlock per record), so slots
+ * that are being written or were overwritten are reported as
+ * TRACE_EV_NONE records instead of garbage. There is a single reader, the
+ * task that dumps or uploads the trace.
+ */
+
+#include "trace.h"
+#include "config.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+// Slot index of a position
+#define TRACE_MASK                 (TRACE_BUFFER_EVENTS - 1)
+
+// Lines of the console dump start with this prefix
+#define TRACE_DUMP_PREFIX          "TRC:"
+
+#if CONFIG_IDF_TARGET_LINUX
+#define trace_core_id()            0
+#else
+#define trace_core_id()            xPortGetCoreID()
+#endif
+
+// Module state management
+typedef struct {
+    _Atomic uint32_t head;               // Next position to write
+    _Atomic uint32_t read;               // First unread position
+    _Atomic bool enabled;                // Recording active
+    uint32_t lost;                       // Events lost before they were read
+    uint32_t snapshot_end;               // End position of the last snapshot
+    uint32_t snapshot_lost;              // Events the last snapshot found lost
+} trace_context_t;
+
+// Global module context
+static trace_context_t s_context = {
+    .enabled = true,
+};
+
+// Event ring (one slot when tracing is compiled out)
+static trace_record_t s_ring[TRACE_BUFFER_EVENTS];
+
+/*
+ * Internal function to derive the write tag of a position (never 0)
+ */
+static inline uint16_t record_tag(uint32_t pos)
+{
+    return (uint16_t)((pos & 0x7FFF) | 0x8000);
+}
+
+/*
+ * Record Trace Event
+ */
+void trace_record(trace_event_id_t id, trace_phase_t phase, uint32_t arg0, uint32_t arg1)
+{
+    if (!TRACE_ENABLED || !atomic_load_explicit(&s_context.enabled, memory_order_relaxed)) {
+        return;
+    }
+    
+    uint32_t timestamp_us = (uint32_t)esp_timer_get_time();
+    uint32_t pos = atomic_fetch_add_explicit(&s_context.head, 1, memory_order_relaxed);
+    trace_record_t *record = &s_ring[pos & TRACE_MASK];
+    
+    __atomic_store_n(&record->tag, 0, __ATOMIC_RELAXED);
+    atomic_thread_fence(memory_order_release);
+    record->timestamp_us = timestamp_us;
+    record->id = (uint8_t)id;
+    record->flags = (uint8_t)(phase | (trace_core_id() << 4));
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+    __atomic_store_n(&record->tag, record_tag(pos), __ATOMIC_RELEASE);
+}
+
+/*
+ * Pause or Resume Recording
+ */
+void trace_set_enabled(bool enabled)
+{
+    atomic_store_explicit(&s_context.enabled, enabled, memory_order_relaxed);
+}
+
+/*
+ * Internal function to copy the record at a position
+ * 
+ * Returns false (and a TRACE_EV_NONE record) if the slot does not hold
+ * that position's completed record.
+ */
+static bool read_record(uint32_t pos, trace_record_t *out)
+{
+    const trace_record_t *record = &s_ring[pos & TRACE_MASK];
+    uint16_t tag = record_tag(pos);
+    
+    if (__atomic_load_n(&record->tag, __ATOMIC_ACQUIRE) == tag) {
+        memcpy(out, record, sizeof(*out));
+        atomic_thread_fence(memory_order_acquire);
+        if (__atomic_load_n(&record->tag, __ATOMIC_RELAXED) == tag) {
+            return true;
+        }
+    }
+    
+    memset(out, 0, sizeof(*out));
+    return false;
+}
+
+/*
+ * Internal function to find the unread range
+ * 
+ * Returns the first position still in the ring; positions before it were
+ * overwritten unread.
+ */
+static uint32_t unread_range(uint32_t *read, uint32_t *head)
+{
+    *head = atomic_load_explicit(&s_context.head, memory_order_acquire);
+    *read = atomic_load_explicit(&s_context.read, memory_order_relaxed);
+    return (*head - *read > TRACE_BUFFER_EVENTS) ? *head - TRACE_BUFFER_EVENTS : *read;
+}
+
+/*
+ * Get Snapshot Size
+ */
+size_t trace_snapshot_size(void)
+{
+    if (!TRACE_ENABLED) {
+        return 0;
+    }
+    
+    uint32_t read, head;
+    uint32_t start = unread_range(&read, &head);
+    return sizeof(trace_header_t) + (size_t)(head - start) * sizeof(trace_record_t);
+}
+
+/*
+ * Snapshot Unread Events
+ */
+size_t trace_snapshot(void *out, size_t max_len, uint32_t *end_pos)
+{
+    if (!TRACE_ENABLED || !out || !end_pos || max_len < sizeof(trace_header_t)) {
+        return 0;
+    }
+    
+    uint32_t read, head;
+    uint32_t start = unread_range(&read, &head);
+    size_t room = (max_len - sizeof(trace_header_t)) / sizeof(trace_record_t);
+    uint32_t end = (head - start > room) ? start + (uint32_t)room : head;
+    
+    uint8_t *dst = (uint8_t *)out + sizeof(trace_header_t);
+    uint32_t lost = start - read;
+    for (uint32_t pos = start; pos != end; pos++) {
+        trace_record_t record;
+        if (!read_record(pos, &record)) {
+            lost++;
+        }
+        memcpy(dst, &record, sizeof(record));
+        dst += sizeof(record);
+    }
+    
+    const trace_header_t header = {
+        .magic = TRACE_MAGIC,
+        .version = TRACE_FORMAT_VERSION,
+        .record_size = sizeof(trace_record_t),
+        .count = end - start,
+        .lost = start - read,
+        .timestamp_us = esp_timer_get_time(),
+    };
+    memcpy(out, &header, sizeof(header));
+    
+    s_context.snapshot_end = end;
+    s_context.snapshot_lost = lost;
+    *end_pos = end;
+    return (size_t)(dst - (uint8_t *)out);
+}
+
+/*
+ * Mark Events as Read
+ */
+void trace_consume(uint32_t end_pos)
+{
+    if (!TRACE_ENABLED) {
+        return;
+    }
+    
+    if (end_pos == s_context.snapshot_end) {
+        s_context.lost += s_context.snapshot_lost;
+        s_context.snapshot_lost = 0;
+    }
+    atomic_store_explicit(&s_context.read, end_pos, memory_order_relaxed);
+}
+
+/*
+ * Internal function to print bytes as one dump line
+ */
+static void dump_line(const void *data, size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+    const uint8_t *bytes = data;
+    char line[sizeof(TRACE_DUMP_PREFIX) + 2 * sizeof(trace_header_t)];
+    size_t pos = 0;
+    
+    memcpy(line, TRACE_DUMP_PREFIX, sizeof(TRACE_DUMP_PREFIX) - 1);
+    pos += sizeof(TRACE_DUMP_PREFIX) - 1;
+    for (size_t i = 0; i < len; i++) {
+        line[pos++] = hex[bytes[i] >> 4];
+        line[pos++] = hex[bytes[i] & 0x0F];
+    }
+    line[pos] = '\0';
+    puts(line);
+}
+
+/*
+ * Dump Unread Events to the Console
+ */
+void trace_dump(void)
+{
+    if (!TRACE_ENABLED) {
+        return;
+    }
+    
+    // Printed record by record so the dump needs no snapshot buffer
+    uint32_t read, head;
+    uint32_t start = unread_range(&read, &head);
+    const trace_header_t header = {
+        .magic = TRACE_MAGIC,
+        .version = TRACE_FORMAT_VERSION,
+        .record_size = sizeof(trace_record_t),
+        .count = head - start,
+        .lost = start - read,
+        .timestamp_us = esp_timer_get_time(),
+    };
+    dump_line(&header, sizeof(header));
+    
+    uint32_t lost = start - read;
+    for (uint32_t pos = start; pos != head; pos++) {
+        trace_record_t record;
+        if (!read_record(pos, &record)) {
+            lost++;
+        }
+        dump_line(&record, sizeof(record));
+    }
+    fflush(stdout);
+    
+    s_context.lost += lost;
+    atomic_store_explicit(&s_context.read, head, memory_order_relaxed);
+}
+
+/*
+ * Get Trace Statistics
+ */
+void trace_get_stats(trace_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    
+    memset(stats, 0, sizeof(*stats));
+    if (!TRACE_ENABLED) {
+        return;
+    }
+    
+    uint32_t read, head;
+    uint32_t start = unread_range(&read, &head);
+    stats->capacity = TRACE_BUFFER_EVENTS;
+    stats->recorded = head;
+    stats->unread = head - start;
+    stats->lost = s_context.lost + (start - read);
+}
@@ -0,0 +1,202 @@
+/*
+ * Trace Module
+ * 
+ * Low-overhead binary event trace for hot paths. Each event is a fixed
+ * 16-byte record (timestamp, event id, phase, core and two arguments)
+ * written into a static ring without locks and without formatting, so
+ * tracing the sampler, the JSON encoder, the HTTP event handler and the
+ * WiFi event handler does not perturb the timings being measured the way
+ * ESP_LOGD does.
+ * 
+ * Producers on any task or core claim a slot with one atomic increment.
+ * Every record carries a tag that the producer clears before and sets
+ * after writing it, so readers skip records that are being overwritten.
+ * When the ring wraps, the oldest unread events are lost and counted.
+ * 
+ * Unread events are exported as a snapshot: a trace_header_t followed by
+ * the records, oldest first. Records that were overwritten while being
+ * copied are exported with id TRACE_EV_NONE. trace_dump() prints the snapshot as hex
+ * lines prefixed with "TRC:" on the console; http_client_post_trace()
+ * uploads it. tools/trace_decode.py turns either form into Chrome trace
+ * JSON (chrome://tracing, Perfetto).
+ * 
+ * Recording is compiled in with TCP_CLIENT_TRACE; otherwise
+ * trace_record() returns immediately and the ring shrinks to one slot.
+ * 
+ * Features:
+ * - Lock-free multi-producer recording, usable from ISRs
+ * - Microsecond timestamps, begin/end spans and instant events
+ * - Lost-event accounting when the ring wraps before it is read
+ * - Serial dump and upload of the same binary format
+ * 
+ * Usage:
+ *   TRACE_BEGIN(TRACE_EV_ENCODE, sample_count, 0);
+ *   ...
+ *   TRACE_END(TRACE_EV_ENCODE, json != NULL, 0);
+ *   TRACE_INSTANT(TRACE_EV_HTTP_ON_DATA, evt->data_len, 0);
+ * 
+ *   trace_dump();       // $ tools/trace_decode.py console.log -o trace.json
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_MAGIC                0x31435254u  // "TRC1"
+#define TRACE_FORMAT_VERSION       1
+
+/*
+ * Trace Event IDs
+ * 
+ * Keep in sync with EVENTS in tools/trace_decode.py.
+ */
+typedef enum {
+    TRACE_EV_NONE = 0,
+    TRACE_EV_SAMPLE,                     // Span: sampler reads all drivers (end: valid mask)
+    TRACE_EV_ENCODE,                     // Span: JSON encoding (begin: samples, end: 1 if encoded)
+    TRACE_EV_HTTP_POST,                  // Span: HTTP request (begin: bytes, end: status, esp_err)
+    TRACE_EV_HTTP_CONNECTED,             // Instant: connection established
+    TRACE_EV_HTTP_HEADER_SENT,           // Instant: request headers sent
+    TRACE_EV_HTTP_ON_HEADER,             // Instant: response header (length)
+    TRACE_EV_HTTP_ON_DATA,               // Instant: response data chunk (length)
+    TRACE_EV_HTTP_FINISH,                // Instant: response complete
+    TRACE_EV_HTTP_DISCONNECTED,          // Instant: connection closed
+    TRACE_EV_HTTP_ERROR,                 // Instant: transport error
+    TRACE_EV_WIFI_EVENT,                 // Instant: WIFI_EVENT (event id, reason)
+    TRACE_EV_IP_EVENT,                   // Instant: IP_EVENT (event id)
+    TRACE_EV_MAX
+} trace_event_id_t;
+
+/*
+ * Event Phases
+ */
+typedef enum {
+    TRACE_PHASE_INSTANT = 0,
+    TRACE_PHASE_BEGIN,
+    TRACE_PHASE_END
+} trace_phase_t;
+
+/*
+ * Trace Record (16 bytes, little endian)
+ */
+typedef struct {
+    uint32_t timestamp_us;               // Low 32 bits of esp_timer_get_time()
+    uint8_t id;                          // trace_event_id_t
+    uint8_t flags;                       // Bits 0-1: trace_phase_t, bits 4-7: core
+    uint16_t tag;                        // Write tag (0 while being written)
+    uint32_t arg0;
+    uint32_t arg1;
+} trace_record_t;
+
+/*
+ * Snapshot Header (24 bytes, followed by 'count' records)
+ */
+typedef struct {
+    uint32_t magic;                      // TRACE_MAGIC
+    uint16_t version;                    // TRACE_FORMAT_VERSION
+    uint16_t record_size;                // sizeof(trace_record_t)
+    uint32_t count;                      // Records following the header
+    uint32_t lost;                       // Events overwritten before this snapshot read them
+    int64_t timestamp_us;                // esp_timer_get_time() when the snapshot was taken
+} trace_header_t;
+
+/*
+ * Trace Statistics
+ */
+typedef struct {
+    uint32_t capacity;                   // Ring size in events (0 when compiled out)
+    uint32_t recorded;                   // Events recorded since boot
+    uint32_t unread;                     // Events not yet exported
+    uint32_t lost;                       // Events overwritten before they were exported
+} trace_stats_t;
+
+// Recording shorthands
+#define TRACE_BEGIN(id, arg0, arg1)    trace_record((id), TRACE_PHASE_BEGIN, (arg0), (arg1))
+#define TRACE_END(id, arg0, arg1)      trace_record((id), TRACE_PHASE_END, (arg0), (arg1))
+#define TRACE_INSTANT(id, arg0, arg1)  trace_record((id), TRACE_PHASE_INSTANT, (arg0), (arg1))
+
+/*
+ * Record Trace Event
+ * 
+ * Safe from any task, core or ISR. Does nothing while recording is
+ * paused or when tracing is compiled out.
+ * 
+ * Parameters:
+ *   id: Event id
+ *   phase: Begin, end or instant
+ *   arg0, arg1: Event arguments
+ */
+void trace_record(trace_event_id_t id, trace_phase_t phase, uint32_t arg0, uint32_t arg1);
+
+/*
+ * Pause or Resume Recording
+ * 
+ * Recording starts enabled at boot.
+ * 
+ * Parameters:
+ *   enabled: true to record events
+ */
+void trace_set_enabled(bool enabled);
+
+/*
+ * Get Snapshot Size
+ * 
+ * Returns:
+ *   Bytes needed to snapshot all unread events (header included), or 0
+ *   when tracing is compiled out
+ */
+size_t trace_snapshot_size(void);
+
+/*
+ * Snapshot Unread Events
+ * 
+ * Copies a header and the unread events, oldest first. The events stay
+ * unread until trace_consume() is called with the returned position, so
+ * a failed upload can be retried.
+ * 
+ * Parameters:
+ *   out: Destination buffer
+ *   max_len: Size of out (events that do not fit are left unread)
+ *   end_pos: Receives the position to pass to trace_consume()
+ * 
+ * Returns:
+ *   Bytes written, 0 if out is too small for the header
+ */
+size_t trace_snapshot(void *out, size_t max_len, uint32_t *end_pos);
+
+/*
+ * Mark Events as Read
+ * 
+ * Parameters:
+ *   end_pos: Position returned by trace_snapshot()
+ */
+void trace_consume(uint32_t end_pos);
+
+/*
+ * Dump Unread Events to the Console
+ * 
+ * Prints the snapshot as "TRC:<hex>" lines and marks the events read.
+ * Decode the captured console output with tools/trace_decode.py.
+ */
+void trace_dump(void);
+
+/*
+ * Get Trace Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to trace_stats_t structure to populate
+ */
+void trace_get_stats(trace_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_H
@@ -2,10 +2,13 @@
  * WiFi Manager Implementation
  * 
  * Implements WiFi connectivity management with clean abstraction,
- * proper error handling, and event-driven architecture.
+ * proper error handling, and event-driven architecture. Link telemetry,
+ * radio accounting and background reconnection are shared with the
+ * linux-target fake (wifi_manager_common.c).
  */
 
 #include "wifi_manager.h"
+#include "wifi_manager_common.h"
 #include "config.h"
 
 #include <string.h>
@@ -16,6 +19,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "trace.h"
 
 // Module logging tag
 static const char *TAG = "WIFI_MGR";
@@ -29,6 +34,9 @@ typedef struct {
     esp_netif_t *netif_instance;
     esp_event_handler_instance_t wifi_handler_instance;
     esp_event_handler_instance_t ip_handler_instance;
+    bool wifi_started;
+    wifi_power_policy_t power_policy;
+    esp_timer_handle_t link_timer;
 } wifi_manager_context_t;
 
 // Global module context
@@ -39,9 +47,81 @@ static wifi_manager_context_t s_context = {
     .event_group = NULL,
     .netif_instance = NULL,
     .wifi_handler_instance = NULL,
-    .ip_handler_instance = NULL
+    .ip_handler_instance = NULL,
+    .wifi_started = false,
+    .power_policy = {
+        .mode = WIFI_POWER_SAVE_DEFAULT,
+        .listen_interval = WIFI_LISTEN_INTERVAL
+    },
+    .link_timer = NULL
 };
 
+/*
+ * Map power save level to the ESP-IDF modem-sleep type
+ */
+static wifi_ps_type_t power_save_to_ps_type(wifi_power_save_t mode)
+{
+    switch (mode) {
+        case WIFI_POWER_SAVE_NONE:
+            return WIFI_PS_NONE;
+        case WIFI_POWER_SAVE_MAX:
+            return WIFI_PS_MAX_MODEM;
+        case WIFI_POWER_SAVE_MIN:
+        default:
+            return WIFI_PS_MIN_MODEM;
+    }
+}
+
+/*
+ * Nominal PHY Rate of a PHY Mode (Mbps)
+ */
+uint16_t wifi_manager_phy_rate_mbps(uint8_t phy_mode)
+{
+    switch (phy_mode) {
+        case WIFI_PHY_MODE_LR:
+            return 1;
+        case WIFI_PHY_MODE_11B:
+            return 11;
+        case WIFI_PHY_MODE_11G:
+            return 54;
+        case WIFI_PHY_MODE_HT20:
+            return 72;
+        case WIFI_PHY_MODE_HT40:
+            return 150;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Periodic Link Quality Sampler
+ * 
+ * Runs from the esp_timer task every WIFI_LINK_SAMPLE_INTERVAL_MS.
+ */
+static void link_sample_timer_cb(void *arg)
+{
+    if (s_context.status != WIFI_STATUS_CONNECTED) {
+        return;
+    }
+    
+    wifi_ap_record_t ap_info;
+    if (esp_wifi_sta_get_ap_info(&ap_info) != ESP_OK) {
+        return;
+    }
+    
+    wifi_phy_mode_t phy_mode = WIFI_PHY_MODE_11G;
+    esp_wifi_sta_get_negotiated_phymode(&phy_mode);
+    
+    wifi_link_sample_t sample = {
+        .rssi = ap_info.rssi,
+        .channel = ap_info.primary,
+        .phy_mode = (uint8_t)phy_mode,
+        .reserved = 0
+    };
+    
+    wifi_common_record_sample(&sample);
+}
+
 /*
  * Internal WiFi Event Handler
  * 
@@ -52,6 +132,9 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                               int32_t event_id, void* event_data)
 {
     if (event_base == WIFI_EVENT) {
+        TRACE_INSTANT(TRACE_EV_WIFI_EVENT, event_id,
+                      (event_id == WIFI_EVENT_STA_DISCONNECTED) ?
+                      ((wifi_event_sta_disconnected_t *)event_data)->reason : 0);
         switch (event_id) {
             case WIFI_EVENT_STA_START:
                 ESP_LOGI(TAG, "WiFi station started, initiating connection...");
@@ -60,9 +143,17 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                 break;
                 
             case WIFI_EVENT_STA_DISCONNECTED:
+                xEventGroupClearBits(s_context.event_group, WIFI_CONNECTED_BIT);
+                {
+                    wifi_event_sta_disconnected_t *event = (wifi_event_sta_disconnected_t *) event_data;
+                    ESP_LOGD(TAG, "Disconnected, reason: %d", event->reason);
+                    wifi_common_record_disconnect(event->reason);
+                }
+                
                 if (s_context.retry_count < WIFI_MAXIMUM_RETRY) {
                     esp_wifi_connect();
                     s_context.retry_count++;
+                    wifi_common_record_retry();
                     ESP_LOGI(TAG, "Retrying WiFi connection (%d/%d)", 
                             s_context.retry_count, WIFI_MAXIMUM_RETRY);
                     s_context.status = WIFI_STATUS_CONNECTING;
@@ -71,14 +162,16 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                             WIFI_MAXIMUM_RETRY);
                     s_context.status = WIFI_STATUS_FAILED;
                     xEventGroupSetBits(s_context.event_group, WIFI_FAIL_BIT);
+                    wifi_common_schedule_backoff();
                 }
                 break;
                 
             default:
-                ESP_LOGD(TAG, "Unhandled WiFi event: %ld", event_id);
+                ESP_LOGD(TAG, "Unhandled WiFi event: %ld", (long)event_id);
                 break;
         }
     } else if (event_base == IP_EVENT) {
+        TRACE_INSTANT(TRACE_EV_IP_EVENT, event_id, 0);
         switch (event_id) {
             case IP_EVENT_STA_GOT_IP:
                 {
@@ -86,13 +179,14 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
                     ESP_LOGI(TAG, "Connected to WiFi! IP: " IPSTR, 
                             IP2STR(&event->ip_info.ip));
                     s_context.retry_count = 0;  // Reset retry counter on success
+                    wifi_common_connected();
                     s_context.status = WIFI_STATUS_CONNECTED;
                     xEventGroupSetBits(s_context.event_group, WIFI_CONNECTED_BIT);
                 }
                 break;
                 
             default:
-                ESP_LOGD(TAG, "Unhandled IP event: %ld", event_id);
+                ESP_LOGD(TAG, "Unhandled IP event: %ld", (long)event_id);
                 break;
         }
     }
@@ -168,6 +262,26 @@ esp_err_t wifi_manager_init(void)
         goto error_cleanup;
     }
     
+    // Start periodic link quality sampling
+    const esp_timer_create_args_t link_timer_args = {
+        .callback = &link_sample_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "wifi_link",
+        .skip_unhandled_events = true
+    };
+    ret = esp_timer_create(&link_timer_args, &s_context.link_timer);
+    if (ret == ESP_OK) {
+        ret = esp_timer_start_periodic(s_context.link_timer,
+                                       (uint64_t)WIFI_LINK_SAMPLE_INTERVAL_MS * 1000);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Link quality sampling unavailable: %s", esp_err_to_name(ret));
+    }
+    
+    // Link telemetry, radio accounting and background reconnection
+    wifi_common_init();
+    
     s_context.initialized = true;
     s_context.status = WIFI_STATUS_DISCONNECTED;
     s_context.retry_count = 0;
@@ -184,22 +298,36 @@ error_cleanup:
 }
 
 /*
- * Connect to WiFi Network
+ * Start WiFi Connection Without Waiting
  */
-esp_err_t wifi_manager_connect(void)
+esp_err_t wifi_manager_connect_async(void)
 {
     if (!s_context.initialized) {
         ESP_LOGE(TAG, "WiFi manager not initialized");
         return ESP_ERR_INVALID_STATE;
     }
     
-    if (s_context.status == WIFI_STATUS_CONNECTED) {
-        ESP_LOGI(TAG, "Already connected to WiFi");
+    if (s_context.status == WIFI_STATUS_CONNECTED || s_context.status == WIFI_STATUS_CONNECTING) {
         return ESP_OK;
     }
     
     ESP_LOGI(TAG, "Connecting to WiFi SSID: %s", WIFI_SSID);
     
+    // Reset connection state
+    s_context.retry_count = 0;
+    s_context.status = WIFI_STATUS_CONNECTING;
+    xEventGroupClearBits(s_context.event_group, WIFI_CONNECTED_BIT | WIFI_FAIL_BIT);
+    
+    // WiFi already running from a previous attempt: just re-associate
+    if (s_context.wifi_started) {
+        esp_err_t ret = esp_wifi_connect();
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Failed to start WiFi connection: %s", esp_err_to_name(ret));
+            s_context.status = WIFI_STATUS_ERROR;
+        }
+        return ret;
+    }
+    
     // Configure WiFi connection parameters
     wifi_config_t wifi_config = {
         .sta = {
@@ -210,13 +338,10 @@ esp_err_t wifi_manager_connect(void)
                 .capable = true,
                 .required = false
             },
+            .listen_interval = s_context.power_policy.listen_interval,
         },
     };
     
-    // Reset connection state
-    s_context.retry_count = 0;
-    s_context.status = WIFI_STATUS_CONNECTING;
-    
     // Configure and start WiFi
     esp_err_t ret = esp_wifi_set_mode(WIFI_MODE_STA);
     if (ret != ESP_OK) {
@@ -238,13 +363,31 @@ esp_err_t wifi_manager_connect(void)
         s_context.status = WIFI_STATUS_ERROR;
         return ret;
     }
+    s_context.wifi_started = true;
+    
+    // Apply modem-sleep level (non-fatal: the default level stays in effect)
+    ret = esp_wifi_set_ps(power_save_to_ps_type(s_context.power_policy.mode));
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to set power save mode: %s", esp_err_to_name(ret));
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Wait for WiFi Connection Result
+ */
+esp_err_t wifi_manager_wait_connected(uint32_t timeout_ms)
+{
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    // Wait for connection result
     EventBits_t bits = xEventGroupWaitBits(s_context.event_group,
                                           WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
                                           pdFALSE,
                                           pdFALSE,
-                                          pdMS_TO_TICKS(WIFI_CONNECT_TIMEOUT_MS));
+                                          pdMS_TO_TICKS(timeout_ms));
     
     if (bits & WIFI_CONNECTED_BIT) {
         ESP_LOGI(TAG, "Successfully connected to WiFi");
@@ -255,10 +398,30 @@ esp_err_t wifi_manager_connect(void)
     } else {
         ESP_LOGE(TAG, "WiFi connection timeout");
         s_context.status = WIFI_STATUS_FAILED;
+        wifi_common_schedule_backoff();
         return ESP_ERR_TIMEOUT;
     }
 }
 
+/*
+ * Connect to WiFi Network
+ */
+esp_err_t wifi_manager_connect(void)
+{
+    if (s_context.initialized && s_context.status == WIFI_STATUS_CONNECTED) {
+        ESP_LOGI(TAG, "Already connected to WiFi");
+        return ESP_OK;
+    }
+    
+    // Starts a new attempt, or joins one already in progress
+    esp_err_t ret = wifi_manager_connect_async();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return wifi_manager_wait_connected(WIFI_CONNECT_TIMEOUT_MS);
+}
+
 /*
  * Check WiFi Connection Status
  */
@@ -352,8 +515,19 @@ esp_err_t wifi_manager_cleanup(void)
         wifi_manager_disconnect();
     }
     
+    // Stop background reconnection
+    wifi_common_deinit();
+    
+    // Stop link quality sampling
+    if (s_context.link_timer) {
+        esp_timer_stop(s_context.link_timer);
+        esp_timer_delete(s_context.link_timer);
+        s_context.link_timer = NULL;
+    }
+    
     // Stop WiFi
     esp_wifi_stop();
+    s_context.wifi_started = false;
     
     // Unregister event handlers
     if (s_context.wifi_handler_instance) {
@@ -374,8 +548,10 @@ esp_err_t wifi_manager_cleanup(void)
         s_context.event_group = NULL;
     }
     
-    // Reset context
+    // Reset context (the power policy survives re-initialization)
+    wifi_power_policy_t power_policy = s_context.power_policy;
     memset(&s_context, 0, sizeof(s_context));
+    s_context.power_policy = power_policy;
     
     ESP_LOGI(TAG, "WiFi manager cleanup completed");
     return ESP_OK;
@@ -387,4 +563,43 @@ esp_err_t wifi_manager_cleanup(void)
 int wifi_manager_get_retry_count(void)
 {
     return s_context.retry_count;
-} 
\ No newline at end of file
+}
+
+/*
+ * Set WiFi Power Policy
+ */
+esp_err_t wifi_manager_set_power_policy(const wifi_power_policy_t *policy)
+{
+    if (!policy || policy->mode > WIFI_POWER_SAVE_MAX || policy->listen_interval == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    bool listen_interval_changed = (policy->listen_interval != s_context.power_policy.listen_interval);
+    s_context.power_policy = *policy;
+    
+    ESP_LOGI(TAG, "Power policy: mode=%d, listen_interval=%u",
+             policy->mode, policy->listen_interval);
+    
+    if (!s_context.wifi_started) {
+        return ESP_OK;
+    }
+    
+    if (listen_interval_changed && s_context.status == WIFI_STATUS_CONNECTED) {
+        ESP_LOGI(TAG, "Listen interval takes effect on next association");
+    }
+    
+    return esp_wifi_set_ps(power_save_to_ps_type(policy->mode));
+}
+
+/*
+ * Get WiFi Power Policy
+ */
+esp_err_t wifi_manager_get_power_policy(wifi_power_policy_t *policy)
+{
+    if (!policy) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *policy = s_context.power_policy;
+    return ESP_OK;
+}
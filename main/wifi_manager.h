@@ -9,29 +9,44 @@
  * - Event-driven connection status monitoring
  * - ESP-IDF error handling patterns
  * - Extensible for multiple network configurations
+ * - Configurable modem-sleep power policy with radio-on time estimate
+ * - Periodic link quality sampling (RSSI, channel, PHY, disconnect reasons)
+ * - Background reconnection with exponential backoff
  * 
  * Usage:
  *   esp_err_t ret = wifi_manager_init();
  *   ESP_ERROR_CHECK(ret);
- *   
+ * 
  *   ret = wifi_manager_connect();
  *   if (ret == ESP_OK) {
  *       // WiFi connected successfully
  *   }
- *   
+ * 
  *   if (wifi_manager_is_connected()) {
  *       // Ready for network operations
  *   }
+ * 
+ * On the linux (host) target this API is implemented by
+ * wifi_manager_fake.c, which simulates link events on the host network.
  */
 
 #ifndef WIFI_MANAGER_H
 #define WIFI_MANAGER_H
 
+#include "sdkconfig.h"
 #include "esp_err.h"
-#include "esp_wifi.h"
 #include "esp_event.h"
+#include "esp_netif.h"
 #include "freertos/event_groups.h"
 
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_wifi.h"
+#else
+// No WiFi driver on the linux target; the fake manager returns the same codes
+#define ESP_ERR_WIFI_NOT_INIT       (ESP_ERR_WIFI_BASE + 1)
+#define ESP_ERR_WIFI_NOT_CONNECT    (ESP_ERR_WIFI_BASE + 15)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -47,6 +62,75 @@ typedef enum {
     WIFI_STATUS_ERROR                // Critical error occurred
 } wifi_status_t;
 
+/*
+ * WiFi Power Save Level
+ * 
+ * Modem-sleep level used by the station while associated.
+ */
+typedef enum {
+    WIFI_POWER_SAVE_NONE = 0,        // Radio always on (lowest latency, highest current)
+    WIFI_POWER_SAVE_MIN,             // Modem sleep, wake on every DTIM beacon
+    WIFI_POWER_SAVE_MAX              // Modem sleep, wake every listen interval
+} wifi_power_save_t;
+
+/*
+ * WiFi Power Policy
+ */
+typedef struct {
+    wifi_power_save_t mode;              // Modem-sleep level
+    uint16_t listen_interval;            // Beacons between wakes (used by WIFI_POWER_SAVE_MAX)
+} wifi_power_policy_t;
+
+/*
+ * Radio Activity Statistics
+ * 
+ * Radio-on time is estimated from measured transmit bursts plus the
+ * beacon wake-ups implied by the active power policy.
+ */
+typedef struct {
+    wifi_power_policy_t policy;          // Power policy currently in effect
+    uint32_t tx_bursts;                  // Number of transmit bursts (flushes)
+    uint64_t tx_active_us;               // Total time spent inside transmit bursts
+    uint64_t observed_us;                // Time covered by these statistics
+    uint64_t listen_us;                  // Estimated beacon-listen time outside bursts
+    uint32_t radio_on_ms_per_hour;       // Estimated radio-on time per hour
+} wifi_radio_stats_t;
+
+/*
+ * Link Quality Sample
+ * 
+ * One periodic observation of the association, kept in a compact ring.
+ */
+typedef struct {
+    int8_t rssi;                         // Signal strength in dBm
+    uint8_t channel;                     // Primary channel
+    uint8_t phy_mode;                    // Negotiated wifi_phy_mode_t
+    uint8_t reserved;
+} wifi_link_sample_t;
+
+/*
+ * Link Quality Summary
+ * 
+ * Aggregates link samples and connection events over one reporting window.
+ * The PHY rate is the nominal maximum rate of the negotiated PHY mode,
+ * since ESP-IDF does not expose the station's current TX rate.
+ */
+typedef struct {
+    uint32_t window_ms;                  // Length of the reporting window
+    uint16_t samples;                    // Link samples taken in the window
+    int8_t rssi_min;                     // Minimum RSSI (dBm)
+    int8_t rssi_max;                     // Maximum RSSI (dBm)
+    float rssi_mean;                     // Mean RSSI (dBm)
+    uint8_t channel;                     // Channel of the latest sample
+    uint8_t phy_mode;                    // PHY mode of the latest sample
+    uint16_t phy_rate_mbps;              // Nominal PHY rate of the latest sample
+    uint16_t disconnects;                // Disconnect events in the window
+    uint16_t retries;                    // Connection retries in the window
+    uint8_t last_disconnect_reason;      // Most recent wifi_err_reason_t (0 = none)
+    uint32_t total_disconnects;          // Disconnect events since boot
+    uint32_t total_retries;              // Connection retries since boot
+} wifi_link_summary_t;
+
 /*
  * WiFi Manager Initialization
  * 
@@ -66,7 +150,8 @@ esp_err_t wifi_manager_init(void);
  * 
  * Attempts to connect to the WiFi network configured in menuconfig.
  * This function blocks until connection succeeds, fails after max retries,
- * or encounters a critical error.
+ * or encounters a critical error. If an attempt was already started with
+ * wifi_manager_connect_async(), it waits for that attempt instead.
  * 
  * Connection process:
  * 1. Validates WiFi manager is initialized
@@ -83,6 +168,37 @@ esp_err_t wifi_manager_init(void);
  */
 esp_err_t wifi_manager_connect(void);
 
+/*
+ * Start WiFi Connection Without Waiting
+ * 
+ * Starts station mode and association, then returns immediately so other
+ * initialization can run while the link comes up. Does nothing if a
+ * connection is already established or in progress.
+ * 
+ * Returns:
+ *   ESP_OK: Connection attempt started (or already in progress)
+ *   ESP_ERR_INVALID_STATE: WiFi manager not initialized
+ *   ESP_ERR_*: Errors from WiFi configuration or start
+ */
+esp_err_t wifi_manager_connect_async(void);
+
+/*
+ * Wait for WiFi Connection Result
+ * 
+ * Blocks until the attempt started by wifi_manager_connect_async()
+ * succeeds, fails after maximum retries, or the timeout expires.
+ * 
+ * Parameters:
+ *   timeout_ms: Maximum time to wait in milliseconds
+ * 
+ * Returns:
+ *   ESP_OK: Connected with IP address
+ *   ESP_FAIL: Connection failed after maximum retries
+ *   ESP_ERR_TIMEOUT: No result within timeout
+ *   ESP_ERR_INVALID_STATE: WiFi manager not initialized
+ */
+esp_err_t wifi_manager_wait_connected(uint32_t timeout_ms);
+
 /*
  * Check WiFi Connection Status
  * 
@@ -176,6 +292,130 @@ esp_err_t wifi_manager_cleanup(void);
  */
 int wifi_manager_get_retry_count(void);
 
+/*
+ * Set WiFi Power Policy
+ * 
+ * Selects the modem-sleep level and listen interval. The sleep level is
+ * applied immediately when WiFi is running; the listen interval is sent
+ * to the AP at association time and takes effect on the next connection.
+ * 
+ * Parameters:
+ *   policy: Power policy to apply
+ * 
+ * Returns:
+ *   ESP_OK: Policy stored (and applied if WiFi is running)
+ *   ESP_ERR_INVALID_ARG: Invalid policy
+ *   ESP_ERR_*: Errors from esp_wifi_set_ps()
+ */
+esp_err_t wifi_manager_set_power_policy(const wifi_power_policy_t *policy);
+
+/*
+ * Get WiFi Power Policy
+ * 
+ * Parameters:
+ *   policy: Pointer to store the current power policy
+ * 
+ * Returns:
+ *   ESP_OK: Policy retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid parameter
+ */
+esp_err_t wifi_manager_get_power_policy(wifi_power_policy_t *policy);
+
+/*
+ * Mark Radio Transmit Burst
+ * 
+ * The sender brackets each flush with these calls so the manager can
+ * account for the time the radio is kept awake by application traffic.
+ */
+void wifi_manager_radio_burst_begin(void);
+void wifi_manager_radio_burst_end(void);
+
+/*
+ * Get Radio Activity Statistics
+ * 
+ * Parameters:
+ *   stats: Pointer to wifi_radio_stats_t structure to populate
+ * 
+ * Returns:
+ *   ESP_OK: Statistics retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid stats pointer
+ */
+esp_err_t wifi_manager_get_radio_stats(wifi_radio_stats_t *stats);
+
+/*
+ * Get Link Quality Summary
+ * 
+ * Returns min/mean/max RSSI and connection event counters for the current
+ * reporting window. Samples are taken every WIFI_LINK_SAMPLE_INTERVAL_MS
+ * while connected.
+ * 
+ * Parameters:
+ *   summary: Pointer to wifi_link_summary_t structure to populate
+ *   reset_window: true to start a new reporting window after reading
+ * 
+ * Returns:
+ *   ESP_OK: Summary retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid summary pointer
+ */
+esp_err_t wifi_manager_get_link_summary(wifi_link_summary_t *summary, bool reset_window);
+
+/*
+ * Get Link Quality History
+ * 
+ * Copies the most recent link samples, oldest first.
+ * 
+ * Parameters:
+ *   samples: Array to populate
+ *   max_count: Capacity of the array
+ *   count: Pointer to store the number of samples written
+ * 
+ * Returns:
+ *   ESP_OK: History retrieved successfully
+ *   ESP_ERR_INVALID_ARG: Invalid parameters
+ */
+esp_err_t wifi_manager_get_link_history(wifi_link_sample_t *samples, size_t max_count, size_t *count);
+
+/*
+ * Enable/Disable Background Reconnection
+ * 
+ * When enabled, a connection that fails after the maximum retries (or
+ * times out) is retried in the background with exponential backoff
+ * between WIFI_RECONNECT_BASE_MS and WIFI_RECONNECT_MAX_MS, so the
+ * application can keep running while the AP is unavailable.
+ * 
+ * Parameters:
+ *   enable: true to enable background reconnection
+ * 
+ * Returns:
+ *   ESP_OK: Setting applied
+ *   ESP_ERR_INVALID_STATE: WiFi manager not initialized
+ */
+esp_err_t wifi_manager_set_auto_reconnect(bool enable);
+
+/*
+ * Start a Delayed Background Connection Attempt
+ * 
+ * Schedules wifi_manager_connect_async() to run after the given delay.
+ * Used to hold off the radio after repeated reboots.
+ * 
+ * Parameters:
+ *   delay_ms: Delay before the connection attempt
+ * 
+ * Returns:
+ *   ESP_OK: Attempt scheduled
+ *   ESP_ERR_INVALID_STATE: WiFi manager not initialized
+ *   ESP_ERR_NOT_SUPPORTED: Reconnect timer unavailable
+ */
+esp_err_t wifi_manager_connect_after(uint32_t delay_ms);
+
+/*
+ * Get Background Reconnect Attempts
+ * 
+ * Returns:
+ *   uint32_t: Number of background connection attempts since init
+ */
+uint32_t wifi_manager_get_reconnect_attempts(void);
+
 #ifdef __cplusplus
 }
 #endif
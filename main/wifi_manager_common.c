@@ -0,0 +1,453 @@
+/*
+ * WiFi Manager Common Implementation
+ * 
+ * Shared by wifi_manager.c and wifi_manager_fake.c (see
+ * wifi_manager_common.h). Counters live in a statistics block; the link
+ * history and reporting window (min/max, reset on read) are written from
+ * the esp_timer and event tasks under a spinlock. Reconnection runs from
+ * its own esp_timer and goes through the public connect API of whichever
+ * implementation is linked.
+ */
+
+#include "wifi_manager_common.h"
+#include "config.h"
+#include "stats_block.h"
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+// Module logging tag
+static const char *TAG = "WIFI_MGR";
+
+// Statistics counters (see stats_block.h)
+typedef enum {
+    WIFI_STAT_TX_BURSTS = 0,
+    WIFI_STAT_TX_ACTIVE_US,              // 64-bit (two slots)
+    WIFI_STAT_RADIO_START_TIME = WIFI_STAT_TX_ACTIVE_US + 2, // 64-bit
+    WIFI_STAT_RECONNECT_ATTEMPTS = WIFI_STAT_RADIO_START_TIME + 2,
+    WIFI_STAT_DISCONNECTS,               // Since boot (not reset with the window)
+    WIFI_STAT_RETRIES,
+    WIFI_STAT_COUNT
+} wifi_stat_t;
+
+// Updated from the uploading, event and esp_timer tasks
+STATS_BLOCK_DEFINE(s_stats, WIFI_STAT_COUNT);
+
+// Module state management
+typedef struct {
+    bool initialized;
+    int64_t burst_start_time;
+    esp_timer_handle_t reconnect_timer;
+    bool auto_reconnect;
+    uint32_t reconnect_delay_ms;
+} wifi_common_context_t;
+
+// Link quality history and current reporting window
+typedef struct {
+    wifi_link_sample_t history[WIFI_LINK_HISTORY_LEN];
+    uint16_t head;                       // Next write position
+    uint16_t count;                      // Valid samples in history
+    int64_t window_start_time;
+    uint16_t window_samples;
+    int8_t window_rssi_min;
+    int8_t window_rssi_max;
+    int32_t window_rssi_sum;
+    uint16_t window_disconnects;
+    uint16_t window_retries;
+    uint8_t last_disconnect_reason;
+} wifi_link_telemetry_t;
+
+// Global module context
+static wifi_common_context_t s_context = {
+    .initialized = false,
+    .reconnect_timer = NULL,
+    .auto_reconnect = false,
+    .reconnect_delay_ms = WIFI_RECONNECT_BASE_MS
+};
+
+// Link telemetry is written from the esp_timer and event tasks
+static wifi_link_telemetry_t s_link = {0};
+static portMUX_TYPE s_link_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ * Fraction of idle time the radio is expected to be awake (per mille)
+ * 
+ * Modem sleep wakes the radio for roughly WIFI_BEACON_WAKE_US on every
+ * beacon it listens to; DTIM is assumed to be 1.
+ */
+static uint32_t idle_radio_duty_permille(const wifi_power_policy_t *policy)
+{
+    uint32_t wake_period_us;
+    
+    switch (policy->mode) {
+        case WIFI_POWER_SAVE_NONE:
+            return 1000;
+        case WIFI_POWER_SAVE_MAX:
+            wake_period_us = WIFI_BEACON_INTERVAL_US * policy->listen_interval;
+            break;
+        case WIFI_POWER_SAVE_MIN:
+        default:
+            wake_period_us = WIFI_BEACON_INTERVAL_US;
+            break;
+    }
+    
+    return (uint32_t)(((uint64_t)WIFI_BEACON_WAKE_US * 1000) / wake_period_us);
+}
+
+/*
+ * Start a new link quality reporting window (caller holds s_link_lock)
+ */
+static void link_window_reset(void)
+{
+    s_link.window_start_time = esp_timer_get_time();
+    s_link.window_samples = 0;
+    s_link.window_rssi_min = INT8_MAX;
+    s_link.window_rssi_max = INT8_MIN;
+    s_link.window_rssi_sum = 0;
+    s_link.window_disconnects = 0;
+    s_link.window_retries = 0;
+}
+
+/*
+ * Schedule a Background Connection Attempt
+ */
+static void schedule_reconnect(uint32_t delay_ms)
+{
+    if (!s_context.reconnect_timer) {
+        return;
+    }
+    
+    if (esp_timer_is_active(s_context.reconnect_timer)) {
+        esp_timer_stop(s_context.reconnect_timer);
+    }
+    esp_timer_start_once(s_context.reconnect_timer, (uint64_t)delay_ms * 1000);
+}
+
+/*
+ * Background Reconnect Timer Callback
+ */
+static void reconnect_timer_cb(void *arg)
+{
+    wifi_status_t status = wifi_manager_get_status();
+    if (status == WIFI_STATUS_CONNECTED || status == WIFI_STATUS_CONNECTING) {
+        return;
+    }
+    
+    stats_inc(&s_stats, WIFI_STAT_RECONNECT_ATTEMPTS);
+    ESP_LOGI(TAG, "Background reconnect attempt %lu",
+             (unsigned long)stats_get(&s_stats, WIFI_STAT_RECONNECT_ATTEMPTS));
+    
+    if (wifi_manager_connect_async() != ESP_OK) {
+        wifi_common_schedule_backoff();
+    }
+}
+
+/*
+ * Initialize Common State
+ */
+void wifi_common_init(void)
+{
+    // Timer for background reconnection (started on demand)
+    const esp_timer_create_args_t reconnect_timer_args = {
+        .callback = &reconnect_timer_cb,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "wifi_reconnect",
+        .skip_unhandled_events = true
+    };
+    esp_err_t ret = esp_timer_create(&reconnect_timer_args, &s_context.reconnect_timer);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Background reconnect unavailable: %s", esp_err_to_name(ret));
+        s_context.reconnect_timer = NULL;
+    }
+    
+    portENTER_CRITICAL(&s_link_lock);
+    memset(&s_link, 0, sizeof(s_link));
+    link_window_reset();
+    portEXIT_CRITICAL(&s_link_lock);
+    
+    stats_reset(&s_stats);
+    stats_update_begin(&s_stats);
+    stats_set64(&s_stats, WIFI_STAT_RADIO_START_TIME, (uint64_t)esp_timer_get_time());
+    stats_update_end(&s_stats);
+    s_context.initialized = true;
+}
+
+/*
+ * Release Common State
+ */
+void wifi_common_deinit(void)
+{
+    // Stop background reconnection
+    if (s_context.reconnect_timer) {
+        esp_timer_stop(s_context.reconnect_timer);
+        esp_timer_delete(s_context.reconnect_timer);
+        s_context.reconnect_timer = NULL;
+    }
+    
+    memset(&s_context, 0, sizeof(s_context));
+    s_context.reconnect_delay_ms = WIFI_RECONNECT_BASE_MS;
+    
+    // Disconnect and retry totals stay with the link history
+    stats_update_begin(&s_stats);
+    stats_set(&s_stats, WIFI_STAT_TX_BURSTS, 0);
+    stats_set64(&s_stats, WIFI_STAT_TX_ACTIVE_US, 0);
+    stats_set64(&s_stats, WIFI_STAT_RADIO_START_TIME, 0);
+    stats_set(&s_stats, WIFI_STAT_RECONNECT_ATTEMPTS, 0);
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Record Link Quality Sample
+ */
+void wifi_common_record_sample(const wifi_link_sample_t *sample)
+{
+    portENTER_CRITICAL(&s_link_lock);
+    s_link.history[s_link.head] = *sample;
+    s_link.head = (s_link.head + 1) % WIFI_LINK_HISTORY_LEN;
+    if (s_link.count < WIFI_LINK_HISTORY_LEN) {
+        s_link.count++;
+    }
+    
+    s_link.window_samples++;
+    s_link.window_rssi_sum += sample->rssi;
+    if (sample->rssi < s_link.window_rssi_min) {
+        s_link.window_rssi_min = sample->rssi;
+    }
+    if (sample->rssi > s_link.window_rssi_max) {
+        s_link.window_rssi_max = sample->rssi;
+    }
+    portEXIT_CRITICAL(&s_link_lock);
+}
+
+/*
+ * Record Disconnect / Retry
+ */
+void wifi_common_record_disconnect(uint8_t reason)
+{
+    portENTER_CRITICAL(&s_link_lock);
+    s_link.window_disconnects++;
+    s_link.last_disconnect_reason = reason;
+    portEXIT_CRITICAL(&s_link_lock);
+    
+    stats_inc(&s_stats, WIFI_STAT_DISCONNECTS);
+}
+
+void wifi_common_record_retry(void)
+{
+    portENTER_CRITICAL(&s_link_lock);
+    s_link.window_retries++;
+    portEXIT_CRITICAL(&s_link_lock);
+    
+    stats_inc(&s_stats, WIFI_STAT_RETRIES);
+}
+
+/*
+ * Connection Established
+ */
+void wifi_common_connected(void)
+{
+    s_context.reconnect_delay_ms = WIFI_RECONNECT_BASE_MS;
+}
+
+/*
+ * Schedule the Next Reconnect with Exponential Backoff
+ */
+void wifi_common_schedule_backoff(void)
+{
+    if (!s_context.auto_reconnect) {
+        return;
+    }
+    
+    uint32_t delay_ms = s_context.reconnect_delay_ms;
+    ESP_LOGI(TAG, "Next background reconnect in %lu ms", (unsigned long)delay_ms);
+    schedule_reconnect(delay_ms);
+    
+    s_context.reconnect_delay_ms = (delay_ms * 2 < WIFI_RECONNECT_MAX_MS) ?
+                                   delay_ms * 2 : WIFI_RECONNECT_MAX_MS;
+}
+
+/*
+ * Mark Start of Radio Transmit Burst
+ */
+void wifi_manager_radio_burst_begin(void)
+{
+    s_context.burst_start_time = esp_timer_get_time();
+}
+
+/*
+ * Mark End of Radio Transmit Burst
+ */
+void wifi_manager_radio_burst_end(void)
+{
+    if (s_context.burst_start_time == 0) {
+        return;
+    }
+    
+    int64_t duration_us = esp_timer_get_time() - s_context.burst_start_time;
+    s_context.burst_start_time = 0;
+    
+    stats_update_begin(&s_stats);
+    stats_add64(&s_stats, WIFI_STAT_TX_ACTIVE_US, (uint64_t)duration_us);
+    stats_inc(&s_stats, WIFI_STAT_TX_BURSTS);
+    stats_update_end(&s_stats);
+}
+
+/*
+ * Get Radio Activity Statistics
+ */
+esp_err_t wifi_manager_get_radio_stats(wifi_radio_stats_t *stats)
+{
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    uint32_t values[WIFI_STAT_COUNT];
+    stats_snapshot(&s_stats, values);
+    
+    memset(stats, 0, sizeof(*stats));
+    wifi_manager_get_power_policy(&stats->policy);
+    stats->tx_bursts = values[WIFI_STAT_TX_BURSTS];
+    stats->tx_active_us = stats_get64(values, WIFI_STAT_TX_ACTIVE_US);
+    
+    int64_t start_time = (int64_t)stats_get64(values, WIFI_STAT_RADIO_START_TIME);
+    if (start_time == 0) {
+        return ESP_OK;
+    }
+    
+    stats->observed_us = esp_timer_get_time() - start_time;
+    if (stats->observed_us == 0) {
+        return ESP_OK;
+    }
+    
+    // Idle time is everything outside transmit bursts
+    uint64_t idle_us = (stats->observed_us > stats->tx_active_us) ?
+                       (stats->observed_us - stats->tx_active_us) : 0;
+    stats->listen_us = (idle_us * idle_radio_duty_permille(&stats->policy)) / 1000;
+    uint64_t radio_on_us = stats->tx_active_us + stats->listen_us;
+    
+    // Scale to one hour of operation
+    stats->radio_on_ms_per_hour = (uint32_t)((double)radio_on_us * 3600000.0 /
+                                             (double)stats->observed_us);
+    
+    return ESP_OK;
+}
+
+/*
+ * Get Link Quality Summary
+ */
+esp_err_t wifi_manager_get_link_summary(wifi_link_summary_t *summary, bool reset_window)
+{
+    if (!summary) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    memset(summary, 0, sizeof(*summary));
+    
+    portENTER_CRITICAL(&s_link_lock);
+    summary->window_ms = (uint32_t)((esp_timer_get_time() - s_link.window_start_time) / 1000);
+    summary->samples = s_link.window_samples;
+    summary->disconnects = s_link.window_disconnects;
+    summary->retries = s_link.window_retries;
+    summary->last_disconnect_reason = s_link.last_disconnect_reason;
+    
+    if (s_link.window_samples > 0) {
+        summary->rssi_min = s_link.window_rssi_min;
+        summary->rssi_max = s_link.window_rssi_max;
+        summary->rssi_mean = (float)s_link.window_rssi_sum / s_link.window_samples;
+    }
+    
+    if (s_link.count > 0) {
+        const wifi_link_sample_t *latest =
+            &s_link.history[(s_link.head + WIFI_LINK_HISTORY_LEN - 1) % WIFI_LINK_HISTORY_LEN];
+        summary->channel = latest->channel;
+        summary->phy_mode = latest->phy_mode;
+    }
+    
+    if (reset_window) {
+        link_window_reset();
+    }
+    portEXIT_CRITICAL(&s_link_lock);
+    
+    summary->phy_rate_mbps = wifi_manager_phy_rate_mbps(summary->phy_mode);
+    summary->total_disconnects = stats_get(&s_stats, WIFI_STAT_DISCONNECTS);
+    summary->total_retries = stats_get(&s_stats, WIFI_STAT_RETRIES);
+    
+    return ESP_OK;
+}
+
+/*
+ * Get Link Quality History
+ */
+esp_err_t wifi_manager_get_link_history(wifi_link_sample_t *samples, size_t max_count, size_t *count)
+{
+    if (!samples || !count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    portENTER_CRITICAL(&s_link_lock);
+    size_t n = (s_link.count < max_count) ? s_link.count : max_count;
+    
+    // Oldest of the n most recent samples
+    size_t start = (s_link.head + WIFI_LINK_HISTORY_LEN - n) % WIFI_LINK_HISTORY_LEN;
+    for (size_t i = 0; i < n; i++) {
+        samples[i] = s_link.history[(start + i) % WIFI_LINK_HISTORY_LEN];
+    }
+    portEXIT_CRITICAL(&s_link_lock);
+    
+    *count = n;
+    return ESP_OK;
+}
+
+/*
+ * Enable/Disable Background Reconnection
+ */
+esp_err_t wifi_manager_set_auto_reconnect(bool enable)
+{
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    s_context.auto_reconnect = enable;
+    
+    wifi_status_t status = wifi_manager_get_status();
+    if (!enable) {
+        if (s_context.reconnect_timer && esp_timer_is_active(s_context.reconnect_timer)) {
+            esp_timer_stop(s_context.reconnect_timer);
+        }
+    } else if (status == WIFI_STATUS_FAILED || status == WIFI_STATUS_ERROR) {
+        // Already failed before reconnection was enabled
+        wifi_common_schedule_backoff();
+    }
+    
+    return ESP_OK;
+}
+
+/*
+ * Start a Delayed Background Connection Attempt
+ */
+esp_err_t wifi_manager_connect_after(uint32_t delay_ms)
+{
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (!s_context.reconnect_timer) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    
+    ESP_LOGI(TAG, "WiFi connection deferred by %lu ms", (unsigned long)delay_ms);
+    schedule_reconnect(delay_ms);
+    
+    return ESP_OK;
+}
+
+/*
+ * Get Background Reconnect Attempts
+ */
+uint32_t wifi_manager_get_reconnect_attempts(void)
+{
+    return stats_get(&s_stats, WIFI_STAT_RECONNECT_ATTEMPTS);
+}
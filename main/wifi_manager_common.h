@@ -0,0 +1,95 @@
+/*
+ * WiFi Manager Common Part (internal)
+ * 
+ * Link telemetry, radio activity accounting and background reconnection
+ * do not depend on how the link is driven, so wifi_manager.c (esp_wifi)
+ * and wifi_manager_fake.c (linux target) share them. This file
+ * implements the matching part of the wifi_manager.h API; the target
+ * files keep association, event handling and link sampling, and report
+ * what happens through the functions below.
+ * 
+ * Not for use outside the WiFi manager.
+ * 
+ * Usage (inside a WiFi manager implementation):
+ *   wifi_common_init();                       // in wifi_manager_init()
+ * 
+ *   wifi_common_record_disconnect(reason);    // on every disconnect
+ *   wifi_common_record_retry();               // before each retry
+ *   wifi_common_schedule_backoff();           // once retries ran out
+ *   wifi_common_connected();                  // when an IP is obtained
+ * 
+ *   wifi_common_deinit();                     // in wifi_manager_cleanup()
+ */
+
+#ifndef WIFI_MANAGER_COMMON_H
+#define WIFI_MANAGER_COMMON_H
+
+#include "wifi_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Initialize Common State
+ * 
+ * Clears the link history, starts a new reporting window and radio
+ * observation period, and creates the reconnect timer. Without the
+ * timer, background reconnection is unavailable (logged, not fatal).
+ */
+void wifi_common_init(void);
+
+/*
+ * Release Common State
+ * 
+ * Stops background reconnection and resets reconnect and radio state.
+ * The link history is kept until the next wifi_common_init().
+ */
+void wifi_common_deinit(void);
+
+/*
+ * Record Link Quality Sample
+ * 
+ * Parameters:
+ *   sample: Sample taken by the target's periodic link sampler
+ */
+void wifi_common_record_sample(const wifi_link_sample_t *sample);
+
+/*
+ * Record Disconnect / Retry
+ * 
+ * Parameters:
+ *   reason: wifi_err_reason_t of the disconnect
+ */
+void wifi_common_record_disconnect(uint8_t reason);
+void wifi_common_record_retry(void);
+
+/*
+ * Connection Established
+ * 
+ * Resets the reconnect backoff to WIFI_RECONNECT_BASE_MS.
+ */
+void wifi_common_connected(void);
+
+/*
+ * Schedule the Next Reconnect with Exponential Backoff
+ * 
+ * Does nothing unless background reconnection is enabled.
+ */
+void wifi_common_schedule_backoff(void);
+
+/*
+ * Nominal PHY Rate of a PHY Mode (Mbps)
+ * 
+ * Provided by the target implementation, which knows its PHY modes.
+ * 
+ * Parameters:
+ *   phy_mode: wifi_phy_mode_t recorded in a link sample
+ */
+uint16_t wifi_manager_phy_rate_mbps(uint8_t phy_mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIFI_MANAGER_COMMON_H
@@ -0,0 +1,488 @@
+/*
+ * WiFi Manager Fake Implementation (linux target)
+ * 
+ * Replaces the esp_wifi event handler with esp_timer callbacks: the
+ * association timer plays the role of IP_EVENT_STA_GOT_IP (or of a
+ * failed attempt during an outage) and the link timer samples the
+ * simulated RSSI and schedules drops. Everything the application can
+ * observe (status, event bits, retries, telemetry) behaves as in
+ * wifi_manager.c; telemetry, radio accounting and background
+ * reconnection are the same code (wifi_manager_common.c).
+ */
+
+#include "wifi_manager.h"
+#include "wifi_manager_fake.h"
+#include "wifi_manager_common.h"
+#include "config.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+
+// Module logging tag
+static const char *TAG = "WIFI_FAKE";
+
+// wifi_phy_mode_t and wifi_err_reason_t values reported by the simulation
+#define FAKE_PHY_MODE_HT20         3
+#define FAKE_PHY_RATE_MBPS         72
+#define FAKE_REASON_BEACON_TIMEOUT 200
+#define FAKE_REASON_NO_AP_FOUND    201
+
+// Largest simulated RSSI deviation from the mean (dBm)
+#define FAKE_RSSI_SPREAD           10
+
+// Module state management
+typedef struct {
+    bool initialized;
+    wifi_status_t status;
+    int retry_count;
+    EventGroupHandle_t event_group;
+    wifi_power_policy_t power_policy;
+    esp_timer_handle_t link_timer;
+    esp_timer_handle_t assoc_timer;
+    int64_t connected_time;              // Start of the current association
+    int64_t outage_end_time;             // Association fails until then
+    int8_t rssi;                         // Current simulated RSSI
+    int8_t rssi_mean;                    // Center of the RSSI random walk
+} wifi_manager_fake_context_t;
+
+// Global module context
+static wifi_manager_fake_context_t s_context = {
+    .status = WIFI_STATUS_DISCONNECTED,
+    .power_policy = {
+        .mode = WIFI_POWER_SAVE_DEFAULT,
+        .listen_interval = WIFI_LISTEN_INTERVAL
+    },
+    .rssi = WIFI_FAKE_RSSI_DBM,
+    .rssi_mean = WIFI_FAKE_RSSI_DBM
+};
+
+/*
+ * Internal function to start one simulated association attempt
+ */
+static void start_association(void)
+{
+    s_context.status = WIFI_STATUS_CONNECTING;
+    if (esp_timer_is_active(s_context.assoc_timer)) {
+        esp_timer_stop(s_context.assoc_timer);
+    }
+    esp_timer_start_once(s_context.assoc_timer, (uint64_t)WIFI_FAKE_ASSOC_MS * 1000);
+}
+
+/*
+ * Internal function to handle a disconnect (WIFI_EVENT_STA_DISCONNECTED)
+ */
+static void handle_disconnect(uint8_t reason)
+{
+    xEventGroupClearBits(s_context.event_group, WIFI_CONNECTED_BIT);
+    ESP_LOGD(TAG, "Disconnected, reason: %d", reason);
+    wifi_common_record_disconnect(reason);
+    
+    if (s_context.retry_count < WIFI_MAXIMUM_RETRY) {
+        s_context.retry_count++;
+        wifi_common_record_retry();
+        ESP_LOGI(TAG, "Retrying WiFi connection (%d/%d)",
+                 s_context.retry_count, WIFI_MAXIMUM_RETRY);
+        start_association();
+    } else {
+        ESP_LOGE(TAG, "WiFi connection failed after %d attempts", WIFI_MAXIMUM_RETRY);
+        s_context.status = WIFI_STATUS_FAILED;
+        xEventGroupSetBits(s_context.event_group, WIFI_FAIL_BIT);
+        wifi_common_schedule_backoff();
+    }
+}
+
+/*
+ * Association Timer Callback
+ * 
+ * Completes the attempt started by start_association(): fails while an
+ * outage is in progress, otherwise "gets an IP".
+ */
+static void assoc_timer_cb(void *arg)
+{
+    if (s_context.status != WIFI_STATUS_CONNECTING) {
+        return;
+    }
+    
+    if (esp_timer_get_time() < s_context.outage_end_time) {
+        handle_disconnect(FAKE_REASON_NO_AP_FOUND);
+        return;
+    }
+    
+    ESP_LOGI(TAG, "Connected to simulated WiFi! IP: 127.0.0.1");
+    s_context.retry_count = 0;
+    wifi_common_connected();
+    s_context.connected_time = esp_timer_get_time();
+    s_context.status = WIFI_STATUS_CONNECTED;
+    xEventGroupSetBits(s_context.event_group, WIFI_CONNECTED_BIT);
+}
+
+/*
+ * Periodic Link Quality Sampler
+ * 
+ * Moves the simulated RSSI by up to 2 dB per sample, records it like the
+ * real sampler and triggers the scheduled link drop.
+ */
+static void link_sample_timer_cb(void *arg)
+{
+    if (s_context.status != WIFI_STATUS_CONNECTED) {
+        return;
+    }
+    
+    if (WIFI_FAKE_DROP_INTERVAL_S > 0 &&
+        esp_timer_get_time() - s_context.connected_time >= (int64_t)WIFI_FAKE_DROP_INTERVAL_S * 1000000) {
+        ESP_LOGW(TAG, "Simulated link drop (outage %d ms)", WIFI_FAKE_OUTAGE_MS);
+        wifi_manager_fake_drop_link(WIFI_FAKE_OUTAGE_MS);
+        return;
+    }
+    
+    int rssi = s_context.rssi + (rand() % 5) - 2;
+    if (rssi > s_context.rssi_mean + FAKE_RSSI_SPREAD) {
+        rssi = s_context.rssi_mean + FAKE_RSSI_SPREAD;
+    } else if (rssi < s_context.rssi_mean - FAKE_RSSI_SPREAD) {
+        rssi = s_context.rssi_mean - FAKE_RSSI_SPREAD;
+    }
+    s_context.rssi = (int8_t)rssi;
+    
+    wifi_link_sample_t sample = {
+        .rssi = s_context.rssi,
+        .channel = WIFI_FAKE_CHANNEL,
+        .phy_mode = FAKE_PHY_MODE_HT20,
+        .reserved = 0
+    };
+    
+    wifi_common_record_sample(&sample);
+}
+
+/*
+ * Nominal PHY Rate of a PHY Mode (Mbps)
+ */
+uint16_t wifi_manager_phy_rate_mbps(uint8_t phy_mode)
+{
+    return (phy_mode == FAKE_PHY_MODE_HT20) ? FAKE_PHY_RATE_MBPS : 0;
+}
+
+/*
+ * Internal function to create one of the module's timers
+ */
+static esp_err_t create_timer(esp_timer_cb_t callback, const char *name, esp_timer_handle_t *timer)
+{
+    const esp_timer_create_args_t args = {
+        .callback = callback,
+        .arg = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = name,
+        .skip_unhandled_events = true
+    };
+    return esp_timer_create(&args, timer);
+}
+
+/*
+ * Internal function to delete a timer created by create_timer()
+ */
+static void delete_timer(esp_timer_handle_t *timer)
+{
+    if (*timer) {
+        esp_timer_stop(*timer);
+        esp_timer_delete(*timer);
+        *timer = NULL;
+    }
+}
+
+/*
+ * Initialize WiFi Manager
+ */
+esp_err_t wifi_manager_init(void)
+{
+    if (s_context.initialized) {
+        ESP_LOGW(TAG, "WiFi manager already initialized");
+        return ESP_OK;
+    }
+    
+    ESP_LOGI(TAG, "Initializing simulated WiFi manager (drop every %d s, outage %d ms)...",
+             WIFI_FAKE_DROP_INTERVAL_S, WIFI_FAKE_OUTAGE_MS);
+    
+    s_context.event_group = xEventGroupCreate();
+    if (s_context.event_group == NULL) {
+        ESP_LOGE(TAG, "Failed to create WiFi event group");
+        return ESP_ERR_NO_MEM;
+    }
+    
+    // The association timer is required; the others degrade like in wifi_manager.c
+    esp_err_t ret = create_timer(&assoc_timer_cb, "wifi_assoc", &s_context.assoc_timer);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create association timer: %s", esp_err_to_name(ret));
+        vEventGroupDelete(s_context.event_group);
+        s_context.event_group = NULL;
+        return ret;
+    }
+    
+    ret = create_timer(&link_sample_timer_cb, "wifi_link", &s_context.link_timer);
+    if (ret == ESP_OK) {
+        ret = esp_timer_start_periodic(s_context.link_timer,
+                                       (uint64_t)WIFI_LINK_SAMPLE_INTERVAL_MS * 1000);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Link quality sampling unavailable: %s", esp_err_to_name(ret));
+    }
+    
+    // Link telemetry, radio accounting and background reconnection
+    wifi_common_init();
+    
+    s_context.initialized = true;
+    s_context.status = WIFI_STATUS_DISCONNECTED;
+    s_context.retry_count = 0;
+    
+    ESP_LOGI(TAG, "WiFi manager initialized successfully");
+    return ESP_OK;
+}
+
+/*
+ * Start WiFi Connection Without Waiting
+ */
+esp_err_t wifi_manager_connect_async(void)
+{
+    if (!s_context.initialized) {
+        ESP_LOGE(TAG, "WiFi manager not initialized");
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (s_context.status == WIFI_STATUS_CONNECTED || s_context.status == WIFI_STATUS_CONNECTING) {
+        return ESP_OK;
+    }
+    
+    ESP_LOGI(TAG, "Connecting to simulated WiFi SSID: %s", WIFI_SSID);
+    
+    s_context.retry_count = 0;
+    xEventGroupClearBits(s_context.event_group, WIFI_CONNECTED_BIT | WIFI_FAIL_BIT);
+    start_association();
+    
+    return ESP_OK;
+}
+
+/*
+ * Wait for WiFi Connection Result
+ */
+esp_err_t wifi_manager_wait_connected(uint32_t timeout_ms)
+{
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    EventBits_t bits = xEventGroupWaitBits(s_context.event_group,
+                                          WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
+                                          pdFALSE,
+                                          pdFALSE,
+                                          pdMS_TO_TICKS(timeout_ms));
+    
+    if (bits & WIFI_CONNECTED_BIT) {
+        ESP_LOGI(TAG, "Successfully connected to WiFi");
+        return ESP_OK;
+    } else if (bits & WIFI_FAIL_BIT) {
+        ESP_LOGE(TAG, "Failed to connect to WiFi after %d attempts", WIFI_MAXIMUM_RETRY);
+        return ESP_FAIL;
+    } else {
+        ESP_LOGE(TAG, "WiFi connection timeout");
+        esp_timer_stop(s_context.assoc_timer);
+        s_context.status = WIFI_STATUS_FAILED;
+        wifi_common_schedule_backoff();
+        return ESP_ERR_TIMEOUT;
+    }
+}
+
+/*
+ * Connect to WiFi Network
+ */
+esp_err_t wifi_manager_connect(void)
+{
+    if (s_context.initialized && s_context.status == WIFI_STATUS_CONNECTED) {
+        ESP_LOGI(TAG, "Already connected to WiFi");
+        return ESP_OK;
+    }
+    
+    esp_err_t ret = wifi_manager_connect_async();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    
+    return wifi_manager_wait_connected(WIFI_CONNECT_TIMEOUT_MS);
+}
+
+/*
+ * Check WiFi Connection Status
+ */
+bool wifi_manager_is_connected(void)
+{
+    return (s_context.initialized && s_context.status == WIFI_STATUS_CONNECTED);
+}
+
+/*
+ * Get Detailed WiFi Status
+ */
+wifi_status_t wifi_manager_get_status(void)
+{
+    return s_context.status;
+}
+
+/*
+ * Get WiFi Signal Strength (RSSI)
+ */
+esp_err_t wifi_manager_get_rssi(int8_t *rssi)
+{
+    if (!rssi) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!wifi_manager_is_connected()) {
+        return ESP_ERR_WIFI_NOT_CONNECT;
+    }
+    
+    *rssi = s_context.rssi;
+    return ESP_OK;
+}
+
+/*
+ * Get Current IP Address
+ */
+esp_err_t wifi_manager_get_ip_info(esp_netif_ip_info_t *ip_info)
+{
+    if (!ip_info) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    if (!wifi_manager_is_connected()) {
+        return ESP_ERR_WIFI_NOT_CONNECT;
+    }
+    
+    // The host network stands in for the AP; servers are reached on loopback
+    ip_info->ip.addr = ESP_IP4TOADDR(127, 0, 0, 1);
+    ip_info->netmask.addr = ESP_IP4TOADDR(255, 0, 0, 0);
+    ip_info->gw.addr = ESP_IP4TOADDR(127, 0, 0, 1);
+    return ESP_OK;
+}
+
+/*
+ * Disconnect from WiFi Network
+ */
+esp_err_t wifi_manager_disconnect(void)
+{
+    if (!s_context.initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    
+    if (s_context.status == WIFI_STATUS_DISCONNECTED) {
+        return ESP_ERR_WIFI_NOT_CONNECT;
+    }
+    
+    ESP_LOGI(TAG, "Disconnecting from WiFi...");
+    
+    esp_timer_stop(s_context.assoc_timer);
+    xEventGroupClearBits(s_context.event_group, WIFI_CONNECTED_BIT);
+    s_context.status = WIFI_STATUS_DISCONNECTED;
+    
+    return ESP_OK;
+}
+
+/*
+ * WiFi Manager Cleanup
+ */
+esp_err_t wifi_manager_cleanup(void)
+{
+    if (!s_context.initialized) {
+        return ESP_OK;  // Already cleaned up
+    }
+    
+    ESP_LOGI(TAG, "Cleaning up WiFi manager...");
+    
+    if (s_context.status != WIFI_STATUS_DISCONNECTED) {
+        wifi_manager_disconnect();
+    }
+    
+    wifi_common_deinit();
+    delete_timer(&s_context.link_timer);
+    delete_timer(&s_context.assoc_timer);
+    
+    if (s_context.event_group) {
+        vEventGroupDelete(s_context.event_group);
+        s_context.event_group = NULL;
+    }
+    
+    // Reset context (power policy and simulated signal survive re-initialization)
+    wifi_power_policy_t power_policy = s_context.power_policy;
+    int8_t rssi_mean = s_context.rssi_mean;
+    memset(&s_context, 0, sizeof(s_context));
+    s_context.power_policy = power_policy;
+    s_context.rssi = rssi_mean;
+    s_context.rssi_mean = rssi_mean;
+    
+    ESP_LOGI(TAG, "WiFi manager cleanup completed");
+    return ESP_OK;
+}
+
+/*
+ * Get Connection Retry Count
+ */
+int wifi_manager_get_retry_count(void)
+{
+    return s_context.retry_count;
+}
+
+/*
+ * Set WiFi Power Policy
+ * 
+ * Only feeds the radio-on estimate; there is no modem to configure.
+ */
+esp_err_t wifi_manager_set_power_policy(const wifi_power_policy_t *policy)
+{
+    if (!policy || policy->mode > WIFI_POWER_SAVE_MAX || policy->listen_interval == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    s_context.power_policy = *policy;
+    ESP_LOGI(TAG, "Power policy: mode=%d, listen_interval=%u",
+             policy->mode, policy->listen_interval);
+    
+    return ESP_OK;
+}
+
+/*
+ * Get WiFi Power Policy
+ */
+esp_err_t wifi_manager_get_power_policy(wifi_power_policy_t *policy)
+{
+    if (!policy) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    *policy = s_context.power_policy;
+    return ESP_OK;
+}
+
+/*
+ * Simulate a Link Drop
+ */
+void wifi_manager_fake_drop_link(uint32_t outage_ms)
+{
+    if (!s_context.initialized) {
+        return;
+    }
+    
+    s_context.outage_end_time = esp_timer_get_time() + (int64_t)outage_ms * 1000;
+    
+    if (s_context.status == WIFI_STATUS_CONNECTED) {
+        handle_disconnect(FAKE_REASON_BEACON_TIMEOUT);
+    }
+}
+
+/*
+ * Set Simulated Signal Strength
+ */
+void wifi_manager_fake_set_rssi(int8_t rssi)
+{
+    s_context.rssi_mean = rssi;
+    s_context.rssi = rssi;
+}
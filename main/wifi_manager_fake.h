@@ -0,0 +1,60 @@
+/*
+ * WiFi Manager Fake (linux target)
+ * 
+ * Host builds have no WiFi driver. wifi_manager_fake.c implements the
+ * wifi_manager.h API on top of the host's own network: association
+ * "succeeds" after WIFI_FAKE_ASSOC_MS and reports the loopback address,
+ * so esp_http_client reaches a server on 127.0.0.1. Link events follow
+ * the real manager's state machine (retries, failed state, background
+ * reconnect with backoff) and update the same telemetry counters.
+ * 
+ * Link drops happen every WIFI_FAKE_DROP_INTERVAL_S seconds of connection
+ * (checked at each link sample) and can be injected with the hooks below.
+ * Association attempts fail while an outage is in progress.
+ * 
+ * Features:
+ * - Drop-in replacement for wifi_manager.c on the linux target
+ * - Scheduled and injected link drops with configurable outage length
+ * - Simulated RSSI random walk for link telemetry
+ * 
+ * Usage:
+ *   wifi_manager_init();
+ *   wifi_manager_connect();               // connected to the loopback "AP"
+ * 
+ *   wifi_manager_fake_drop_link(20000);   // 20 s outage: retries run out,
+ *                                         // background reconnect takes over
+ */
+
+#ifndef WIFI_MANAGER_FAKE_H
+#define WIFI_MANAGER_FAKE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Simulate a Link Drop
+ * 
+ * Disconnects now (if connected) and fails association attempts for the
+ * given time.
+ * 
+ * Parameters:
+ *   outage_ms: Time until the simulated AP is reachable again
+ */
+void wifi_manager_fake_drop_link(uint32_t outage_ms);
+
+/*
+ * Set Simulated Signal Strength
+ * 
+ * Parameters:
+ *   rssi: Mean RSSI in dBm the random walk is centered on
+ */
+void wifi_manager_fake_set_rssi(int8_t rssi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIFI_MANAGER_FAKE_H
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Minimal API backend for host (linux target) runs of the ESP32 TCP client.
+
+Accepts every POST on the loopback interface, answers with a small JSON
+body and prints one line per request (path, size, sample count). Status
+code and response delay are configurable, so retry, offline-buffer and
+latency paths can be exercised without a real backend.
+
+Usage:
+    tools/loopback_server.py                      # 200 OK on 127.0.0.1:9000
+    tools/loopback_server.py --delay-ms 300       # slow backend
+    tools/loopback_server.py --status 503         # failing backend
+    tools/loopback_server.py --save trace.bin     # keep binary trace uploads
+"""
+
+import argparse
+import json
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+TRACE_CONTENT_TYPE = "application/octet-stream"  # TRACE_CONTENT_TYPE in config.h
+
+
+def count_samples(body):
+    """Number of samples in a JSON upload (None if not a sample upload)."""
+    try:
+        doc = json.loads(body)
+    except ValueError:
+        return None
+    if not isinstance(doc, dict):
+        return None
+    if isinstance(doc.get("samples"), list):
+        return len(doc["samples"])           # Batch upload
+    return 1                                 # Single sample or window summary
+
+
+def make_handler(args):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_POST(self):
+            length = int(self.headers.get("Content-Length", 0))
+            body = self.rfile.read(length)
+            # Only binary trace uploads are saved; they are self-framed, so
+            # the file can be fed straight to trace_decode.py
+            content_type = self.headers.get("Content-Type", "")
+            if args.save and content_type.startswith(TRACE_CONTENT_TYPE):
+                with open(args.save, "ab") as f:
+                    f.write(body)
+
+            if args.delay_ms:
+                time.sleep(args.delay_ms / 1000.0)
+
+            samples = count_samples(body)
+            print("POST %s %d bytes%s -> %d" % (
+                self.path, len(body),
+                "" if samples is None else ", %d samples" % samples,
+                args.status), flush=True)
+
+            reply = json.dumps({"ok": 200 <= args.status < 300}).encode()
+            self.send_response(args.status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(reply)))
+            self.end_headers()
+            self.wfile.write(reply)
+
+        def log_message(self, format, *log_args):
+            pass  # One line per request is printed by do_POST
+
+    return Handler
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--host", default="127.0.0.1", help="address to bind (default: 127.0.0.1)")
+    parser.add_argument("--port", type=int, default=9000, help="port to listen on (default: 9000)")
+    parser.add_argument("--status", type=int, default=200, help="HTTP status to answer with")
+    parser.add_argument("--delay-ms", type=int, default=0, help="delay before each response")
+    parser.add_argument("--save", help="append binary trace uploads to this file")
+    args = parser.parse_args()
+
+    server = ThreadingHTTPServer((args.host, args.port), make_handler(args))
+    print("Listening on http://%s:%d/" % (args.host, args.port), file=sys.stderr)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Decode binary traces from the ESP32 TCP client into Chrome trace JSON.
+
+Input is either a console capture containing the "TRC:<hex>" lines printed
+by trace_dump(), or the binary body POSTed by http_client_post_trace()
+(several uploads may be concatenated into one file). The output opens in
+chrome://tracing or https://ui.perfetto.dev.
+
+Usage:
+    idf.py monitor | tee console.log
+    tools/trace_decode.py console.log -o trace.json
+
+    tools/loopback_server.py --save trace.bin
+    tools/trace_decode.py trace.bin -o trace.json
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x31435254                  # "TRC1"
+TRACE_FORMAT_VERSION = 1
+HEADER = struct.Struct("<IHHIIq")         # trace_header_t
+RECORD = struct.Struct("<IBBHII")         # trace_record_t
+
+PHASES = {0: "i", 1: "B", 2: "E"}         # trace_phase_t -> Chrome phase
+
+# Track (Chrome thread row) per event source
+TRACKS = {1: "sampler", 2: "encoder", 3: "http", 4: "wifi"}
+
+# trace_event_id_t -> (name, track, argument names). Keep in sync with trace.h.
+EVENTS = {
+    1: ("sample", 1, ("valid_mask", None)),
+    2: ("encode", 2, ("samples", None)),
+    3: ("http_post", 3, ("bytes", None)),
+    4: ("http_connected", 3, (None, None)),
+    5: ("http_header_sent", 3, (None, None)),
+    6: ("http_on_header", 3, ("len", None)),
+    7: ("http_on_data", 3, ("len", None)),
+    8: ("http_finish", 3, (None, None)),
+    9: ("http_disconnected", 3, (None, None)),
+    10: ("http_error", 3, (None, None)),
+    11: ("wifi_event", 4, ("event_id", "reason")),
+    12: ("ip_event", 4, ("event_id", None)),
+}
+
+# Argument names of span ends where they differ from the begin
+END_ARGS = {
+    2: ("encoded", None),
+    3: ("status", "esp_err"),
+}
+
+TRC_LINE = re.compile(r"TRC:([0-9a-fA-F]+)")
+
+
+def read_input(path):
+    """Return the raw snapshot bytes from a console capture or binary file."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == TRACE_MAGIC:
+        return data
+
+    text = data.decode("utf-8", errors="replace")
+    return b"".join(bytes.fromhex(m.group(1)) for m in TRC_LINE.finditer(text))
+
+
+def parse_snapshots(data):
+    """Yield (header, records) for every snapshot in the byte stream."""
+    offset = 0
+    while offset + HEADER.size <= len(data):
+        magic, version, record_size, count, lost, timestamp_us = HEADER.unpack_from(data, offset)
+        if magic != TRACE_MAGIC:
+            raise ValueError("bad trace magic at offset %d" % offset)
+        if version != TRACE_FORMAT_VERSION or record_size != RECORD.size:
+            raise ValueError("unsupported trace format %d (record size %d)" % (version, record_size))
+        offset += HEADER.size
+
+        records = []
+        for _ in range(count):
+            if offset + RECORD.size > len(data):
+                print("warning: truncated snapshot", file=sys.stderr)
+                break
+            records.append(RECORD.unpack_from(data, offset))
+            offset += RECORD.size
+
+        yield {"lost": lost, "timestamp_us": timestamp_us}, records
+
+
+def to_chrome_events(snapshots):
+    """Convert parsed snapshots into Chrome trace events."""
+    events = [
+        {"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": name}}
+        for tid, name in TRACKS.items()
+    ]
+    lost = 0
+
+    for header, records in snapshots:
+        lost += header["lost"]
+        snapshot_low = header["timestamp_us"] & 0xFFFFFFFF
+
+        for timestamp_low, event_id, flags, _tag, arg0, arg1 in records:
+            if event_id == 0:
+                lost += 1                 # Overwritten while being copied
+                continue
+
+            # Recorded before the snapshot; restore the upper timestamp bits
+            ts = header["timestamp_us"] - ((snapshot_low - timestamp_low) & 0xFFFFFFFF)
+            phase = flags & 0x03
+            name, tid, arg_names = EVENTS.get(event_id, ("event_%d" % event_id, 0, ("arg0", "arg1")))
+            if phase == 2:
+                arg_names = END_ARGS.get(event_id, arg_names)
+
+            args = {"core": flags >> 4}
+            for arg_name, value in zip(arg_names, (arg0, arg1)):
+                if arg_name:
+                    if arg_name == "esp_err" and value & 0x80000000:
+                        value -= 1 << 32  # esp_err_t is signed
+                    args[arg_name] = value
+
+            event = {"name": name, "ph": PHASES.get(phase, "i"), "ts": ts, "pid": 0, "tid": tid, "args": args}
+            if event["ph"] == "i":
+                event["s"] = "t"
+            events.append(event)
+
+    return events, lost
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("input", help="console capture with TRC: lines, or uploaded binary trace")
+    parser.add_argument("-o", "--output", help="Chrome trace JSON file (default: stdout)")
+    args = parser.parse_args()
+
+    data = read_input(args.input)
+    if not data:
+        sys.exit("no trace data found in %s" % args.input)
+
+    events, lost = to_chrome_events(parse_snapshots(data))
+    trace = {"traceEvents": events, "displayTimeUnit": "ms", "otherData": {"lost_events": lost}}
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+
+    print("%d events decoded, %d lost" % (len(events) - len(TRACKS), lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()